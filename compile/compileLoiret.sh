@@ -3,7 +3,6 @@
 PROC=4
 REAL_TYPE="DOUBLE"
 #REAL_TYPE="SINGLE"
-#PLANAR="PLANAR"
 #TIME_RUN="TIME_RUN"
 EXECUTE_AFTER_COMPILE="EXECUTE"
 
@@ -21,22 +20,14 @@ fi
 cd build
 
 # RUN Cmake WITH NECESSARY FLAGS AS SET BY USER
-if [ -z $PLANAR ]; then
-    if [ -z $TIME_RUN ]; then
-        if [ "$REAL_TYPE" == "DOUBLE" ]; then
-            CC=mpicc CXX=mpicxx cmake ../../ -DREAL_DOUBLE=ON
-        else
-            CC=mpicc CXX=mpicxx cmake ../../ -DREAL_SINGLE=ON
-        fi
+if [ -z $TIME_RUN ]; then
+    if [ "$REAL_TYPE" == "DOUBLE" ]; then
+        CC=mpicc CXX=mpicxx cmake ../../ -DREAL_DOUBLE=ON
     else
-        CC=mpicc CXX=mpicxx cmake ../../ -DTIME_RUN=ON
+        CC=mpicc CXX=mpicxx cmake ../../ -DREAL_SINGLE=ON
     fi
 else
-    if [ -z $TIME_RUN ]; then
-        CC=mpicc CXX=mpicxx cmake ../../ -DPLANAR=ON
-    else
-        CC=mpicc CXX=mpicxx cmake ../../ -DPLANAR=ON -DTIME_RUN=ON
-    fi
+    CC=mpicc CXX=mpicxx cmake ../../ -DTIME_RUN=ON
 fi
 
 # COMPILE
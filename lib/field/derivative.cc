@@ -12,7 +12,8 @@
  ********************************************************************************************************************************************
  */
 
-derivative::derivative(const grid &gridData, const field &F): gridData(gridData), F(F) { 
+template <typename fReal>
+derivative<fReal>::derivative(const grid &gridData, const field<fReal> &F): gridData(gridData), F(F) { 
     tempMat.resize(F.fSize);
     tempMat.reindexSelf(F.flBound);
 
@@ -63,7 +64,8 @@ derivative::derivative(const grid &gridData, const field &F): gridData(gridData)
  *          
  ********************************************************************************************************************************************
  */
-void derivative::calcDerivative1_x(blitz::Array<real, 3> outputMat) {
+template <typename fReal>
+void derivative<fReal>::calcDerivative1_x(blitz::Array<fReal, 3> outputMat) {
     outputMat(blitz::Range(0, F.F.ubound(0) - 1), fullRange, fullRange) = central12n(F.F, 0);
     outputMat *= invDelx;
 
@@ -78,7 +80,8 @@ void derivative::calcDerivative1_x(blitz::Array<real, 3> outputMat) {
  *          
  ********************************************************************************************************************************************
  */
-void derivative::calcDerivative1_y(blitz::Array<real, 3> outputMat) {
+template <typename fReal>
+void derivative<fReal>::calcDerivative1_y(blitz::Array<fReal, 3> outputMat) {
     outputMat(fullRange, blitz::Range(0, F.F.ubound(1) - 1), fullRange) = central12n(F.F, 1);
     outputMat *= invDely;
 
@@ -93,7 +96,8 @@ void derivative::calcDerivative1_y(blitz::Array<real, 3> outputMat) {
  *          
  ********************************************************************************************************************************************
  */
-void derivative::calcDerivative1_z(blitz::Array<real, 3> outputMat) {
+template <typename fReal>
+void derivative<fReal>::calcDerivative1_z(blitz::Array<fReal, 3> outputMat) {
     outputMat(fullRange, fullRange, blitz::Range(0, F.F.ubound(2) - 1)) = central12n(F.F, 2);
     outputMat *= invDelz;
 
@@ -108,7 +112,8 @@ void derivative::calcDerivative1_z(blitz::Array<real, 3> outputMat) {
  *          
  ********************************************************************************************************************************************
  */
-void derivative::calcDerivative2xx(blitz::Array<real, 3> outputMat) {
+template <typename fReal>
+void derivative<fReal>::calcDerivative2xx(blitz::Array<fReal, 3> outputMat) {
     tempMat(blitz::Range(0, F.F.ubound(0) - 1), fullRange, fullRange) = central12n(F.F, 0);
     tempMat *= invDelx;
 
@@ -126,7 +131,8 @@ void derivative::calcDerivative2xx(blitz::Array<real, 3> outputMat) {
  *          
  ********************************************************************************************************************************************
  */
-void derivative::calcDerivative2yy(blitz::Array<real, 3> outputMat) {
+template <typename fReal>
+void derivative<fReal>::calcDerivative2yy(blitz::Array<fReal, 3> outputMat) {
     tempMat(fullRange, blitz::Range(0, F.F.ubound(1) - 1), fullRange) = central12n(F.F, 1);
     tempMat *= invDely;
 
@@ -144,7 +150,8 @@ void derivative::calcDerivative2yy(blitz::Array<real, 3> outputMat) {
  *          
  ********************************************************************************************************************************************
  */
-void derivative::calcDerivative2zz(blitz::Array<real, 3> outputMat) {
+template <typename fReal>
+void derivative<fReal>::calcDerivative2zz(blitz::Array<fReal, 3> outputMat) {
     tempMat(fullRange, fullRange, blitz::Range(0, F.F.ubound(2) - 1)) = central12n(F.F, 2);
     tempMat *= invDelz;
 
@@ -160,3 +167,6 @@ void derivative::calcDerivative2zz(blitz::Array<real, 3> outputMat) {
 *
 *********************************************************************************************************************************************
 */
+
+template class derivative<float>;
+template class derivative<double>;
@@ -9,11 +9,12 @@
 #include "field.h"
 #include "grid.h"
 
+template <typename fReal>
 class derivative {
     private: 
         const grid &gridData;
 
-        const field &F;
+        const field<fReal> &F;
 
         real invDelx, invDely, invDelz;
 
@@ -27,18 +28,18 @@ class derivative {
         blitz::Array<real, 1> xxMetric, yyMetric, zzMetric;
         blitz::Array<real, 1> x2Metric, y2Metric, z2Metric;
 
-        blitz::Array<real, 3> tempMat;
+        blitz::Array<fReal, 3> tempMat;
 
     public:
-        derivative(const grid &gridData, const field &F);
+        derivative(const grid &gridData, const field<fReal> &F);
 
-        void calcDerivative1_x(blitz::Array<real, 3> outputMat);
-        void calcDerivative1_y(blitz::Array<real, 3> outputMat);
-        void calcDerivative1_z(blitz::Array<real, 3> outputMat);
+        void calcDerivative1_x(blitz::Array<fReal, 3> outputMat);
+        void calcDerivative1_y(blitz::Array<fReal, 3> outputMat);
+        void calcDerivative1_z(blitz::Array<fReal, 3> outputMat);
 
-        void calcDerivative2xx(blitz::Array<real, 3> outputMat);
-        void calcDerivative2yy(blitz::Array<real, 3> outputMat);
-        void calcDerivative2zz(blitz::Array<real, 3> outputMat);
+        void calcDerivative2xx(blitz::Array<fReal, 3> outputMat);
+        void calcDerivative2yy(blitz::Array<fReal, 3> outputMat);
+        void calcDerivative2zz(blitz::Array<fReal, 3> outputMat);
 };
 
 /**
@@ -47,6 +48,7 @@ class derivative {
  *  \brief Derivative class to perform finite difference operations on the data stored in field
  *
  *  It contains functions to perform the finite difference operations with constant grid spacing.
+ *  The class is templated on the scalar type fReal of the field, while the grid metrics remain in the precision of the grid.
  *  For many classes of this solver, empty destructors are removed. Refer reference [5] of README for more details.
  ********************************************************************************************************************************************
  */
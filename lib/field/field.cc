@@ -17,9 +17,10 @@
  * \param   zStag is a const boolean value that is <B>true</B> when the grid is staggered along the z-direction and <B>false</B> when it is not
  ********************************************************************************************************************************************
  */
-field::field(const grid &gridData, std::string fieldName, const bool xStag, const bool yStag, const bool zStag):
-             gridData(gridData),
-             xStag(xStag), yStag(yStag), zStag(zStag)
+template <typename fReal>
+field<fReal>::field(const grid &gridData, std::string fieldName, const bool xStag, const bool yStag, const bool zStag):
+                    gridData(gridData),
+                    xStag(xStag), yStag(yStag), zStag(zStag)
 {
     this->fieldName = fieldName;
 
@@ -44,7 +45,7 @@ field::field(const grid &gridData, std::string fieldName, const bool xStag, cons
     F.resize(fSize);
     F.reindexSelf(flBound);
 
-    mpiHandle = new mpidata(F, gridData.rankData);
+    mpiHandle = new mpidata<fReal>(F, gridData.rankData);
 
     setCoreSlice();
     setBulkSlice();
@@ -73,7 +74,8 @@ field::field(const grid &gridData, std::string fieldName, const bool xStag, cons
  * \return  A RectDomain object that specifies the new offset view of the data
  ********************************************************************************************************************************************
  */
-blitz::RectDomain<3> field::shift(int dim, blitz::RectDomain<3> core, int steps) {
+template <typename fReal>
+blitz::RectDomain<3> field<fReal>::shift(int dim, blitz::RectDomain<3> core, int steps) {
     core.lbound()(dim) += steps;
     core.ubound()(dim) += steps;
 
@@ -91,7 +93,8 @@ blitz::RectDomain<3> field::shift(int dim, blitz::RectDomain<3> core, int steps)
  *
  ********************************************************************************************************************************************
  */
-void field::setCoreSlice() {
+template <typename fReal>
+void field<fReal>::setCoreSlice() {
     cuBound = gridData.collocCoreDomain.ubound();
 
     if (xStag) {
@@ -136,7 +139,8 @@ void field::setCoreSlice() {
  *
  ********************************************************************************************************************************************
  */
-void field::setBulkSlice() {
+template <typename fReal>
+void field<fReal>::setBulkSlice() {
     blitz::TinyVector<int, 3> blBound;
     blitz::TinyVector<int, 3> buBound;
 
@@ -222,10 +226,10 @@ void field::setBulkSlice() {
         }
     }
 
-#ifdef PLANAR
-    blBound(1) = 0;
-    buBound(1) = 0;
-#endif
+    if (gridData.inputParams.planar) {
+        blBound(1) = 0;
+        buBound(1) = 0;
+    }
 
     fBulk = blitz::RectDomain<3>(blBound, buBound);
 }
@@ -242,7 +246,8 @@ void field::setBulkSlice() {
  *          \ref zStag is false
  ********************************************************************************************************************************************
  */
-void field::setWallSlices() {
+template <typename fReal>
+void field<fReal>::setWallSlices() {
     blitz::Array<blitz::TinyVector<int, 3>, 1> wlBound;
     blitz::Array<blitz::TinyVector<int, 3>, 1> wuBound;
 
@@ -292,7 +297,8 @@ void field::setWallSlices() {
  *          This function must be called before using the values contained in the arrays d2F_dx2, d2F_dy2 and d2F_dz2.
  ********************************************************************************************************************************************
  */
-void field::setInterpolationSlices() {
+template <typename fReal>
+void field<fReal>::setInterpolationSlices() {
     // INTERPOLATION SLICES FOR INTERPOLATING VALUES OF Vx FROM THE vfield
     // In all the below slices, we are considering interpolations between the following 8 variables
     //
@@ -539,25 +545,25 @@ void field::setInterpolationSlices() {
     }
 
     // RESET INTERPOLATION SLICES FOR PLANAR GRID
-#ifdef PLANAR
-    if (fieldName == "Vy") {
-        VxIntSlices.resize(1);
-        VyIntSlices.resize(1);
-        VzIntSlices.resize(1);
-
-        VxIntSlices(0) = fCore;
-        VyIntSlices(0) = fCore;
-        VzIntSlices(0) = fCore;
-    } else if (fieldName == "Vx") {
-        VyIntSlices.resize(1);
-
-        VyIntSlices(0) = fCore;
-    } else if (fieldName == "Vz") {
-        VyIntSlices.resize(1);
-
-        VyIntSlices(0) = fCore;
+    if (gridData.inputParams.planar) {
+        if (fieldName == "Vy") {
+            VxIntSlices.resize(1);
+            VyIntSlices.resize(1);
+            VzIntSlices.resize(1);
+
+            VxIntSlices(0) = fCore;
+            VyIntSlices(0) = fCore;
+            VzIntSlices(0) = fCore;
+        } else if (fieldName == "Vx") {
+            VyIntSlices.resize(1);
+
+            VyIntSlices(0) = fCore;
+        } else if (fieldName == "Vz") {
+            VyIntSlices.resize(1);
+
+            VyIntSlices(0) = fCore;
+        }
     }
-#endif
 }
 
 
@@ -569,7 +575,8 @@ void field::setInterpolationSlices() {
  *          the sub-domain boundary pads.
  ********************************************************************************************************************************************
  */
-void field::syncData() {
+template <typename fReal>
+void field<fReal>::syncData() {
     mpiHandle->syncData();
 }
 
@@ -585,8 +592,9 @@ void field::syncData() {
  * \return  The real value of the maximum is returned (it is implicitly assumed that only real values are used)
  ********************************************************************************************************************************************
  */
-real field::fieldMax() {
-    real localMax, globalMax;
+template <typename fReal>
+fReal field<fReal>::fieldMax() {
+    fReal localMax, globalMax;
 
     localMax = blitz::max(blitz::abs(F));
 
@@ -597,7 +605,7 @@ real field::fieldMax() {
      * Check Ref. [4] in README for explanation.                                                                   *
      ***************************************************************************************************************/
 
-    MPI_Allreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(&localMax, &globalMax, 1, mpiHandle->fieldDataType, MPI_MAX, MPI_COMM_WORLD);
 
     return globalMax;
 }
@@ -614,7 +622,8 @@ real field::fieldMax() {
  * \return  A pointer to itself is returned by the field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-field& field::operator += (field &a) {
+template <typename fReal>
+field<fReal>& field<fReal>::operator += (field<fReal> &a) {
     F += a.F;
 
     return *this;
@@ -632,7 +641,8 @@ field& field::operator += (field &a) {
  * \return  A pointer to itself is returned by the field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-field& field::operator -= (field &a) {
+template <typename fReal>
+field<fReal>& field<fReal>::operator -= (field<fReal> &a) {
     F -= a.F;
 
     return *this;
@@ -650,7 +660,8 @@ field& field::operator -= (field &a) {
  * \return  A pointer to itself is returned by the field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-field& field::operator += (real a) {
+template <typename fReal>
+field<fReal>& field<fReal>::operator += (fReal a) {
     F += a;
 
     return *this;
@@ -668,7 +679,8 @@ field& field::operator += (real a) {
  * \return  A pointer to itself is returned by the field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-field& field::operator -= (real a) {
+template <typename fReal>
+field<fReal>& field<fReal>::operator -= (fReal a) {
     F -= a;
 
     return *this;
@@ -683,7 +695,8 @@ field& field::operator -= (real a) {
  * \param   a is a real number to be assigned to the field
  ********************************************************************************************************************************************
  */
-void field::operator = (real a) {
+template <typename fReal>
+void field<fReal>::operator = (fReal a) {
     F = a;
 }
 
@@ -696,8 +709,13 @@ void field::operator = (real a) {
  * \param   a is the field to be assigned to the field
  ********************************************************************************************************************************************
  */
-void field::operator = (field &a) {
+template <typename fReal>
+void field<fReal>::operator = (field<fReal> &a) {
     F = a.F;
 }
 
-field::~field() { }
+template <typename fReal>
+field<fReal>::~field() { }
+
+template class field<float>;
+template class field<double>;
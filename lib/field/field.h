@@ -49,6 +49,7 @@
 #include "mpidata.h"
 #include "grid.h"
 
+template <typename fReal>
 class field {
     private:
         const grid &gridData;
@@ -61,7 +62,7 @@ class field {
         void setInterpolationSlices();
 
     public:
-        blitz::Array<real, 3> F;
+        blitz::Array<fReal, 3> F;
 
         std::string fieldName;
 
@@ -81,24 +82,24 @@ class field {
         blitz::TinyVector<int, 3> fSize;
         blitz::TinyVector<int, 3> flBound, cuBound;
 
-        mpidata *mpiHandle;
+        mpidata<fReal> *mpiHandle;
 
         field(const grid &gridData, std::string fieldName, const bool xStag, const bool yStag, const bool zStag);
 
         void syncData();
 
-        real fieldMax();
+        fReal fieldMax();
 
         blitz::RectDomain<3> shift(int dim, blitz::RectDomain<3> core, int steps);
 
         field& operator += (field &a);
         field& operator -= (field &a);
 
-        field& operator += (real a);
-        field& operator -= (real a);
+        field& operator += (fReal a);
+        field& operator -= (fReal a);
 
         void operator = (field &a);
-        void operator = (real a);
+        void operator = (fReal a);
 
         ~field();
 };
@@ -111,6 +112,7 @@ class field {
  *  The class stores the base data of both scalar and vector fields as blitz arrays.
  *  The data is stored with a uniform grid spacing as in the transformed plane.
  *  The limits of the full domain and its core are also stored in a set of RectDomain and TinyVector objects.
+ *  The class is templated on the scalar type fReal of the data, and is instantiated for both float and double.
  ********************************************************************************************************************************************
  */
 
@@ -15,7 +15,8 @@
  * \param   refF is a const reference to a sample sfield according to which the plainsf is resized
  ********************************************************************************************************************************************
  */
-plainsf::plainsf(const grid &gridData, const sfield &refF): gridData(gridData) {
+template <typename fReal>
+plainsf<fReal>::plainsf(const grid &gridData, const sfield<fReal> &refF): gridData(gridData) {
     F.resize(refF.F.fSize);
     F.reindexSelf(refF.F.flBound);
 
@@ -23,7 +24,7 @@ plainsf::plainsf(const grid &gridData, const sfield &refF): gridData(gridData) {
     yColl = blitz::Range(gridData.collocCoreDomain.lbound(1), gridData.collocCoreDomain.ubound(1));
     zColl = blitz::Range(gridData.collocCoreDomain.lbound(2), gridData.collocCoreDomain.ubound(2));
 
-    mpiHandle = new mpidata(F, gridData.rankData);
+    mpiHandle = new mpidata<fReal>(F, gridData.rankData);
     mpiHandle->createSubarrays(refF.F.fSize, refF.F.cuBound + 1, gridData.padWidths, refF.F.xStag, refF.F.yStag);
 }
 
@@ -39,7 +40,8 @@ plainsf::plainsf(const grid &gridData, const sfield &refF): gridData(gridData) {
  * \return  A pointer to itself is returned by the plain scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-plainsf& plainsf::operator += (plainsf &a) {
+template <typename fReal>
+plainsf<fReal>& plainsf<fReal>::operator += (plainsf<fReal> &a) {
     F += a.F;
 
     return *this;
@@ -57,7 +59,8 @@ plainsf& plainsf::operator += (plainsf &a) {
  * \return  A pointer to itself is returned by the plain scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-plainsf& plainsf::operator -= (plainsf &a) {
+template <typename fReal>
+plainsf<fReal>& plainsf<fReal>::operator -= (plainsf<fReal> &a) {
     F -= a.F;
 
     return *this;
@@ -75,7 +78,8 @@ plainsf& plainsf::operator -= (plainsf &a) {
  * \return  A pointer to itself is returned by the plain scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-plainsf& plainsf::operator += (sfield &a) {
+template <typename fReal>
+plainsf<fReal>& plainsf<fReal>::operator += (sfield<fReal> &a) {
     F += a.F.F;
 
     return *this;
@@ -93,7 +97,8 @@ plainsf& plainsf::operator += (sfield &a) {
  * \return  A pointer to itself is returned by the plain scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-plainsf& plainsf::operator -= (sfield &a) {
+template <typename fReal>
+plainsf<fReal>& plainsf<fReal>::operator -= (sfield<fReal> &a) {
     F -= a.F.F;
 
     return *this;
@@ -111,7 +116,8 @@ plainsf& plainsf::operator -= (sfield &a) {
  * \return  A pointer to itself is returned by the plain scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-plainsf& plainsf::operator *= (real a) {
+template <typename fReal>
+plainsf<fReal>& plainsf<fReal>::operator *= (fReal a) {
     F *= a;
 
     return *this;
@@ -126,7 +132,8 @@ plainsf& plainsf::operator *= (real a) {
  * \param   a is a plainsf to be assigned to the plain scalar field
  ********************************************************************************************************************************************
  */
-void plainsf::operator = (plainsf &a) {
+template <typename fReal>
+void plainsf<fReal>::operator = (plainsf<fReal> &a) {
     F = a.F;
 }
 
@@ -139,7 +146,8 @@ void plainsf::operator = (plainsf &a) {
  * \param   a is a sfield to be assigned to the scalar field
  ********************************************************************************************************************************************
  */
-void plainsf::operator = (sfield &a) {
+template <typename fReal>
+void plainsf<fReal>::operator = (sfield<fReal> &a) {
     F = a.F.F;
 }
 
@@ -152,6 +160,10 @@ void plainsf::operator = (sfield &a) {
  * \param   a is a real number to be assigned to the plain scalar field
  ********************************************************************************************************************************************
  */
-void plainsf::operator = (real a) {
+template <typename fReal>
+void plainsf<fReal>::operator = (fReal a) {
     F = a;
 }
+
+template class plainsf<float>;
+template class plainsf<double>;
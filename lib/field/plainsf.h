@@ -4,6 +4,7 @@
 #include "sfield.h"
 #include "grid.h"
 
+template <typename fReal>
 class plainsf {
     private:
         blitz::firstIndex i;
@@ -13,25 +14,25 @@ class plainsf {
         const grid &gridData;
 
     public:
-        blitz::Array<real, 3> F;
+        blitz::Array<fReal, 3> F;
 
         blitz::Range xColl, yColl, zColl;
 
-        plainsf(const grid &gridData, const sfield &refF);
+        plainsf(const grid &gridData, const sfield<fReal> &refF);
 
-        mpidata *mpiHandle;
+        mpidata<fReal> *mpiHandle;
 
         plainsf& operator += (plainsf &a);
         plainsf& operator -= (plainsf &a);
 
-        plainsf& operator += (sfield &a);
-        plainsf& operator -= (sfield &a);
+        plainsf& operator += (sfield<fReal> &a);
+        plainsf& operator -= (sfield<fReal> &a);
 
-        plainsf& operator *= (real a);
+        plainsf& operator *= (fReal a);
 
         void operator = (plainsf &a);
-        void operator = (sfield &a);
-        void operator = (real a);
+        void operator = (sfield<fReal> &a);
+        void operator = (fReal a);
 
 /**
  ********************************************************************************************************************************************
@@ -56,12 +57,12 @@ class plainsf {
  * \return  The real value of the maximum is returned (it is implicitly assumed that only real values are used)
  ********************************************************************************************************************************************
  */
-        inline real fxMax() {
-            real localMax, globalMax;
+        inline fReal fxMax() {
+            fReal localMax, globalMax;
 
             localMax = blitz::max(F);
 
-            MPI_Allreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD);
+            MPI_Allreduce(&localMax, &globalMax, 1, mpiHandle->fieldDataType, MPI_MAX, MPI_COMM_WORLD);
 
             return globalMax;
         }
@@ -74,7 +75,7 @@ class plainsf {
  *  \class plainsf plainsf.h "lib/plainsf.h"
  *  \brief Plain scalar field class to store simple scalar fields with no differentiation or interpolation
  *
- *  The class stores scalar fields in the form of a Blitz array
+ *  The class stores scalar fields in the form of a Blitz array of the scalar type fReal, which is either float or double.
  ********************************************************************************************************************************************
  */
 
@@ -16,10 +16,11 @@
  * \param   fieldName is a string value set by the user to name and identify the scalar field
  ********************************************************************************************************************************************
  */
-sfield::sfield(const grid &gridData, std::string fieldName):
-               gridData(gridData),
-               F(gridData, fieldName, true, true, true),
-               derS(gridData, F)
+template <typename fReal>
+sfield<fReal>::sfield(const grid &gridData, std::string fieldName):
+                      gridData(gridData),
+                      F(gridData, fieldName, true, true, true),
+                      derS(gridData, F)
 {
     this->fieldName = fieldName;
 
@@ -38,7 +39,8 @@ sfield::sfield(const grid &gridData, std::string fieldName):
  *          the sub-domain boundary pads.
  ********************************************************************************************************************************************
  */
-void sfield::syncData() {
+template <typename fReal>
+void sfield<fReal>::syncData() {
     F.syncData();
 }
 
@@ -54,7 +56,8 @@ void sfield::syncData() {
  * \return  A pointer to itself is returned by the scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-sfield& sfield::operator += (plainsf &a) {
+template <typename fReal>
+sfield<fReal>& sfield<fReal>::operator += (plainsf<fReal> &a) {
     F.F += a.F;
 
     return *this;
@@ -72,7 +75,8 @@ sfield& sfield::operator += (plainsf &a) {
  * \return  A pointer to itself is returned by the scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-sfield& sfield::operator -= (plainsf &a) {
+template <typename fReal>
+sfield<fReal>& sfield<fReal>::operator -= (plainsf<fReal> &a) {
     F.F -= a.F;
 
     return *this;
@@ -90,7 +94,8 @@ sfield& sfield::operator -= (plainsf &a) {
  * \return  A pointer to itself is returned by the scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-sfield& sfield::operator += (sfield &a) {
+template <typename fReal>
+sfield<fReal>& sfield<fReal>::operator += (sfield<fReal> &a) {
     F.F += a.F.F;
 
     return *this;
@@ -108,7 +113,8 @@ sfield& sfield::operator += (sfield &a) {
  * \return  A pointer to itself is returned by the scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-sfield& sfield::operator -= (sfield &a) {
+template <typename fReal>
+sfield<fReal>& sfield<fReal>::operator -= (sfield<fReal> &a) {
     F.F -= a.F.F;
 
     return *this;
@@ -126,7 +132,8 @@ sfield& sfield::operator -= (sfield &a) {
  * \return  A pointer to itself is returned by the scalar field class to which the operator belongs
  ********************************************************************************************************************************************
  */
-sfield& sfield::operator *= (real a) {
+template <typename fReal>
+sfield<fReal>& sfield<fReal>::operator *= (fReal a) {
     F.F *= a;
 
     return *this;
@@ -141,7 +148,8 @@ sfield& sfield::operator *= (real a) {
  * \param   a is the plainsf to be assigned to the scalar field
  ********************************************************************************************************************************************
  */
-void sfield::operator = (plainsf &a) {
+template <typename fReal>
+void sfield<fReal>::operator = (plainsf<fReal> &a) {
     F.F = a.F;
 }
 
@@ -154,7 +162,8 @@ void sfield::operator = (plainsf &a) {
  * \param   a is the scalar field to be assigned to the scalar field
  ********************************************************************************************************************************************
  */
-void sfield::operator = (sfield &a) {
+template <typename fReal>
+void sfield<fReal>::operator = (sfield<fReal> &a) {
     F.F = a.F.F;
 }
 
@@ -167,6 +176,10 @@ void sfield::operator = (sfield &a) {
  * \param   a is a real number to be assigned to the scalar field
  ********************************************************************************************************************************************
  */
-void sfield::operator = (real a) {
+template <typename fReal>
+void sfield<fReal>::operator = (fReal a) {
     F.F = a;
 }
+
+template class sfield<float>;
+template class sfield<double>;
@@ -5,38 +5,39 @@
 #include "derivative.h"
 
 // Forward declarations of relevant classes
-class plainsf;
+template <typename fReal> class plainsf;
 
+template <typename fReal>
 class sfield {
     private:
         const grid &gridData;
 
-        blitz::Array<real, 3> derivTempF;
+        blitz::Array<fReal, 3> derivTempF;
         
     public:
-        field F;
+        field<fReal> F;
 
-        derivative derS;
+        derivative<fReal> derS;
 
         std::string fieldName;
 
-        blitz::Array<real, 3> interTempF;
+        blitz::Array<fReal, 3> interTempF;
 
         sfield(const grid &gridData, std::string fieldName);
 
         void syncData();
 
-        sfield& operator += (plainsf &a);
-        sfield& operator -= (plainsf &a);
+        sfield& operator += (plainsf<fReal> &a);
+        sfield& operator -= (plainsf<fReal> &a);
 
         sfield& operator += (sfield &a);
         sfield& operator -= (sfield &a);
 
-        sfield& operator *= (real a);
+        sfield& operator *= (fReal a);
 
-        void operator = (plainsf &a);
+        void operator = (plainsf<fReal> &a);
         void operator = (sfield &a);
-        void operator = (real a);
+        void operator = (fReal a);
 
         ~sfield() { };
 };
@@ -50,6 +51,7 @@ class sfield {
  *  While the class <B>field</B> merely stores data in the form of a blitz array and offers functions to compute derivatives
  *  over a uniform grid, the <B>sfield</B> class adds another layer of functionality along with the <B>grid</B> (<B>grid.h</B>)
  *  class to apply necessary grid transformation metrics and compute derivatives over a non-uniform grid.
+ *  Like the field it holds, the class is templated on the scalar type fReal of its data.
  *
  ********************************************************************************************************************************************
  */
@@ -35,11 +35,12 @@ grid::grid(const parser &solParam, parallel &parallelData): inputParams(solParam
     dEt = 1.0/real(globalSize(1) - 1);
     dZt = 1.0/real(globalSize(2) - 1);
 
-#ifdef PLANAR
-    padWidths(1) = 1;
-    yLen = 1.0;
-    dEt = 1.0;
-#endif
+    // FOR 2D SIMULATIONS, THE GRID HAS A SINGLE PLANE OF POINTS ALONG Y, WITH NO PADS ON EITHER SIDE
+    if (inputParams.planar) {
+        padWidths(1) = 0;
+        yLen = 1.0;
+        dEt = 1.0;
+    }
 
     // COMPUTE THE LOCAL ARRAY SIZES, collocCoreSize, START AND END INDICES, subarrayStarts AND subarrayEnds
     computeGlobalLimits();
@@ -130,11 +131,11 @@ void grid::computeGlobalLimits() {
 
     // NUMBER OF STAGGERED POINTS IN EACH SUB-DOMAIN EXCLUDING PAD POINTS
     localNx = (globalSize(0) - 1)/rankData.npX + 1;
-#ifndef PLANAR
-    localNy = (globalSize(1) - 1)/rankData.npY + 1;
-#else
-    localNy = 1;
-#endif
+    if (inputParams.planar) {
+        localNy = 1;
+    } else {
+        localNy = (globalSize(1) - 1)/rankData.npY + 1;
+    }
     localNz = (globalSize(2));
 
     // SETTING GLOBAL LIMITS
@@ -179,9 +180,7 @@ void grid::setDomainSizes() {
     // SIZE OF THE STAGGERED DOMAIN IN THE CORE OF THE LOCAL SUB-DOMAIN
     collocCoreSize = staggrCoreSize - 1;
 
-#ifdef PLANAR
-    collocCoreSize(1) += 1;
-#endif
+    if (inputParams.planar) collocCoreSize(1) += 1;
 
     collocFullSize = collocCoreSize + 2*padWidths;
 
@@ -330,17 +329,17 @@ void grid::createUniformGrid() {
         xColloc(i) = xLen*(xi(i) + xi(i + 1))/2.0;
     }
 
-#ifndef PLANAR
-    // COLLOCATED Y-GRID POINTS FROM UNIFORM ETA-GRID POINTS AND THEIR METRICS
-    for (i = -padWidths(1); i < staggrCoreSize(1) + padWidths(1); i++) {
-        yStaggr(i) = yLen*et(i);
-    }
+    if (not inputParams.planar) {
+        // COLLOCATED Y-GRID POINTS FROM UNIFORM ETA-GRID POINTS AND THEIR METRICS
+        for (i = -padWidths(1); i < staggrCoreSize(1) + padWidths(1); i++) {
+            yStaggr(i) = yLen*et(i);
+        }
 
-    // STAGGERED Y-GRID POINTS FROM UNIFORM ETA-GRID POINTS AND THEIR METRICS
-    for (i = -padWidths(1); i < collocCoreSize(1) + padWidths(1); i++) {
-        yColloc(i) = yLen*(et(i) + et(i + 1))/2.0;
+        // STAGGERED Y-GRID POINTS FROM UNIFORM ETA-GRID POINTS AND THEIR METRICS
+        for (i = -padWidths(1); i < collocCoreSize(1) + padWidths(1); i++) {
+            yColloc(i) = yLen*(et(i) + et(i + 1))/2.0;
+        }
     }
-#endif
 
     // COLLOCATED Z-GRID POINTS FROM UNIFORM ZETA-GRID POINTS AND THEIR METRICS
     for (i = -padWidths(2); i < staggrCoreSize(2) + padWidths(2); i++) {
@@ -425,8 +424,7 @@ void grid::createTanHypGrid(int dim) {
         }
     }
 
-#ifndef PLANAR
-    if (dim == 1) {
+    if (dim == 1 and not inputParams.planar) {
         // STAGGERED Y-GRID POINTS FROM UNIFORM ETA-GRID POINTS AND THEIR METRICS
         for (i = 0; i < staggrCoreSize(1); i++) {
             yStaggr(i) = yLen*(1.0 - tanh(thBeta[1]*(1.0 - 2.0*et(i)))/tanh(thBeta[1]))/2.0;
@@ -445,7 +443,6 @@ void grid::createTanHypGrid(int dim) {
             ety2Colloc(i) = pow(et_yColloc(i), 2.0);
         }
     }
-#endif
 
     if (dim == 2) {
         // STAGGERED Z-GRID POINTS FROM UNIFORM ZETA-GRID POINTS AND THEIR METRICS
@@ -491,11 +488,16 @@ void grid::checkAnisotropy() {
         for (int j = 0; j < collocCoreSize.ubound(0); j++) {
             for (int k = 0; k < collocCoreSize.ubound(0); k++) {
                 xWidth = xColloc(i-1) - xColloc(i);
-                yWidth = yColloc(j-1) - yColloc(j);
                 zWidth = zColloc(k-1) - zColloc(k);
-                xyRatio = std::max(xWidth/yWidth, yWidth/xWidth);
-                yzRatio = std::max(yWidth/zWidth, zWidth/yWidth);
-                cellMaxAR = std::max(xyRatio, yzRatio);
+                if (inputParams.planar) {
+                    // ONLY THE X-Z ASPECT RATIO IS RELEVANT FOR 2D GRIDS
+                    cellMaxAR = std::max(xWidth/zWidth, zWidth/xWidth);
+                } else {
+                    yWidth = yColloc(j-1) - yColloc(j);
+                    xyRatio = std::max(xWidth/yWidth, yWidth/xWidth);
+                    yzRatio = std::max(yWidth/zWidth, zWidth/yWidth);
+                    cellMaxAR = std::max(xyRatio, yzRatio);
+                }
                 if (cellMaxAR > localMax) localMax = cellMaxAR;
             }
         }
@@ -541,10 +543,10 @@ void grid::gatherGlobal() {
     xCollocGlobal.resize(collocGlobalSize(0));     xCollocGlobal.reindexSelf(globalReIndexVal(0));        xCollocGlobal = 0.0;
     xStaggrGlobal.resize(staggrGlobalSize(0));     xStaggrGlobal.reindexSelf(globalReIndexVal(0));        xStaggrGlobal = 0.0;
 
-#ifndef PLANAR
-    yCollocGlobal.resize(collocGlobalSize(1));     yCollocGlobal.reindexSelf(globalReIndexVal(1));        yCollocGlobal = 0.0;
-    yStaggrGlobal.resize(staggrGlobalSize(1));     yStaggrGlobal.reindexSelf(globalReIndexVal(1));        yStaggrGlobal = 0.0;
-#endif
+    if (not inputParams.planar) {
+        yCollocGlobal.resize(collocGlobalSize(1));     yCollocGlobal.reindexSelf(globalReIndexVal(1));        yCollocGlobal = 0.0;
+        yStaggrGlobal.resize(staggrGlobalSize(1));     yStaggrGlobal.reindexSelf(globalReIndexVal(1));        yStaggrGlobal = 0.0;
+    }
 
     zCollocGlobal.resize(collocGlobalSize(2));     zCollocGlobal.reindexSelf(globalReIndexVal(2));        zCollocGlobal = 0.0;
     zStaggrGlobal.resize(staggrGlobalSize(2));     zStaggrGlobal.reindexSelf(globalReIndexVal(2));        zStaggrGlobal = 0.0;
@@ -569,27 +571,27 @@ void grid::gatherGlobal() {
     MPI_Allgather(&locDisp, 1, MPI_INT, arrDisp, 1, MPI_INT, rankData.MPI_ROW_COMM);
     MPI_Allgatherv(xColloc.dataFirst(), locSize, MPI_FP_REAL, xCollocGlobal.dataFirst(), arrSize, arrDisp, MPI_FP_REAL, rankData.MPI_ROW_COMM);
 
-#ifndef PLANAR
-    // GATHERING THE STAGGERED GRID ALONG Y-DIRECTION
-    locSize = yStaggr.size() - 2*padWidths(1);
-    locDisp = subarrayStarts(1);
-    if (rankData.yRank == rankData.npY-1) {
-        locSize += 2*padWidths(1);
-    }
-    MPI_Allgather(&locSize, 1, MPI_INT, arrSize, 1, MPI_INT, rankData.MPI_COL_COMM);
-    MPI_Allgather(&locDisp, 1, MPI_INT, arrDisp, 1, MPI_INT, rankData.MPI_COL_COMM);
-    MPI_Allgatherv(yStaggr.dataFirst(), locSize, MPI_FP_REAL, yStaggrGlobal.dataFirst(), arrSize, arrDisp, MPI_FP_REAL, rankData.MPI_COL_COMM);
-
-    // GATHERING THE COLLOCATED GRID ALONG Y-DIRECTION
-    locSize = yColloc.size() - 2*padWidths(1);
-    locDisp = rankData.yRank*locSize;
-    if (rankData.yRank == rankData.npY-1) {
-        locSize += 2*padWidths(1);
+    if (not inputParams.planar) {
+        // GATHERING THE STAGGERED GRID ALONG Y-DIRECTION
+        locSize = yStaggr.size() - 2*padWidths(1);
+        locDisp = subarrayStarts(1);
+        if (rankData.yRank == rankData.npY-1) {
+            locSize += 2*padWidths(1);
+        }
+        MPI_Allgather(&locSize, 1, MPI_INT, arrSize, 1, MPI_INT, rankData.MPI_COL_COMM);
+        MPI_Allgather(&locDisp, 1, MPI_INT, arrDisp, 1, MPI_INT, rankData.MPI_COL_COMM);
+        MPI_Allgatherv(yStaggr.dataFirst(), locSize, MPI_FP_REAL, yStaggrGlobal.dataFirst(), arrSize, arrDisp, MPI_FP_REAL, rankData.MPI_COL_COMM);
+
+        // GATHERING THE COLLOCATED GRID ALONG Y-DIRECTION
+        locSize = yColloc.size() - 2*padWidths(1);
+        locDisp = rankData.yRank*locSize;
+        if (rankData.yRank == rankData.npY-1) {
+            locSize += 2*padWidths(1);
+        }
+        MPI_Allgather(&locSize, 1, MPI_INT, arrSize, 1, MPI_INT, rankData.MPI_COL_COMM);
+        MPI_Allgather(&locDisp, 1, MPI_INT, arrDisp, 1, MPI_INT, rankData.MPI_COL_COMM);
+        MPI_Allgatherv(yColloc.dataFirst(), locSize, MPI_FP_REAL, yCollocGlobal.dataFirst(), arrSize, arrDisp, MPI_FP_REAL, rankData.MPI_COL_COMM);
     }
-    MPI_Allgather(&locSize, 1, MPI_INT, arrSize, 1, MPI_INT, rankData.MPI_COL_COMM);
-    MPI_Allgather(&locDisp, 1, MPI_INT, arrDisp, 1, MPI_INT, rankData.MPI_COL_COMM);
-    MPI_Allgatherv(yColloc.dataFirst(), locSize, MPI_FP_REAL, yCollocGlobal.dataFirst(), arrSize, arrDisp, MPI_FP_REAL, rankData.MPI_COL_COMM);
-#endif
 
     // GLOBAL AND LOCAL STAGGERED GRIDS ALONG Z-DIRECTION ARE SAME FOR ALL RANKS
     for (i = -padWidths(2); i < globalSize(2) + padWidths(2); i++) {
@@ -8,6 +8,18 @@ parser::parser() {
 
     setGrids();
     setPeriodicity();
+    setRestriction();
+    setCoarsening();
+    setCoarseOperator();
+    setSmoother();
+    setCycleType();
+    setInitGuess();
+    setResidualNorm();
+    setCoarseSolver();
+    setKrylovSolver();
+    setSolverType();
+    setPrecision();
+    setHaloDepth();
 }
 
 /**
@@ -58,11 +70,28 @@ void parser::parseYAML() {
     /********** Multigrid parameters **********/
 
     yamlNode["Multigrid"]["Jacobi Tolerance"] >> tolerance;
+    yamlNode["Multigrid"]["Jacobi Check Interval"] >> checkInterval;
     yamlNode["Multigrid"]["V-Cycle Depth"] >> vcDepth;
     yamlNode["Multigrid"]["V-Cycle Count"] >> vcCount;
+    yamlNode["Multigrid"]["Cycle Type"] >> cycleString;
+    yamlNode["Multigrid"]["Initial Guess"] >> guessType;
     yamlNode["Multigrid"]["Pre-Smoothing Count"] >> preSmooth;
     yamlNode["Multigrid"]["Post-Smoothing Count"] >> postSmooth;
     yamlNode["Multigrid"]["Inter-Smoothing Count"] >> interSmooth;
+    yamlNode["Multigrid"]["Restriction Type"] >> restrictType;
+    yamlNode["Multigrid"]["Coarsening Type"] >> coarsenString;
+    yamlNode["Multigrid"]["Coarse Grid Operator"] >> coarseOpString;
+    yamlNode["Multigrid"]["Smoother Type"] >> smoothString;
+    yamlNode["Multigrid"]["SOR Parameter"] >> sorParam;
+    yamlNode["Multigrid"]["Sweeps Per Block"] >> sweepBlock;
+    yamlNode["Multigrid"]["Halo Depth"] >> haloString;
+    yamlNode["Multigrid"]["Residual Norm"] >> resNormType;
+    yamlNode["Multigrid"]["Relative Tolerance"] >> relTol;
+    yamlNode["Multigrid"]["Absolute Tolerance"] >> absTol;
+    yamlNode["Multigrid"]["Coarsest Level Solver"] >> coarseType;
+    yamlNode["Multigrid"]["Krylov Solver"] >> krylovString;
+    yamlNode["Multigrid"]["Poisson Solver"] >> solverString;
+    yamlNode["Multigrid"]["Multigrid Precision"] >> precisionString;
 
     inFile.close();
 }
@@ -79,19 +108,12 @@ void parser::parseYAML() {
 void parser::checkData() {
     int gridSize, localSize, coarsestSize;
 
-    // CHECK IF THE yInd VARIABLE IS SET CORRECTLY FOR A 2D/3D SIMULATION
-#ifdef PLANAR
-    if (yInd != 0) {
-        std::cout << "WARNING: Y Index parameter of YAML file is non-zero although solver has been compiled with PLANAR flag. Setting Y Index to 0" << std::endl;
-        yInd = 0;
-    }
-#else
-    if (yInd == 0) {
-        std::cout << "ERROR: Y Index parameter of YAML file is 0 for 3D simulation. ABORTING" << std::endl;
+    // CHECK IF THE yInd VARIABLE IS SET CORRECTLY. A VALUE OF 0 SETS UP A 2D SIMULATION
+    if (yInd < 0) {
+        std::cout << "ERROR: Y Index parameter of YAML file is negative. Aborting" << std::endl;
         MPI_Finalize();
         exit(0);
     }
-#endif
 
     // CHECK IF LESS THAN 1 PROCESSOR IS ASKED FOR ALONG X-DIRECTION. IF SO, WARN AND SET IT TO DEFAULT VALUE OF 1
     if (npX < 1) {
@@ -119,54 +141,220 @@ void parser::checkData() {
         exit(0);
     }
 
-    // CHECK IF MORE THAN 1 PROCESSOR IS ASKED FOR ALONG Y-DIRECTION FOR A 2D SIMULATION
-    if (yInd == 0 and npY > 1) {
-        std::cout << "ERROR: More than 1 processor is specified along Y-direction, but the yInd parameter is set to 0. Aborting" << std::endl;
+    // CHECK IF RESTRICTION TYPE STRING IS ONE OF THE AVAILABLE OPTIONS
+    if (restrictType != "DI" and restrictType != "FW") {
+        std::cout << "ERROR: Restriction type string is not correct. Aborting" << std::endl;
         MPI_Finalize();
         exit(0);
     }
 
-    // CHECK IF THE LENGTH OF ARRAY interSmooth IS LESS THAN vcDepth
-    // THE SIZE OF interSmooth IS CONVERTED TO int TO AVOID -Wsign-compare WARNING
-    // SIZE OF THIS ARRAY CAN NEVER BE TOO LARGE FOR THIS CONVERSION TO CAUSE ANY PROBLEMS ANYWAY
-    if (int(interSmooth.size()) < vcDepth) {
-        std::cout << "ERROR: The length of array of inter-smoothing counts is less than V-Cycle depths. Aborting" << std::endl;
+    // CHECK IF COARSENING TYPE STRING IS ONE OF THE AVAILABLE OPTIONS
+    if (coarsenString != "FULL" and coarsenString != "SEMI") {
+        std::cout << "ERROR: Coarsening type string is not correct. Aborting" << std::endl;
         MPI_Finalize();
         exit(0);
     }
 
-    // CHECK IF GRID SIZE SPECIFIED ALONG EACH DIRECTION IS SUFFICIENT ALONG WITH THE DOMAIN DIVIIONS TO REACH THE LOWEST LEVEL OF V-CYCLE DEPTH SPECIFIED
-    // ALONG X-DIRECTION
-    gridSize = int(pow(2, xInd));
-    localSize = gridSize/npX;
-    coarsestSize = int(pow(2, vcDepth+1));
-    if (localSize < coarsestSize) {
-        std::cout << "ERROR: The grid size and domain decomposition along X-direction results in sub-domains too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+    // CHECK IF COARSE GRID OPERATOR STRING IS ONE OF THE AVAILABLE OPTIONS
+    if (coarseOpString != "RDISC" and coarseOpString != "GALERKIN") {
+        std::cout << "ERROR: Coarse grid operator string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF THE GALERKIN OPERATOR IS ASKED FOR ALONG WITH DIRECT INJECTION. IF SO, WARN AND USE FULL WEIGHTING
+    // THE COARSE OPERATOR R.A.P IS COMPUTED WITH THE RESTRICTION R AS THE SCALED TRANSPOSE OF THE PROLONGATION, WHICH INJECTION IS NOT
+    if (coarseOpString == "GALERKIN" and restrictType == "DI") {
+        std::cout << "WARNING: Direct injection is not consistent with the Galerkin coarse grid operator. Setting Restriction Type to FW" << std::endl;
+        restrictType = "FW";
+    }
+
+    // CHECK IF SMOOTHER TYPE STRING IS ONE OF THE AVAILABLE OPTIONS
+    if (smoothString != "POINT" and smoothString != "ZLINE") {
+        std::cout << "ERROR: Smoother type string is not correct. Aborting" << std::endl;
         MPI_Finalize();
         exit(0);
     }
 
-    // ALONG Y-DIRECTION
-#ifndef PLANAR
-    gridSize = int(pow(2, yInd));
-    localSize = gridSize/npY;
-    coarsestSize = int(pow(2, vcDepth+1));
-    if (yInd > 0 and localSize < coarsestSize) {
-        std::cout << "ERROR: The grid size and domain decomposition along Y-direction results in sub-domains too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+    // CHECK IF CYCLE TYPE STRING IS ONE OF THE CYCLES AVAILABLE
+    if (cycleString != "V" and cycleString != "W" and cycleString != "F") {
+        std::cout << "ERROR: Cycle type string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF INITIAL GUESS STRING IS ONE OF THE OPTIONS AVAILABLE
+    if (guessType != "ZERO" and guessType != "FMG" and guessType != "INPUT") {
+        std::cout << "ERROR: Initial guess string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF THE OVER-RELAXATION PARAMETER OF THE SMOOTHER IS WITHIN THE RANGE FOR WHICH THE ITERATIONS CONVERGE
+    if (sorParam <= 0.0 or sorParam >= 2.0) {
+        std::cout << "ERROR: The SOR parameter must lie between 0 and 2. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF THE CONVERGENCE OF THE COARSEST LEVEL SOLVER IS CHECKED AFTER A POSITIVE NUMBER OF ITERATIONS
+    if (checkInterval < 1) {
+        std::cout << "ERROR: The check interval of the iterative solver at the coarsest level must be at least 1. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF AT LEAST ONE SMOOTHING SWEEP IS PERFORMED PER BLOCK OF FUSED SWEEPS
+    if (sweepBlock < 1) {
+        std::cout << "ERROR: The number of sweeps per block must be at least 1. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF HALO DEPTH STRING IS ONE OF THE OPTIONS AVAILABLE
+    if (haloString != "SINGLE" and haloString != "DEEP") {
+        std::cout << "ERROR: Halo depth string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF DEEP PADS ARE ASKED FOR WITHOUT FUSING THE SWEEPS. IF SO, WARN AND USE SINGLE PADS, SINCE THE DEEP PADS ARE NEVER USED
+    if (haloString == "DEEP" and sweepBlock == 1) {
+        std::cout << "WARNING: DEEP halo depth needs more than 1 sweep per block. Using SINGLE halo depth instead" << std::endl;
+        haloString = "SINGLE";
+    }
+
+    // CHECK IF RESIDUAL NORM STRING IS ONE OF THE NORMS AVAILABLE
+    if (resNormType != "L2" and resNormType != "MAX") {
+        std::cout << "ERROR: Residual norm string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF THE TOLERANCES FOR TERMINATING THE V-CYCLES ARE NON-NEGATIVE
+    if (relTol < 0.0 or absTol < 0.0) {
+        std::cout << "ERROR: The relative and absolute tolerances of the V-Cycles cannot be negative. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF COARSEST LEVEL SOLVER STRING IS ONE OF THE SOLVERS AVAILABLE
+    if (coarseType != "ITERATIVE" and coarseType != "DIRECT") {
+        std::cout << "ERROR: Coarsest level solver string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF KRYLOV SOLVER STRING IS ONE OF THE SOLVERS AVAILABLE
+    if (krylovString != "NONE" and krylovString != "CG" and krylovString != "BICGSTAB") {
+        std::cout << "ERROR: Krylov solver string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF POISSON SOLVER STRING IS ONE OF THE SOLVERS AVAILABLE
+    if (solverString != "MULTIGRID" and solverString != "TRANSFORM") {
+        std::cout << "ERROR: Poisson solver string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF MULTI-GRID PRECISION STRING IS ONE OF THE PRECISIONS AVAILABLE
+    if (precisionString != "DOUBLE" and precisionString != "SINGLE") {
+        std::cout << "ERROR: Multi-grid precision string is not correct. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF THE TRANSFORM SOLVER IS ASKED FOR ON A GRID NON-UNIFORM ALONG X OR Y. IN 2D, THE GRID ALONG Y IS IGNORED
+    // THE GRID MAY BE STRETCHED ALONG Z, IN WHICH CASE A TRIDIAGONAL SYSTEM IS SOLVED ALONG Z FOR EACH WAVENUMBER IN THE X-Y PLANE
+    if (solverString == "TRANSFORM" and (meshType[0] != 'U' or (yInd > 0 and meshType[1] != 'U'))) {
+        std::cout << "ERROR: The transform based Poisson solver can be used only on grids uniform along X and Y. Aborting" << std::endl;
         MPI_Finalize();
         exit(0);
     }
-#endif
 
-    // ALONG Z-DIRECTION
-    gridSize = int(pow(2, zInd));
-    coarsestSize = int(pow(2, vcDepth+1));
-    if (gridSize < coarsestSize) {
-        std::cout << "ERROR: The grid size along Z-direction is too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+    // CHECK IF THE TRANSFORM SOLVER IS ASKED FOR ALONG WITH A KRYLOV SOLVER, WHICH NEEDS THE MULTI-GRID CYCLES AS PRECONDITIONER
+    if (solverString == "TRANSFORM" and krylovString != "NONE") {
+        std::cout << "ERROR: The transform based Poisson solver cannot be used with a Krylov solver. Aborting" << std::endl;
         MPI_Finalize();
         exit(0);
     }
 
+    // CHECK IF CONJUGATE GRADIENT IS ASKED FOR ON A NON-UNIFORM GRID, WHERE THE OPERATOR IS NON-SYMMETRIC. IF SO, WARN THE USER
+    if (krylovString == "CG" and meshType != "UUU") {
+        std::cout << "WARNING: Conjugate gradient solver may not converge on non-uniform grids. BICGSTAB is recommended" << std::endl;
+    }
+
+    // CHECK IF FULL MULTI-GRID IS ASKED FOR ALONG WITH A KRYLOV SOLVER. IF SO, WARN AND START FROM A ZERO INITIAL GUESS
+    if (krylovString != "NONE" and guessType == "FMG") {
+        std::cout << "WARNING: Full multi-grid initial guess is not available with the Krylov solvers. Setting Initial Guess to ZERO" << std::endl;
+        guessType = "ZERO";
+    }
+
+    // CHECK IF MORE THAN 1 PROCESSOR IS ASKED FOR ALONG Y-DIRECTION FOR A 2D SIMULATION
+    if (yInd == 0 and npY > 1) {
+        std::cout << "ERROR: More than 1 processor is specified along Y-direction, but the yInd parameter is set to 0. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF THE LENGTH OF ARRAY interSmooth IS LESS THAN vcDepth
+    // THE SIZE OF interSmooth IS CONVERTED TO int TO AVOID -Wsign-compare WARNING
+    // SIZE OF THIS ARRAY CAN NEVER BE TOO LARGE FOR THIS CONVERSION TO CAUSE ANY PROBLEMS ANYWAY
+    if (int(interSmooth.size()) < vcDepth) {
+        std::cout << "ERROR: The length of array of inter-smoothing counts is less than V-Cycle depths. Aborting" << std::endl;
+        MPI_Finalize();
+        exit(0);
+    }
+
+    // CHECK IF GRID SIZE SPECIFIED ALONG EACH DIRECTION IS SUFFICIENT ALONG WITH THE DOMAIN DIVIIONS TO REACH THE LOWEST LEVEL OF V-CYCLE DEPTH SPECIFIED
+    if (coarsenString == "SEMI") {
+        // WITH SEMI-COARSENING, EACH LEVEL HALVES THE POINTS ALONG ONLY SOME OF THE DIRECTIONS, AND A DIRECTION CAN BE HALVED TILL
+        // ITS SUB-DOMAINS ARE LEFT WITH 2 INTERVALS. HENCE THE V-CYCLE DEPTH IS LIMITED BY THE SUM OF THESE HALVINGS OVER ALL DIRECTIONS
+        localSize = int(log2(npX));
+        coarsestSize = xInd - localSize - 1;
+        if (yInd > 0) {
+            localSize = int(log2(npY));
+            coarsestSize += yInd - localSize - 1;
+        }
+        coarsestSize += zInd - 1;
+        if (vcDepth > coarsestSize) {
+            std::cout << "ERROR: The grid size and domain decomposition results in sub-domains too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+            MPI_Finalize();
+            exit(0);
+        }
+    } else {
+        // ALONG X-DIRECTION
+        gridSize = int(pow(2, xInd));
+        localSize = gridSize/npX;
+        coarsestSize = int(pow(2, vcDepth+1));
+        if (localSize < coarsestSize) {
+            std::cout << "ERROR: The grid size and domain decomposition along X-direction results in sub-domains too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+            MPI_Finalize();
+            exit(0);
+        }
+
+        // ALONG Y-DIRECTION
+        gridSize = int(pow(2, yInd));
+        localSize = gridSize/npY;
+        coarsestSize = int(pow(2, vcDepth+1));
+        if (yInd > 0 and localSize < coarsestSize) {
+            std::cout << "ERROR: The grid size and domain decomposition along Y-direction results in sub-domains too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+            MPI_Finalize();
+            exit(0);
+        }
+
+        // ALONG Z-DIRECTION
+        gridSize = int(pow(2, zInd));
+        coarsestSize = int(pow(2, vcDepth+1));
+        if (gridSize < coarsestSize) {
+            std::cout << "ERROR: The grid size along Z-direction is too coarse to reach the V-Cycle depth specified. Aborting" << std::endl;
+            MPI_Finalize();
+            exit(0);
+        }
+    }
+
 #ifdef REAL_SINGLE
     if (tolerance < 5.0e-6) {
         std::cout << "ERROR: The specified tolerance for Jacobi iterations is too small for single precision calculations. Aborting" << std::endl;
@@ -174,6 +362,14 @@ void parser::checkData() {
         exit(0);
     }
 #endif
+
+#ifdef REAL_DOUBLE
+    // THE COARSEST LEVEL IS SOLVED IN SINGLE PRECISION, WHILE THE ACCURACY OF THE SOLUTION IS SET BY THE DOUBLE PRECISION RESIDUAL
+    if (precisionString == "SINGLE" and tolerance < 5.0e-6) {
+        std::cout << "WARNING: The specified tolerance for Jacobi iterations is too small for single precision multi-grid cycles. Setting Jacobi Tolerance to 5.0e-6" << std::endl;
+        tolerance = 5.0e-6;
+    }
+#endif
 }
 
 /**
@@ -194,6 +390,9 @@ void parser::setGrids() {
     yGrid = 0;
     zGrid = 0;
 
+    // A Y Index OF 0 SETS UP A 2D GRID IN THE X-Z PLANE, WITH A SINGLE POINT AND NO PADS ALONG Y
+    planar = (yInd == 0);
+
     char charMTypes[4];
     std::strcpy(charMTypes, meshType.c_str());
 
@@ -238,6 +437,229 @@ void parser::setPeriodicity() {
     if (domainType[2] == 'N') zPer = false;
 }
 
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the restriction operator of the multi-grid solver based on restrictType variable
+ *
+ *          The user specifies the restriction operator as a two letter string.
+ *          This string has to be parsed to set the integer value restrictOp, which is used by the poisson class
+ *          to choose the restriction operation to be performed when going down the V-cycle.
+ ********************************************************************************************************************************************
+ */
+void parser::setRestriction() {
+    // The integer value restrictOp is set as below:
+    // 0 - direct injection
+    // 1 - full weighting
+    restrictOp = 0;
+
+    if (restrictType == "FW") restrictOp = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the coarsening of the multi-grid levels based on coarsenString variable
+ *
+ *          The user specifies the coarsening of the multi-grid levels as a string.
+ *          This string has to be parsed to set the integer value coarsenType, which is used by the poisson class
+ *          to decide whether the grid is coarsened along all the directions at every level, or only along some of them.
+ ********************************************************************************************************************************************
+ */
+void parser::setCoarsening() {
+    // The integer value coarsenType is set as below:
+    // 0 - full coarsening along all directions
+    // 1 - semi-coarsening along the directions with the smallest grid spacing
+    coarsenType = 0;
+
+    if (coarsenString == "SEMI") coarsenType = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the operator used at the coarser levels of the multi-grid solver based on coarseOpString variable
+ *
+ *          The user specifies the coarse grid operator as a string.
+ *          This string has to be parsed to set the integer value coarseOperator, which is used by the poisson class
+ *          to decide whether the Laplacian is discretized afresh at each level, or computed from the finer level as R.A.P.
+ ********************************************************************************************************************************************
+ */
+void parser::setCoarseOperator() {
+    // The integer value coarseOperator is set as below:
+    // 0 - rediscretized Laplacian using the grid metrics at the points of each level
+    // 1 - Galerkin operator computed from the operator of the finer level
+    coarseOperator = 0;
+
+    if (coarseOpString == "GALERKIN") coarseOperator = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the smoother of the multi-grid solver based on smoothString variable
+ *
+ *          The user specifies the smoother as a string.
+ *          This string has to be parsed to set the integer value smoothType, which is used by the poisson class
+ *          to decide whether the points are relaxed individually, or along complete lines in the Z-direction.
+ ********************************************************************************************************************************************
+ */
+void parser::setSmoother() {
+    // The integer value smoothType is set as below:
+    // 0 - red-black point Gauss-Seidel
+    // 1 - zebra Z-line Gauss-Seidel
+    smoothType = 0;
+
+    if (smoothString == "ZLINE") smoothType = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the type of multi-grid cycle based on cycleString variable
+ *
+ *          The user specifies the cycle type as a single letter string.
+ *          This string has to be parsed to set the integer value cycleType, which is used by the poisson class
+ *          to decide the order in which the levels of the multi-grid hierarchy are visited.
+ ********************************************************************************************************************************************
+ */
+void parser::setCycleType() {
+    // The integer value cycleType is set as below:
+    // 0 - V-cycle
+    // 1 - W-cycle
+    // 2 - F-cycle
+    cycleType = 0;
+
+    if (cycleString == "W") cycleType = 1;
+    if (cycleString == "F") cycleType = 2;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the initial guess of the multi-grid solver based on guessType variable
+ *
+ *          The user specifies the initial guess as a string.
+ *          This string has to be parsed to set the integer value initGuess, which is used by the poisson class
+ *          to decide how the solution is initialized before the multi-grid cycles are performed.
+ ********************************************************************************************************************************************
+ */
+void parser::setInitGuess() {
+    // The integer value initGuess is set as below:
+    // 0 - zero initial guess
+    // 1 - full multi-grid
+    // 2 - input data (warm start)
+    initGuess = 0;
+
+    if (guessType == "FMG") initGuess = 1;
+    if (guessType == "INPUT") initGuess = 2;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the norm used to measure the residual of the multi-grid solver based on resNormType variable
+ *
+ *          The user specifies the norm of the residual as a string.
+ *          This string has to be parsed to set the integer value normType, which is used by the poisson class
+ *          to check the convergence of the solution after every V-cycle.
+ ********************************************************************************************************************************************
+ */
+void parser::setResidualNorm() {
+    // The integer value normType is set as below:
+    // 0 - root-mean-square (L2) norm
+    // 1 - maximum (L-infinity) norm
+    normType = 0;
+
+    if (resNormType == "MAX") normType = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the solver used at the coarsest level of the multi-grid cycles based on coarseType variable
+ *
+ *          The user specifies the coarsest level solver as a string.
+ *          This string has to be parsed to set the integer value coarseSolver, which is used by the poisson class
+ *          to decide whether the coarsest level is solved by iterations or by a direct solver.
+ ********************************************************************************************************************************************
+ */
+void parser::setCoarseSolver() {
+    // The integer value coarseSolver is set as below:
+    // 0 - iterative (Gauss-Seidel iterations till tolerance is reached)
+    // 1 - direct (LU decomposition of the coarsest level matrix on a single rank)
+    coarseSolver = 0;
+
+    if (coarseType == "DIRECT") coarseSolver = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the Krylov solver accelerating the multi-grid cycles based on krylovString variable
+ *
+ *          The user specifies the Krylov solver as a string.
+ *          This string has to be parsed to set the integer value krylovType, which is used to decide whether the multi-grid
+ *          cycles are used as a stand-alone solver, or as the preconditioner of a Krylov solver.
+ ********************************************************************************************************************************************
+ */
+void parser::setKrylovSolver() {
+    // The integer value krylovType is set as below:
+    // 0 - none (stand-alone multi-grid)
+    // 1 - preconditioned conjugate gradient
+    // 2 - preconditioned BiCGStab
+    krylovType = 0;
+
+    if (krylovString == "CG") krylovType = 1;
+    if (krylovString == "BICGSTAB") krylovType = 2;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the type of Poisson solver based on solverString variable
+ *
+ *          The user specifies the Poisson solver as a string.
+ *          This string has to be parsed to set the integer value solverType, which is used to decide whether the Poisson equation
+ *          is solved iteratively by the multi-grid cycles, or directly by the fast transforms on grids uniform along X and Y.
+ ********************************************************************************************************************************************
+ */
+void parser::setSolverType() {
+    // The integer value solverType is set as below:
+    // 0 - multi-grid
+    // 1 - transform (FFT along periodic directions and DCT along Neumann directions, with tridiagonal solves along a stretched Z)
+    solverType = 0;
+
+    if (solverString == "TRANSFORM") solverType = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the precision of the multi-grid cycles based on precisionString variable
+ *
+ *          The user specifies the precision in which the arrays of all the multi-grid levels are stored and operated upon as a string.
+ *          This string has to be parsed to set the integer value mgPrecision, which is used to decide the scalar type with which
+ *          the \ref poisson class template is instantiated.
+ ********************************************************************************************************************************************
+ */
+void parser::setPrecision() {
+    // The integer value mgPrecision is set as below:
+    // 0 - double precision
+    // 1 - single precision
+    mgPrecision = 0;
+
+    if (precisionString == "SINGLE") mgPrecision = 1;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the depth of the pads exchanged during the fused smoothing sweeps based on haloString variable
+ *
+ *          The user specifies whether the pads exchanged with the neighbouring sub-domains are deep enough for the fused sweeps
+ *          of a block to be performed without any exchange in between.
+ *          Since each half-sweep of the red-black smoother uses up one layer of the pads, this depth is twice the number of
+ *          sweeps per block, and the integer value haloDepth is set accordingly.
+ ********************************************************************************************************************************************
+ */
+void parser::setHaloDepth() {
+    // The integer value haloDepth is the number of points in the pads along X and Y:
+    // 1 - single pads, exchanged after each colour, or after each block of fused sweeps
+    // 2 x sweepBlock - deep pads, exchanged after each block of fused sweeps
+    haloDepth = 1;
+
+    if (haloString == "DEEP") haloDepth = 2*sweepBlock;
+}
+
 /**
  ********************************************************************************************************************************************
  * \brief   Function to write all the parameter values to I/O
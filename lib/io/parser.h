@@ -24,13 +24,30 @@ class parser {
         int npY, npX;
         int xInd, yInd, zInd;
         int vcDepth, vcCount;
+        int checkInterval;
         int preSmooth, postSmooth;
+        int sweepBlock, haloDepth;
+        int restrictOp;
+        int coarsenType;
+        int coarseOperator;
+        int smoothType;
+        int cycleType;
+        int initGuess;
+        int normType;
+        int coarseSolver;
+        int krylovType;
+        int solverType;
+        int mgPrecision;
 
         int xGrid, yGrid, zGrid;
 
         bool xPer, yPer, zPer;
 
+        bool planar;
+
         real tolerance;
+        real sorParam;
+        real relTol, absTol;
         real Lx, Ly, Lz;
         real betaX, betaY, betaZ;
 
@@ -44,12 +61,36 @@ class parser {
 
     private:
         std::string domainType;
+        std::string restrictType;
+        std::string coarsenString;
+        std::string coarseOpString;
+        std::string smoothString;
+        std::string cycleString;
+        std::string guessType;
+        std::string resNormType;
+        std::string coarseType;
+        std::string krylovString;
+        std::string solverString;
+        std::string precisionString;
+        std::string haloString;
 
         void parseYAML();
         void checkData();
 
         void setGrids();
         void setPeriodicity();
+        void setRestriction();
+        void setCoarsening();
+        void setCoarseOperator();
+        void setSmoother();
+        void setCycleType();
+        void setInitGuess();
+        void setResidualNorm();
+        void setCoarseSolver();
+        void setKrylovSolver();
+        void setSolverType();
+        void setPrecision();
+        void setHaloDepth();
 };
 
 /**
@@ -12,7 +12,10 @@
  * \param   parallelData is a const reference to the global data contained in the parallel class
  ********************************************************************************************************************************************
  */
-mpidata::mpidata(blitz::Array<real, 3> inputArray, const parallel &parallelData): dataField(inputArray), rankData(parallelData) {
+template <typename fReal>
+mpidata<fReal>::mpidata(blitz::Array<fReal, 3> inputArray, const parallel &parallelData): dataField(inputArray), rankData(parallelData) {
+    fieldDataType = (sizeof(fReal) == sizeof(float))? MPI_FLOAT: MPI_DOUBLE;
+
     recvStatus.resize(4);
     recvRequest.resize(4);
 }
@@ -37,10 +40,11 @@ mpidata::mpidata(blitz::Array<real, 3> inputArray, const parallel &parallelData)
  * \param   yStag specifies whether the array to which the instance of \ref mpidata class is associated with has its data points staggered in y-direction or not
  ********************************************************************************************************************************************
  */
-void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
-                              const blitz::TinyVector<int, 3> coreSize,
-                              const blitz::TinyVector<int, 3> padWidth,
-                              const bool xStag, const bool yStag) {
+template <typename fReal>
+void mpidata<fReal>::createSubarrays(const blitz::TinyVector<int, 3> globSize,
+                                     const blitz::TinyVector<int, 3> coreSize,
+                                     const blitz::TinyVector<int, 3> padWidth,
+                                     const bool xStag, const bool yStag) {
     /** The <B>loclSize</B> variable holds the local size of the sub-array slice to be sent/received within the sub-domain. */
     blitz::TinyVector<int, 3> loclSize;
 
@@ -74,14 +78,14 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
         saStarts(0) += padWidth(0);
     }
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &sendSubarrayX0);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &sendSubarrayX0);
     MPI_Type_commit(&sendSubarrayX0);
 
     // RECEIVE SUB-ARRAY ON LEFT SIDE
     saStarts = padWidth;            saStarts(0) = 0;
     loclSize = coreSize;            loclSize(0) = padWidth(0);
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &recvSubarrayX0);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &recvSubarrayX0);
     MPI_Type_commit(&recvSubarrayX0);
 
 
@@ -94,7 +98,7 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
         saStarts(0) -= padWidth(0);
     }
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &sendSubarrayX1);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &sendSubarrayX1);
     MPI_Type_commit(&sendSubarrayX1);
 
     // RECEIVE SUB-ARRAY ON RIGHT SIDE
@@ -107,11 +111,29 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
     //    saStarts(0) -= padWidth(0);
     //}
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &recvSubarrayX1);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &recvSubarrayX1);
     MPI_Type_commit(&recvSubarrayX1);
 
 
     //****************************************************! ALONG ETA-DIRECTION !***************************************************//
+    // FOR 2D SIMULATIONS THERE ARE NO PADS ALONG Y AND THE SUB-ARRAYS ARE EMPTY DATA-TYPES
+    // THESE ARE NEVER TRANSFERRED SINCE THE NEIGHBOURS ALONG Y ARE MPI_PROC_NULL, BUT MUST STILL BE VALID FOR syncData
+    if (padWidth(1) == 0) {
+        MPI_Type_contiguous(0, fieldDataType, &sendSubarrayY0);
+        MPI_Type_commit(&sendSubarrayY0);
+
+        MPI_Type_contiguous(0, fieldDataType, &recvSubarrayY0);
+        MPI_Type_commit(&recvSubarrayY0);
+
+        MPI_Type_contiguous(0, fieldDataType, &sendSubarrayY1);
+        MPI_Type_commit(&sendSubarrayY1);
+
+        MPI_Type_contiguous(0, fieldDataType, &recvSubarrayY1);
+        MPI_Type_commit(&recvSubarrayY1);
+
+        return;
+    }
+
     // SEND SUB-ARRAY ON FRONT SIDE
     saStarts = padWidth;
     loclSize = coreSize;            loclSize(1) = padWidth(1);
@@ -125,14 +147,14 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
         saStarts(1) += padWidth(1);
     }
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &sendSubarrayY0);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &sendSubarrayY0);
     MPI_Type_commit(&sendSubarrayY0);
 
     // RECEIVE SUB-ARRAY ON FRONT SIDE
     saStarts = padWidth;            saStarts(1) = 0;
     loclSize = coreSize;            loclSize(1) = padWidth(1);
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &recvSubarrayY0);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &recvSubarrayY0);
     MPI_Type_commit(&recvSubarrayY0);
 
     // SEND SUB-ARRAY ON REAR SIDE
@@ -144,7 +166,7 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
         saStarts(1) -= padWidth(1);
     }
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &sendSubarrayY1);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &sendSubarrayY1);
     MPI_Type_commit(&sendSubarrayY1);
 
     // RECEIVE SUB-ARRAY ON REAR SIDE
@@ -157,7 +179,7 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
     //    saStarts(1) -= padWidth(1);
     //}
 
-    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, MPI_FP_REAL, &recvSubarrayY1);
+    MPI_Type_create_subarray(3, globCopy.data(), loclSize.data(), saStarts.data(), MPI_ORDER_C, fieldDataType, &recvSubarrayY1);
     MPI_Type_commit(&recvSubarrayY1);
 }
 
@@ -176,7 +198,8 @@ void mpidata::createSubarrays(const blitz::TinyVector<int, 3> globSize,
  *          The recieves are non-blocking, while the sends are blocking. This combination prevents inter-processor deadlock.
  ********************************************************************************************************************************************
  */
-void mpidata::syncData() {
+template <typename fReal>
+void mpidata<fReal>::syncData() {
     recvRequest = MPI_REQUEST_NULL;
 
     MPI_Irecv(dataField.dataFirst(), 1, recvSubarrayX0, rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
@@ -191,3 +214,6 @@ void mpidata::syncData() {
 
     MPI_Waitall(4, recvRequest.dataFirst(), recvStatus.dataFirst());
 }
+
+template class mpidata<float>;
+template class mpidata<double>;
@@ -6,6 +6,7 @@
 
 #include "parallel.h"
 
+template <typename fReal>
 class mpidata {
     private:
         /** MPI subarray datatype for the slice of data to be sent to the neighbouring sub-domain to left along x-direction */
@@ -33,13 +34,16 @@ class mpidata {
         blitz::Array<MPI_Status, 1> recvStatus;
 
         /** Array of values of the data field which needs to be synchronised across processors */
-        blitz::Array<real, 3> dataField;
+        blitz::Array<fReal, 3> dataField;
 
     public:
+        /** MPI datatype of the values in the data field, which is MPI_FLOAT or MPI_DOUBLE depending on the precision of the field */
+        MPI_Datatype fieldDataType;
+
         /** A const reference to the global variables stored in the parallel class to access rank data */
         const parallel &rankData;
 
-        mpidata(blitz::Array<real, 3> inputArray, const parallel &parallelData);
+        mpidata(blitz::Array<fReal, 3> inputArray, const parallel &parallelData);
 
         void createSubarrays(const blitz::TinyVector<int, 3> globSize,
                              const blitz::TinyVector<int, 3> coreSize,
@@ -59,6 +63,7 @@ class mpidata {
  *  As a result, the limits of the sub-arrays to be sent across inter-processor boundaries is different for different arrays.
  *  Hence the <B>mpidata</B> class contains MPI_SUBARRAY derived datatypes to be initialized along with different fields in order
  *  to store their sub-arrays for inter-processor communication.
+ *  The class is templated on the scalar type fReal of the array, and the subarrays are built from the matching MPI datatype.
  ********************************************************************************************************************************************
  */
 
@@ -12,7 +12,7 @@
  * \param   iDat is a const reference to the global data contained in the parser class
  ********************************************************************************************************************************************
  */
-parallel::parallel(const parser &iDat): npX(iDat.npX), npY(iDat.npY) {
+parallel::parallel(const parser &iDat): npX(iDat.npX), npY(iDat.npY), planar(iDat.planar) {
     // GET EACH PROCESSES' RANK AND TOTAL NUMBER OF PROCESSES
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &nProc);
@@ -69,10 +69,10 @@ void parallel::getNeighbours() {
     nearRanks(1) = findRank(xRank + 1, yRank);
 
     // ALONG Y/ETA DIRECTION
-#ifndef PLANAR
-    nearRanks(2) = findRank(xRank, yRank - 1);
-    nearRanks(3) = findRank(xRank, yRank + 1);
-#endif
+    if (not planar) {
+        nearRanks(2) = findRank(xRank, yRank - 1);
+        nearRanks(3) = findRank(xRank, yRank + 1);
+    }
 }
 
 /**
@@ -25,6 +25,9 @@ class parallel {
         const int npX, npY;
         //@}
 
+        /** Flag to indicate if the simulation is 2D, in which case there are no neighbours along the Y direction */
+        const bool planar;
+
         /** Row and column communicators */
         MPI_Comm MPI_ROW_COMM, MPI_COL_COMM;
 
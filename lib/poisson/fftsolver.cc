@@ -0,0 +1,816 @@
+#include "fftsolver.h"
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Constructor of the fftsolver class derived from the poisson class
+ *
+ *          The constructor sets the limits of the staggered grid at the finest level, which is the only level used by the solver.
+ *          It then computes the number of points owned by each sub-domain along X and Y, and splits the points along Z and Y among
+ *          the sub-domains of each column and row respectively, which gives the limits of the Y and X pencils.
+ *          The eigenvalues of the discrete Laplacian along each direction, and the tables of sines and cosines used by the FFT,
+ *          are computed once here.
+ *          Finally, the counts and displacements of all the transposes are computed, and the MPI datatypes used to update the
+ *          pads of the solution are created.
+ *
+ * \param   mesh is a const reference to the global data contained in the grid class
+ * \param   solParam is a const reference to the user-set parameters contained in the parser class
+ ********************************************************************************************************************************************
+ */
+fftsolver::fftsolver(const grid &mesh, const parser &solParam): poisson<real>(mesh, solParam) {
+    int maxLength, transformCount;
+    int xBlock, yBlock, zBlock;
+    blitz::RectDomain<3> uniqCore;
+
+    stagCore.resize(1);
+    stagFull.resize(1);
+
+    stagCore(0) = blitz::RectDomain<3>(blitz::TinyVector<int, 3>(0, 0, 0), mesh.staggrCoreSize - 1);
+    stagFull(0) = blitz::RectDomain<3>(stagCore(0).lbound() - mesh.padWidths, stagCore(0).ubound() + mesh.padWidths);
+
+    uniqCore = ownedCore(0);
+
+    periodicDir = inputParams.xPer, inputParams.yPer, inputParams.zPer;
+
+    // NUMBER OF DISTINCT POINTS ALONG EACH DIRECTION OF THE GLOBAL DOMAIN. THE LAST POINT OF A PERIODIC DIRECTION IS THE IMAGE OF THE FIRST
+    globalCount = mesh.rankData.npX*stagCore(0).ubound(0) + (inputParams.xPer? 0: 1),
+                  mesh.rankData.npY*stagCore(0).ubound(1) + (inputParams.yPer? 0: 1),
+                  stagCore(0).ubound(2) + (inputParams.zPer? 0: 1);
+    if (inputParams.planar) {
+        globalCount(1) = 1;
+        periodicDir(1) = false;
+    }
+
+    // ON A GRID STRETCHED ALONG Z, THE TRANSFORMS ARE USED ONLY ALONG X AND Y
+    uniformZ = (inputParams.meshType[2] == 'U');
+    transformCount = uniformZ? 3: 2;
+
+    ownedCount = uniqCore.ubound() - uniqCore.lbound() + 1;
+    ownedStart = mesh.rankData.xRank*stagCore(0).ubound(0), mesh.rankData.yRank*stagCore(0).ubound(1), 0;
+
+    // THE TRANSFORMS NEED A POWER OF 2 POINTS ALONG PERIODIC DIRECTIONS, AND A POWER OF 2 PLUS ONE POINTS ALONG NEUMANN DIRECTIONS
+    maxLength = 1;
+    for (int i=0; i<transformCount; i++) {
+        int fftLength = periodicDir(i)? globalCount(i): 2*(globalCount(i) - 1);
+
+        if (globalCount(i) > 1 and (fftLength & (fftLength - 1)) != 0) {
+            if (mesh.rankData.rank == 0) std::cout << "ERROR: The number of grid points is not compatible with the FFT solver. Aborting" << std::endl;
+            MPI_Finalize();
+            exit(0);
+        }
+
+        maxLength = std::max(maxLength, fftLength);
+    }
+
+    // TABLES OF THE TWIDDLE FACTORS FOR THE LONGEST FFT. THE SHORTER FFTS USE EVERY n-TH ENTRY OF THESE TABLES
+    cosTable.resize(maxLength/2 + 1);
+    sinTable.resize(maxLength/2 + 1);
+    for (int i=0; i<=maxLength/2; i++) {
+        cosTable(i) = cos(2.0*M_PI*i/maxLength);
+        sinTable(i) = sin(2.0*M_PI*i/maxLength);
+    }
+
+    setEigenvalues(xEigen, 0, mesh.xix2Staggr(0), mesh.dXi);
+    setEigenvalues(yEigen, 1, mesh.ety2Staggr(0), mesh.dEt);
+    setEigenvalues(zEigen, 2, mesh.ztz2Staggr(0), mesh.dZt);
+
+    // THE INVERSE OF EACH TRANSFORM IS THE TRANSFORM ITSELF, SCALED BY THE LENGTH OF ITS FFT
+    normFactor = 1.0;
+    for (int i=0; i<transformCount; i++) {
+        if (globalCount(i) > 1) normFactor *= periodicDir(i)? globalCount(i): 2*(globalCount(i) - 1);
+    }
+
+    // THE Z PENCILS ARE SPLIT ALONG Z AMONG THE SUB-DOMAINS OF EACH COLUMN, AND THE Y PENCILS ALONG Y AMONG THE SUB-DOMAINS OF EACH ROW
+    setBlocks(zBlockCount, zBlockStart, globalCount(2), mesh.rankData.npY);
+    setBlocks(yBlockCount, yBlockStart, globalCount(1), mesh.rankData.npX);
+
+    // THE POINTS OWNED ALONG X AND Y BY ALL THE SUB-DOMAINS OF THE ROW AND COLUMN RESPECTIVELY
+    rowOwnedCount.resize(mesh.rankData.npX);        rowOwnedStart.resize(mesh.rankData.npX);
+    colOwnedCount.resize(mesh.rankData.npY);        colOwnedStart.resize(mesh.rankData.npY);
+
+    MPI_Allgather(&ownedCount(0), 1, MPI_INT, rowOwnedCount.dataFirst(), 1, MPI_INT, mesh.rankData.MPI_ROW_COMM);
+    MPI_Allgather(&ownedStart(0), 1, MPI_INT, rowOwnedStart.dataFirst(), 1, MPI_INT, mesh.rankData.MPI_ROW_COMM);
+    MPI_Allgather(&ownedCount(1), 1, MPI_INT, colOwnedCount.dataFirst(), 1, MPI_INT, mesh.rankData.MPI_COL_COMM);
+    MPI_Allgather(&ownedStart(1), 1, MPI_INT, colOwnedStart.dataFirst(), 1, MPI_INT, mesh.rankData.MPI_COL_COMM);
+
+    zBlock = zBlockCount(mesh.rankData.yRank);
+    yBlock = yBlockCount(mesh.rankData.xRank);
+
+    zPencil.resize(ownedCount(0), ownedCount(1), globalCount(2));
+    yPencil.resize(ownedCount(0), globalCount(1), zBlock);
+    xPencil.resize(globalCount(0), yBlock, zBlock);
+
+    // COUNTS AND DISPLACEMENTS OF THE TRANSPOSES BETWEEN Z AND Y PENCILS (WITHIN A COLUMN) AND BETWEEN Y AND X PENCILS (WITHIN A ROW)
+    colSendCounts.resize(mesh.rankData.npY);        colSendDispls.resize(mesh.rankData.npY);
+    colRecvCounts.resize(mesh.rankData.npY);        colRecvDispls.resize(mesh.rankData.npY);
+    for (int i=0; i<mesh.rankData.npY; i++) {
+        colSendCounts(i) = ownedCount(0)*ownedCount(1)*zBlockCount(i);
+        colRecvCounts(i) = ownedCount(0)*colOwnedCount(i)*zBlock;
+
+        colSendDispls(i) = (i == 0)? 0: colSendDispls(i - 1) + colSendCounts(i - 1);
+        colRecvDispls(i) = (i == 0)? 0: colRecvDispls(i - 1) + colRecvCounts(i - 1);
+    }
+
+    rowSendCounts.resize(mesh.rankData.npX);        rowSendDispls.resize(mesh.rankData.npX);
+    rowRecvCounts.resize(mesh.rankData.npX);        rowRecvDispls.resize(mesh.rankData.npX);
+    for (int i=0; i<mesh.rankData.npX; i++) {
+        rowSendCounts(i) = ownedCount(0)*yBlockCount(i)*zBlock;
+        rowRecvCounts(i) = rowOwnedCount(i)*yBlock*zBlock;
+
+        rowSendDispls(i) = (i == 0)? 0: rowSendDispls(i - 1) + rowSendCounts(i - 1);
+        rowRecvDispls(i) = (i == 0)? 0: rowRecvDispls(i - 1) + rowRecvCounts(i - 1);
+    }
+
+    xBlock = std::max(std::max(zPencil.size(), yPencil.size()), xPencil.size());
+    sendBuffer.resize(xBlock);
+    recvBuffer.resize(xBlock);
+
+    lhsData.resize(stagFull(0));
+    rhsData.resize(stagFull(0));
+    resData.resize(stagFull(0));
+
+    lhsData = 0.0;
+    rhsData = 0.0;
+    resData = 0.0;
+
+    // THE TRIDIAGONAL SOLVER OF THE poisson CLASS SOLVES ALONG Z TILL zEnd AT THE CURRENT LEVEL
+    zEnd.resize(1);
+    zEnd(0) = stagCore(0).ubound(2);
+
+    createPadTypes();
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to split a number of points into nearly equal contiguous blocks among a number of sub-domains
+ *
+ * \param   blockCount is a reference to the array into which the number of points in each block is written
+ * \param   blockStart is a reference to the array into which the index of the first point of each block is written
+ * \param   pointCount is the integer value of the number of points to be split
+ * \param   procCount is the integer value of the number of sub-domains among which the points are split
+ ********************************************************************************************************************************************
+ */
+void fftsolver::setBlocks(blitz::Array<int, 1> &blockCount, blitz::Array<int, 1> &blockStart, const int pointCount, const int procCount) {
+    blockCount.resize(procCount);
+    blockStart.resize(procCount);
+
+    for (int i=0; i<procCount; i++) {
+        blockCount(i) = pointCount/procCount + ((i < pointCount % procCount)? 1: 0);
+        blockStart(i) = (i == 0)? 0: blockStart(i - 1) + blockCount(i - 1);
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the eigenvalues of the discrete second derivative along one direction
+ *
+ *          For the central difference on a uniform grid, the eigenvalue of the mode k is \f$ (2\cos\theta_k - 2)/h^2 \f$, scaled
+ *          by the square of the metric of the transformed plane.
+ *          The angle is \f$ \theta_k = 2 \pi k/N \f$ for a periodic direction with N points, and \f$ \theta_k = \pi k/N \f$ for a
+ *          Neumann direction with N + 1 points.
+ *
+ * \param   eigenVal is a reference to the array into which the eigenvalues are written
+ * \param   dim is the integer value of the direction (0, 1 or 2 for X, Y or Z respectively)
+ * \param   metricCoeff is the real value of the square of the grid metric along the direction
+ * \param   gridSpacing is the real value of the grid spacing in the transformed plane along the direction
+ ********************************************************************************************************************************************
+ */
+void fftsolver::setEigenvalues(blitz::Array<real, 1> &eigenVal, const int dim, const real metricCoeff, const real gridSpacing) {
+    real thetaVal;
+
+    eigenVal.resize(globalCount(dim));
+    eigenVal = 0.0;
+
+    if (globalCount(dim) == 1) return;
+
+    thetaVal = periodicDir(dim)? 2.0*M_PI/globalCount(dim): M_PI/(globalCount(dim) - 1);
+    for (int k=0; k<globalCount(dim); k++) {
+        eigenVal(k) = metricCoeff*(2.0*cos(thetaVal*k) - 2.0)/(gridSpacing*gridSpacing);
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to create the MPI datatypes needed to update the pads of the solution
+ *
+ *          The last point along X and Y of each sub-domain is shared with the next sub-domain, but is owned by it.
+ *          Hence the first two points are sent to the previous sub-domain, where they are received into the shared point and the
+ *          pad beyond it, while the last owned point is sent to the next sub-domain, where it is received into the pad before its
+ *          first point.
+ *          The datatypes along Y span the full extent of the array along X, so that the corners are also updated.
+ *          At non-periodic walls, the neighbouring rank is set to MPI_PROC_NULL, and the pads are set by the Neumann condition.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::createPadTypes() {
+    blitz::TinyVector<int, 3> fullSize, subSize, subStart;
+
+    fullSize = stagFull(0).ubound() - stagFull(0).lbound() + 1;
+
+    // FACES NORMAL TO X
+    subSize = fullSize;             subSize(0) = 2;
+    subStart = 0, 0, 0;             subStart(0) = 1;
+    MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &xSendLft);
+    subStart(0) = fullSize(0) - 2;
+    MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &xRecvRgt);
+
+    subSize(0) = 1;
+    subStart(0) = fullSize(0) - 3;
+    MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &xSendRgt);
+    subStart(0) = 0;
+    MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &xRecvLft);
+
+    MPI_Type_commit(&xSendLft);         MPI_Type_commit(&xRecvRgt);
+    MPI_Type_commit(&xSendRgt);         MPI_Type_commit(&xRecvLft);
+
+    xLftRank = mesh.rankData.nearRanks(0);
+    xRgtRank = mesh.rankData.nearRanks(1);
+    if (not inputParams.xPer and mesh.rankData.xRank == 0) xLftRank = MPI_PROC_NULL;
+    if (not inputParams.xPer and mesh.rankData.xRank == mesh.rankData.npX - 1) xRgtRank = MPI_PROC_NULL;
+
+    if (not inputParams.planar) {
+        // FACES NORMAL TO Y
+        subSize = fullSize;             subSize(1) = 2;
+        subStart = 0, 0, 0;             subStart(1) = 1;
+        MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &ySendFrn);
+        subStart(1) = fullSize(1) - 2;
+        MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &yRecvBak);
+
+        subSize(1) = 1;
+        subStart(1) = fullSize(1) - 3;
+        MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &ySendBak);
+        subStart(1) = 0;
+        MPI_Type_create_subarray(3, fullSize.data(), subSize.data(), subStart.data(), MPI_ORDER_C, MPI_FP_REAL, &yRecvFrn);
+
+        MPI_Type_commit(&ySendFrn);         MPI_Type_commit(&yRecvBak);
+        MPI_Type_commit(&ySendBak);         MPI_Type_commit(&yRecvFrn);
+
+        yFrnRank = mesh.rankData.nearRanks(2);
+        yBakRank = mesh.rankData.nearRanks(3);
+        if (not inputParams.yPer and mesh.rankData.yRank == 0) yFrnRank = MPI_PROC_NULL;
+        if (not inputParams.yPer and mesh.rankData.yRank == mesh.rankData.npY - 1) yBakRank = MPI_PROC_NULL;
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the discrete Fourier transform of a complex sequence in place using the radix-2 FFT
+ *
+ *          The iterative Cooley-Tukey algorithm is used, with the input first permuted into bit-reversed order.
+ *          The twiddle factors are read from the tables computed in the constructor for the longest transform.
+ *
+ * \param   reVal is a reference to the array holding the real part of the sequence
+ * \param   imVal is a reference to the array holding the imaginary part of the sequence
+ * \param   lineSize is the integer value of the length of the sequence, which must be a power of 2
+ ********************************************************************************************************************************************
+ */
+void fftsolver::fftLine(blitz::Array<real, 1> &reVal, blitz::Array<real, 1> &imVal, const int lineSize) {
+    int j, tableStep;
+    real wRe, wIm, tRe, tIm;
+
+    // BIT-REVERSAL PERMUTATION
+    j = 0;
+    for (int i=1; i<lineSize; i++) {
+        int bitMask = lineSize >> 1;
+        while (j & bitMask) {
+            j ^= bitMask;
+            bitMask >>= 1;
+        }
+        j |= bitMask;
+
+        if (i < j) {
+            std::swap(reVal(i), reVal(j));
+            std::swap(imVal(i), imVal(j));
+        }
+    }
+
+    // BUTTERFLIES OF INCREASING LENGTH
+    for (int subSize=2; subSize<=lineSize; subSize <<= 1) {
+        tableStep = 2*(cosTable.size() - 1)/subSize;
+
+        for (int i=0; i<lineSize; i+=subSize) {
+            for (int k=0; k<subSize/2; k++) {
+                wRe = cosTable(k*tableStep);
+                wIm = -sinTable(k*tableStep);
+
+                tRe = wRe*reVal(i + k + subSize/2) - wIm*imVal(i + k + subSize/2);
+                tIm = wRe*imVal(i + k + subSize/2) + wIm*reVal(i + k + subSize/2);
+
+                reVal(i + k + subSize/2) = reVal(i + k) - tRe;
+                imVal(i + k + subSize/2) = imVal(i + k) - tIm;
+                reVal(i + k) += tRe;
+                imVal(i + k) += tIm;
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to transform the data along one line of the grid
+ *
+ *          Along a periodic direction with N points, the discrete Hartley transform is computed as the difference of the real and
+ *          imaginary parts of the DFT of the data.
+ *          Along a Neumann direction with N + 1 points, the type-I discrete cosine transform is computed as the DFT of the even
+ *          extension of the data, having 2N points.
+ *          Both the transforms are their own inverses, apart from the scaling by the length of the FFT.
+ *
+ * \param   lineData is a reference to the array holding the data along the line, which is overwritten by its transform
+ * \param   reVal is a reference to the work array used for the real part of the FFT
+ * \param   imVal is a reference to the work array used for the imaginary part of the FFT
+ * \param   dim is the integer value of the direction of the line (0, 1 or 2 for X, Y or Z respectively)
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transformLine(blitz::Array<real, 1> &lineData, blitz::Array<real, 1> &reVal, blitz::Array<real, 1> &imVal, const int dim) {
+    int pointCount = globalCount(dim);
+
+    if (periodicDir(dim)) {
+        for (int i=0; i<pointCount; i++) {
+            reVal(i) = lineData(i);
+            imVal(i) = 0.0;
+        }
+
+        fftLine(reVal, imVal, pointCount);
+
+        for (int i=0; i<pointCount; i++) {
+            lineData(i) = reVal(i) - imVal(i);
+        }
+
+    } else {
+        for (int i=0; i<pointCount; i++) {
+            reVal(i) = lineData(i);
+            imVal(i) = 0.0;
+        }
+        for (int i=pointCount; i<2*(pointCount - 1); i++) {
+            reVal(i) = lineData(2*(pointCount - 1) - i);
+            imVal(i) = 0.0;
+        }
+
+        fftLine(reVal, imVal, 2*(pointCount - 1));
+
+        for (int i=0; i<pointCount; i++) {
+            lineData(i) = reVal(i);
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to transform the data in the Z pencils along Z
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transformZ() {
+    if (globalCount(2) == 1) return;
+
+#pragma omp parallel num_threads(inputParams.nThreads) default(none)
+    {
+        blitz::Array<real, 1> lineData(globalCount(2));
+        blitz::Array<real, 1> reVal(2*globalCount(2)), imVal(2*globalCount(2));
+
+#pragma omp for collapse(2)
+        for (int iX = 0; iX < zPencil.extent(0); iX++) {
+            for (int iY = 0; iY < zPencil.extent(1); iY++) {
+                for (int iZ = 0; iZ < globalCount(2); iZ++) lineData(iZ) = zPencil(iX, iY, iZ);
+
+                transformLine(lineData, reVal, imVal, 2);
+
+                for (int iZ = 0; iZ < globalCount(2); iZ++) zPencil(iX, iY, iZ) = lineData(iZ);
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to transform the data in the Y pencils along Y
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transformY() {
+    if (globalCount(1) == 1) return;
+
+#pragma omp parallel num_threads(inputParams.nThreads) default(none)
+    {
+        blitz::Array<real, 1> lineData(globalCount(1));
+        blitz::Array<real, 1> reVal(2*globalCount(1)), imVal(2*globalCount(1));
+
+#pragma omp for collapse(2)
+        for (int iX = 0; iX < yPencil.extent(0); iX++) {
+            for (int iZ = 0; iZ < yPencil.extent(2); iZ++) {
+                for (int iY = 0; iY < globalCount(1); iY++) lineData(iY) = yPencil(iX, iY, iZ);
+
+                transformLine(lineData, reVal, imVal, 1);
+
+                for (int iY = 0; iY < globalCount(1); iY++) yPencil(iX, iY, iZ) = lineData(iY);
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to transform the data in the X pencils along X
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transformX() {
+    if (globalCount(0) == 1) return;
+
+#pragma omp parallel num_threads(inputParams.nThreads) default(none)
+    {
+        blitz::Array<real, 1> lineData(globalCount(0));
+        blitz::Array<real, 1> reVal(2*globalCount(0)), imVal(2*globalCount(0));
+
+#pragma omp for collapse(2)
+        for (int iY = 0; iY < xPencil.extent(1); iY++) {
+            for (int iZ = 0; iZ < xPencil.extent(2); iZ++) {
+                for (int iX = 0; iX < globalCount(0); iX++) lineData(iX) = xPencil(iX, iY, iZ);
+
+                transformLine(lineData, reVal, imVal, 0);
+
+                for (int iX = 0; iX < globalCount(0); iX++) xPencil(iX, iY, iZ) = lineData(iX);
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to move the data from the Z pencils to the Y pencils within each column of sub-domains
+ *
+ *          Each sub-domain sends the block of its Z pencil lying within the Z range of every other sub-domain of the column, and
+ *          receives the points owned along Y by all of them, within its own Z range.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transposeZtoY() {
+    int bufIndex;
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npY; p++) {
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = 0; iY < ownedCount(1); iY++) {
+                for (int iZ = zBlockStart(p); iZ < zBlockStart(p) + zBlockCount(p); iZ++) {
+                    sendBuffer(bufIndex) = zPencil(iX, iY, iZ);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+
+    MPI_Alltoallv(sendBuffer.dataFirst(), colSendCounts.dataFirst(), colSendDispls.dataFirst(), MPI_FP_REAL,
+                  recvBuffer.dataFirst(), colRecvCounts.dataFirst(), colRecvDispls.dataFirst(), MPI_FP_REAL, mesh.rankData.MPI_COL_COMM);
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npY; p++) {
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = colOwnedStart(p); iY < colOwnedStart(p) + colOwnedCount(p); iY++) {
+                for (int iZ = 0; iZ < yPencil.extent(2); iZ++) {
+                    yPencil(iX, iY, iZ) = recvBuffer(bufIndex);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to move the data from the Y pencils back to the Z pencils within each column of sub-domains
+ *
+ *          This is the reverse of \ref transposeZtoY, with the send and receive counts interchanged.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transposeYtoZ() {
+    int bufIndex;
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npY; p++) {
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = colOwnedStart(p); iY < colOwnedStart(p) + colOwnedCount(p); iY++) {
+                for (int iZ = 0; iZ < yPencil.extent(2); iZ++) {
+                    sendBuffer(bufIndex) = yPencil(iX, iY, iZ);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+
+    MPI_Alltoallv(sendBuffer.dataFirst(), colRecvCounts.dataFirst(), colRecvDispls.dataFirst(), MPI_FP_REAL,
+                  recvBuffer.dataFirst(), colSendCounts.dataFirst(), colSendDispls.dataFirst(), MPI_FP_REAL, mesh.rankData.MPI_COL_COMM);
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npY; p++) {
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = 0; iY < ownedCount(1); iY++) {
+                for (int iZ = zBlockStart(p); iZ < zBlockStart(p) + zBlockCount(p); iZ++) {
+                    zPencil(iX, iY, iZ) = recvBuffer(bufIndex);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to move the data from the Y pencils to the X pencils within each row of sub-domains
+ *
+ *          Each sub-domain sends the block of its Y pencil lying within the Y range of every other sub-domain of the row, and
+ *          receives the points owned along X by all of them, within its own Y range.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transposeYtoX() {
+    int bufIndex;
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npX; p++) {
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = yBlockStart(p); iY < yBlockStart(p) + yBlockCount(p); iY++) {
+                for (int iZ = 0; iZ < yPencil.extent(2); iZ++) {
+                    sendBuffer(bufIndex) = yPencil(iX, iY, iZ);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+
+    MPI_Alltoallv(sendBuffer.dataFirst(), rowSendCounts.dataFirst(), rowSendDispls.dataFirst(), MPI_FP_REAL,
+                  recvBuffer.dataFirst(), rowRecvCounts.dataFirst(), rowRecvDispls.dataFirst(), MPI_FP_REAL, mesh.rankData.MPI_ROW_COMM);
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npX; p++) {
+        for (int iX = rowOwnedStart(p); iX < rowOwnedStart(p) + rowOwnedCount(p); iX++) {
+            for (int iY = 0; iY < xPencil.extent(1); iY++) {
+                for (int iZ = 0; iZ < xPencil.extent(2); iZ++) {
+                    xPencil(iX, iY, iZ) = recvBuffer(bufIndex);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to move the data from the X pencils back to the Y pencils within each row of sub-domains
+ *
+ *          This is the reverse of \ref transposeYtoX, with the send and receive counts interchanged.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::transposeXtoY() {
+    int bufIndex;
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npX; p++) {
+        for (int iX = rowOwnedStart(p); iX < rowOwnedStart(p) + rowOwnedCount(p); iX++) {
+            for (int iY = 0; iY < xPencil.extent(1); iY++) {
+                for (int iZ = 0; iZ < xPencil.extent(2); iZ++) {
+                    sendBuffer(bufIndex) = xPencil(iX, iY, iZ);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+
+    MPI_Alltoallv(sendBuffer.dataFirst(), rowRecvCounts.dataFirst(), rowRecvDispls.dataFirst(), MPI_FP_REAL,
+                  recvBuffer.dataFirst(), rowSendCounts.dataFirst(), rowSendDispls.dataFirst(), MPI_FP_REAL, mesh.rankData.MPI_ROW_COMM);
+
+    bufIndex = 0;
+    for (int p=0; p<mesh.rankData.npX; p++) {
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = yBlockStart(p); iY < yBlockStart(p) + yBlockCount(p); iY++) {
+                for (int iZ = 0; iZ < yPencil.extent(2); iZ++) {
+                    yPencil(iX, iY, iZ) = recvBuffer(bufIndex);
+                    bufIndex += 1;
+                }
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to solve the Poisson equation in the transformed space
+ *
+ *          Each mode of the transformed RHS is divided by the sum of the eigenvalues along the three directions, and by the scaling
+ *          of the inverse transforms.
+ *          The mode having zero wavenumber along all the directions is the null space of the Laplacian with periodic and Neumann
+ *          boundary conditions, and is set to zero, which removes the mean of the solution.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::divideEigenvalues() {
+    int yStart, zStart;
+
+    yStart = yBlockStart(mesh.rankData.xRank);
+    zStart = zBlockStart(mesh.rankData.yRank);
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(yStart, zStart)
+    for (int iX = 0; iX < xPencil.extent(0); iX++) {
+        for (int iY = 0; iY < xPencil.extent(1); iY++) {
+            for (int iZ = 0; iZ < xPencil.extent(2); iZ++) {
+                real eigenSum = xEigen(iX) + yEigen(yStart + iY) + zEigen(zStart + iZ);
+
+                xPencil(iX, iY, iZ) = (eigenSum == 0.0)? 0.0: xPencil(iX, iY, iZ)/(eigenSum*normFactor);
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to solve the tridiagonal systems along Z for all the wavenumbers in the X-Y plane held by the sub-domain
+ *
+ *          After the transforms along X and Y, each line of the Z pencil corresponds to one pair of wavenumbers, and the Laplacian
+ *          reduces to the second derivative along Z on the stretched grid, shifted by the eigenvalues along X and Y.
+ *          The coefficients along Z are the same as those of the multi-grid solvers, and the system is solved by \ref solveZLine,
+ *          which also imposes the periodic or Neumann condition along Z.
+ *          For the zero wavenumber along both X and Y, the system is singular, and the solution at the first point is set to zero
+ *          to remove the arbitrary constant.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::solveZColumns() {
+    int zLength;
+
+    zLength = stagCore(0).ubound(2) + 1;
+
+#pragma omp parallel num_threads(inputParams.nThreads) default(none) shared(zLength)
+    {
+        real eigenSum;
+
+        blitz::Array<real, 1> lowDiag(zLength), diagVal(zLength), uppDiag(zLength);
+        blitz::Array<real, 1> lineVal(zLength), workVal(zLength), corrVal(zLength);
+
+#pragma omp for collapse(2)
+        for (int iX = 0; iX < ownedCount(0); iX++) {
+            for (int iY = 0; iY < ownedCount(1); iY++) {
+                eigenSum = xEigen(ownedStart(0) + iX) + yEigen(ownedStart(1) + iY);
+
+                for (int iZ = 0; iZ < zLength; iZ++) {
+                    lowDiag(iZ) = mesh.ztz2Staggr(iZ)/(mesh.dZt*mesh.dZt) - mesh.ztzzStaggr(iZ)/(2.0*mesh.dZt);
+                    uppDiag(iZ) = mesh.ztz2Staggr(iZ)/(mesh.dZt*mesh.dZt) + mesh.ztzzStaggr(iZ)/(2.0*mesh.dZt);
+                    diagVal(iZ) = eigenSum - 2.0*mesh.ztz2Staggr(iZ)/(mesh.dZt*mesh.dZt);
+                }
+
+                // THE INVERSE TRANSFORMS ALONG X AND Y ARE SCALED HERE
+                for (int iZ = 0; iZ < globalCount(2); iZ++) lineVal(iZ) = zPencil(iX, iY, iZ)/normFactor;
+
+                if (eigenSum == 0.0) {
+                    lowDiag(0) = 0.0;
+                    uppDiag(0) = 0.0;
+                    diagVal(0) = 1.0;
+                    lineVal(0) = 0.0;
+                }
+
+                solveZLine(lowDiag, diagVal, uppDiag, lineVal, workVal, corrVal);
+
+                for (int iZ = 0; iZ < globalCount(2); iZ++) zPencil(iX, iY, iZ) = lineVal(iZ);
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to update the shared points and pads of the solution from the owned points
+ *
+ *          Along Z, the last point and the pads are set by periodicity or by the Neumann condition, since the grid is never
+ *          decomposed along Z.
+ *          Along X and Y, the data is first exchanged with the neighbouring sub-domains, and the Neumann condition is then
+ *          imposed at the non-periodic walls.
+ ********************************************************************************************************************************************
+ */
+void fftsolver::updateLHSPads() {
+    int zEnd;
+
+    MPI_Status padStatus;
+
+    zEnd = stagCore(0).ubound(2);
+
+    if (inputParams.zPer) {
+        lhsData(blitz::Range::all(), blitz::Range::all(), zEnd) = lhsData(blitz::Range::all(), blitz::Range::all(), 0);
+        lhsData(blitz::Range::all(), blitz::Range::all(), -1) = lhsData(blitz::Range::all(), blitz::Range::all(), zEnd - 1);
+        lhsData(blitz::Range::all(), blitz::Range::all(), zEnd + 1) = lhsData(blitz::Range::all(), blitz::Range::all(), 1);
+    } else {
+        lhsData(blitz::Range::all(), blitz::Range::all(), -1) = lhsData(blitz::Range::all(), blitz::Range::all(), 1);
+        lhsData(blitz::Range::all(), blitz::Range::all(), zEnd + 1) = lhsData(blitz::Range::all(), blitz::Range::all(), zEnd - 1);
+    }
+
+    MPI_Sendrecv(lhsData.dataFirst(), 1, xSendLft, xLftRank, 1, lhsData.dataFirst(), 1, xRecvRgt, xRgtRank, 1, MPI_COMM_WORLD, &padStatus);
+    MPI_Sendrecv(lhsData.dataFirst(), 1, xSendRgt, xRgtRank, 2, lhsData.dataFirst(), 1, xRecvLft, xLftRank, 2, MPI_COMM_WORLD, &padStatus);
+
+    if (xLftRank == MPI_PROC_NULL) lhsData(-1, blitz::Range::all(), blitz::Range::all()) = lhsData(1, blitz::Range::all(), blitz::Range::all());
+    if (xRgtRank == MPI_PROC_NULL) lhsData(stagCore(0).ubound(0) + 1, blitz::Range::all(), blitz::Range::all()) = lhsData(stagCore(0).ubound(0) - 1, blitz::Range::all(), blitz::Range::all());
+
+    // IN 2D, THERE ARE NO PADS ALONG Y
+    if (not inputParams.planar) {
+        MPI_Sendrecv(lhsData.dataFirst(), 1, ySendFrn, yFrnRank, 3, lhsData.dataFirst(), 1, yRecvBak, yBakRank, 3, MPI_COMM_WORLD, &padStatus);
+        MPI_Sendrecv(lhsData.dataFirst(), 1, ySendBak, yBakRank, 4, lhsData.dataFirst(), 1, yRecvFrn, yFrnRank, 4, MPI_COMM_WORLD, &padStatus);
+
+        if (yFrnRank == MPI_PROC_NULL) lhsData(blitz::Range::all(), -1, blitz::Range::all()) = lhsData(blitz::Range::all(), 1, blitz::Range::all());
+        if (yBakRank == MPI_PROC_NULL) lhsData(blitz::Range::all(), stagCore(0).ubound(1) + 1, blitz::Range::all()) = lhsData(blitz::Range::all(), stagCore(0).ubound(1) - 1, blitz::Range::all());
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to solve the Poisson equation directly using the fast transforms
+ *
+ *          The RHS at the points owned by the sub-domain is transformed along Z, Y and X in turn, moving between the pencils in
+ *          between, and is divided by the eigenvalues of the Laplacian.
+ *          The result is transformed back along X, Y and Z, and the shared points and pads of the solution are updated.
+ *          On a grid stretched along Z, the RHS is transformed only along Y and X, and is moved back to the Z pencils, where
+ *          \ref solveZColumns solves along Z for each wavenumber, before the result is transformed back.
+ *          The initial guess is not needed, and the solution is computed in one pass, which is counted as one cycle.
+ *          The norm of the residual of the computed solution is stored in \ref residualNorm, so that the solver can be compared
+ *          against the multi-grid solvers.
+ *
+ * \param   inFn is a reference to the plain scalar field into which the computed solution is written
+ * \param   rhs is a const reference to the plain scalar field which holds the RHS of the Poisson equation
+ ********************************************************************************************************************************************
+ */
+void fftsolver::mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs) {
+    blitz::RectDomain<3> uniqCore = ownedCore(0);
+
+    rhsData(stagCore(0)) = rhs.F(stagCore(0));
+
+    for (int iX = 0; iX < ownedCount(0); iX++) {
+        for (int iY = 0; iY < ownedCount(1); iY++) {
+            for (int iZ = 0; iZ < globalCount(2); iZ++) {
+                zPencil(iX, iY, iZ) = rhsData(iX, iY, iZ);
+            }
+        }
+    }
+
+    if (uniformZ) {
+        transformZ();
+        transposeZtoY();
+        transformY();
+        transposeYtoX();
+        transformX();
+
+        divideEigenvalues();
+
+        transformX();
+        transposeXtoY();
+        transformY();
+        transposeYtoZ();
+        transformZ();
+
+    } else {
+        // ON A GRID STRETCHED ALONG Z, THE DATA TRANSFORMED ALONG X AND Y IS MOVED BACK TO THE Z PENCILS FOR THE TRIDIAGONAL SOLVES
+        transposeZtoY();
+        transformY();
+        transposeYtoX();
+        transformX();
+        transposeXtoY();
+        transposeYtoZ();
+
+        solveZColumns();
+
+        transposeZtoY();
+        transposeYtoX();
+        transformX();
+        transposeXtoY();
+        transformY();
+        transposeYtoZ();
+    }
+
+    lhsData = 0.0;
+    for (int iX = 0; iX < ownedCount(0); iX++) {
+        for (int iY = 0; iY < ownedCount(1); iY++) {
+            for (int iZ = 0; iZ < globalCount(2); iZ++) {
+                lhsData(iX, iY, iZ) = zPencil(iX, iY, iZ);
+            }
+        }
+    }
+
+    updateLHSPads();
+
+    cyclesUsed = 1;
+
+    // RESIDUAL OF THE SOLUTION, COMPUTED WITH THE SAME DISCRETIZATION AS THE MULTI-GRID SOLVERS
+    resData = 0.0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iY = uniqCore.lbound(1); iY <= uniqCore.ubound(1); iY++) {
+            for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+                resData(iX, iY, iZ) = rhsData(iX, iY, iZ) -
+                                     (mesh.xix2Staggr(iX)*(lhsData(iX + 1, iY, iZ) - 2.0*lhsData(iX, iY, iZ) + lhsData(iX - 1, iY, iZ))/(mesh.dXi*mesh.dXi) +
+                                      mesh.ztz2Staggr(iZ)*(lhsData(iX, iY, iZ + 1) - 2.0*lhsData(iX, iY, iZ) + lhsData(iX, iY, iZ - 1))/(mesh.dZt*mesh.dZt) +
+                                      mesh.ztzzStaggr(iZ)*(lhsData(iX, iY, iZ + 1) - lhsData(iX, iY, iZ - 1))/(2.0*mesh.dZt));
+                if (not inputParams.planar) {
+                    resData(iX, iY, iZ) -= mesh.ety2Staggr(iY)*(lhsData(iX, iY + 1, iZ) - 2.0*lhsData(iX, iY, iZ) + lhsData(iX, iY - 1, iZ))/(mesh.dEt*mesh.dEt);
+                }
+            }
+        }
+    }
+    residualNorm = computeNorm(resData);
+
+    // RETURN CALCULATED PRESSURE DATA
+    inFn.F = lhsData(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
+}
+
+fftsolver::~fftsolver() {
+    MPI_Type_free(&xSendLft);           MPI_Type_free(&xRecvRgt);
+    MPI_Type_free(&xSendRgt);           MPI_Type_free(&xRecvLft);
+
+    if (not inputParams.planar) {
+        MPI_Type_free(&ySendFrn);           MPI_Type_free(&yRecvBak);
+        MPI_Type_free(&ySendBak);           MPI_Type_free(&yRecvFrn);
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef FFTSOLVER_H
+#define FFTSOLVER_H
+
+#include <blitz/array.h>
+#include <math.h>
+
+#include "poisson.h"
+
+class fftsolver: public poisson<real> {
+    private:
+        real normFactor;
+
+        bool uniformZ;
+
+        blitz::TinyVector<int, 3> globalCount;
+        blitz::TinyVector<int, 3> ownedCount, ownedStart;
+        blitz::TinyVector<bool, 3> periodicDir;
+
+        blitz::Array<real, 1> cosTable, sinTable;
+
+        blitz::Array<real, 1> xEigen, yEigen, zEigen;
+
+        blitz::Array<real, 3> zPencil, yPencil, xPencil;
+        blitz::Array<real, 1> sendBuffer, recvBuffer;
+
+        blitz::Array<int, 1> zBlockCount, zBlockStart;
+        blitz::Array<int, 1> yBlockCount, yBlockStart;
+        blitz::Array<int, 1> rowOwnedCount, rowOwnedStart;
+        blitz::Array<int, 1> colOwnedCount, colOwnedStart;
+
+        blitz::Array<int, 1> colSendCounts, colSendDispls, colRecvCounts, colRecvDispls;
+        blitz::Array<int, 1> rowSendCounts, rowSendDispls, rowRecvCounts, rowRecvDispls;
+
+        blitz::Array<real, 3> lhsData, rhsData, resData;
+
+        MPI_Datatype xSendLft, xSendRgt, xRecvLft, xRecvRgt;
+        MPI_Datatype ySendFrn, ySendBak, yRecvFrn, yRecvBak;
+
+        int xLftRank, xRgtRank, yFrnRank, yBakRank;
+
+        void setBlocks(blitz::Array<int, 1> &blockCount, blitz::Array<int, 1> &blockStart, const int pointCount, const int procCount);
+        void setEigenvalues(blitz::Array<real, 1> &eigenVal, const int dim, const real metricCoeff, const real gridSpacing);
+
+        void createPadTypes();
+
+        void fftLine(blitz::Array<real, 1> &reVal, blitz::Array<real, 1> &imVal, const int lineSize);
+        void transformLine(blitz::Array<real, 1> &lineData, blitz::Array<real, 1> &reVal, blitz::Array<real, 1> &imVal, const int dim);
+
+        void transformZ();
+        void transformY();
+        void transformX();
+
+        void transposeZtoY();
+        void transposeYtoZ();
+        void transposeYtoX();
+        void transposeXtoY();
+
+        void divideEigenvalues();
+        void solveZColumns();
+
+        void updateLHSPads();
+
+    public:
+        fftsolver(const grid &mesh, const parser &solParam);
+
+        void mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs);
+
+        ~fftsolver();
+};
+
+/**
+ ********************************************************************************************************************************************
+ *  \class fftsolver fftsolver.h "lib/poisson/fftsolver.h"
+ *  \brief The derived class from poisson to solve the Poisson equation directly on uniform grids using fast transforms
+ *
+ *  On a uniform grid, the discrete Laplacian along a periodic direction is diagonalized by the discrete Fourier transform, and along
+ *  a direction with Neumann boundary conditions, by the type-I discrete cosine transform.
+ *  The class solves the Poisson equation by transforming the RHS along all the three directions, dividing by the eigenvalues of the
+ *  discrete Laplacian, and transforming the result back, which costs \f$ O(N \log N) \f$ operations without any iterations.
+ *  Since the Laplacian along a periodic direction is symmetric, the real-valued Hartley transform is used in place of the Fourier
+ *  transform, so that all the data stays real.
+ *  Both the transforms are computed using a radix-2 FFT, since the number of grid points is always a power of 2 (plus one for the
+ *  cosine transform).
+ *  If the grid is stretched along Z, the transforms are used only along X and Y, and the resulting tridiagonal system along Z is
+ *  solved for each wavenumber in the X-Y plane, using the same grid metrics along Z as the multi-grid solvers.
+ *  As the transforms along X and Y need all the points along those directions, the data is moved between Z, Y and X pencils using
+ *  all-to-all transposes within the row and column communicators of the \ref parallel class.
+ *  The solver is selected through the \ref parser#solverType "solverType" parameter, and is used through the same
+ *  \ref mgSolve interface as the multi-grid solvers.
+ *  Since it has no hierarchy of levels, the class always works in the precision of the fields, and derives from the instantiation
+ *  of the \ref poisson class template with the same scalar type.
+ ********************************************************************************************************************************************
+ */
+
+#endif
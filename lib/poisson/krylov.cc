@@ -0,0 +1,304 @@
+#include "krylov.h"
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Constructor of the krylov class
+ *
+ *          The constructor assigns the references to the grid and parser class instances, along with the multi-grid solver
+ *          which is used as the preconditioner.
+ *          All the vectors of the Krylov method are allocated with the same limits as the finest level of the multi-grid solver,
+ *          so that the pads needed to compute the Laplacian are available.
+ *          Only the vectors needed by the selected method are allocated.
+ *          The total number of grid points, which is needed to compute the root-mean-square norm of the residual, is also
+ *          computed once here.
+ *
+ * \param   mesh is a const reference to the global data contained in the grid class
+ * \param   solParam is a const reference to the user-set parameters contained in the parser class
+ * \param   mgSolver is a reference to the multi-grid solver used as the preconditioner
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+krylov<mgReal>::krylov(const grid &mesh, const parser &solParam, poisson<mgReal> &mgSolver): mesh(mesh), inputParams(solParam), mgSolver(mgSolver) {
+    real localCount;
+
+    blitz::RectDomain<3> fullDomain = mgSolver.stagFull(0);
+
+    uniqCore = mgSolver.ownedCore(0);
+
+    lhsData.resize(fullDomain);         rhsData.resize(fullDomain);
+    rVec.resize(fullDomain);            pVec.resize(fullDomain);
+    qVec.resize(fullDomain);
+
+    if (inputParams.krylovType == 1) {
+        rOld.resize(fullDomain);        pHat.resize(fullDomain);
+    } else {
+        rHat.resize(fullDomain);        pHat.resize(fullDomain);
+        sVec.resize(fullDomain);        sHat.resize(fullDomain);
+        tVec.resize(fullDomain);
+    }
+
+    lhsData = 0.0;      rhsData = 0.0;
+    rVec = 0.0;         pVec = 0.0;
+    qVec = 0.0;         pHat = 0.0;
+
+    localCount = blitz::product(uniqCore.ubound() - uniqCore.lbound() + 1);
+    MPI_Allreduce(&localCount, &pointCount, 1, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD);
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to solve the Poisson equation using the Krylov method selected by the user
+ *
+ *          The function transfers the RHS, and the initial guess if specified, into the local vectors, and calls the solver
+ *          corresponding to the \ref parser#krylovType "krylovType" parameter.
+ *          The weighted means of the RHS and the initial guess are removed first, as in \ref poisson#mgSolve "mgSolve", so that the
+ *          iterations do not diverge along the null space of the singular operator, and the solution is returned with zero mean.
+ *          The iterations are stopped using the same tolerances as the stand-alone multi-grid solver, and the number of
+ *          preconditioning cycles performed is limited by the V-Cycle Count specified by the user.
+ *
+ * \param   inFn is a reference to the plain scalar field into which the computed solution is written
+ * \param   rhs is a const reference to the plain scalar field which holds the RHS of the Poisson equation
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void krylov<mgReal>::krylovSolve(plainsf<real> &inFn, const plainsf<real> &rhs) {
+    rhsData(mgSolver.stagCore(0)) = rhs.F(mgSolver.stagCore(0));
+
+    if (inputParams.initGuess == 2) {
+        lhsData(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound())) = inFn.F;
+    } else {
+        lhsData = 0.0;
+    }
+
+    // AS IN THE STAND-ALONE MULTI-GRID SOLVER, THE RHS IS MADE COMPATIBLE WITH THE SINGULAR OPERATOR, SINCE ANY PART OF IT ALONG THE
+    // NULL SPACE CANNOT BE SATISFIED AND MAKES THE KRYLOV ITERATIONS DIVERGE. THE MEAN OF THE INITIAL GUESS IS ALSO REMOVED
+    rhsData(mgSolver.stagCore(0)) -= mgSolver.weightedMean(rhsData);
+    lhsData -= mgSolver.weightedMean(lhsData);
+
+    // THE RELATIVE TOLERANCE IS MEASURED AGAINST THE NORM OF THE RHS, WHICH IS THE RESIDUAL OF A ZERO INITIAL GUESS
+    rVec = rhsData;
+    localSums[0] = localDot(rVec, rVec);
+    startReduction(1, true);
+    finishReduction();
+    targetNorm = std::max(inputParams.absTol, inputParams.relTol*reducedNorm(globalSums[0]));
+
+    // COMPUTE THE INITIAL RESIDUAL. THE PADS OF THE INITIAL GUESS ARE ALSO MADE CONSISTENT WITH THE BOUNDARY CONDITIONS HERE
+    mgSolver.applyOperator(lhsData, qVec);
+    rVec = rhsData - qVec;
+
+    localSums[0] = localDot(rVec, rVec);
+    startReduction(1, true);
+    finishReduction();
+    residualNorm = reducedNorm(globalSums[0]);
+
+    cyclesUsed = 0;
+
+    if (inputParams.krylovType == 1) {
+        pcgSolve();
+    } else {
+        bicgSolve();
+    }
+
+    // THE SOLUTION IS RETURNED WITH ZERO MEAN
+    lhsData -= mgSolver.weightedMean(lhsData);
+
+    // RETURN CALCULATED PRESSURE DATA
+    inFn.F = lhsData(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to perform the preconditioned conjugate gradient iterations
+ *
+ *          Since the multi-grid cycle used as the preconditioner is neither exactly symmetric nor exactly linear (the smoothing
+ *          sweeps are not reversed in the post-smoothing, and the coarsest level may be solved iteratively to a tolerance),
+ *          the flexible (Polak-Ribiere) form of the update of the search direction is used.
+ *          This needs the inner product of the preconditioned residual with the residual of the previous iteration, which is
+ *          reduced together with the inner product of the current residual.
+ *          Each iteration performs one multi-grid cycle and three reductions, two of which overlap with vector updates.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void krylov<mgReal>::pcgSolve() {
+    real alpha, beta;
+    real rzProd, rzPrev;
+
+    rOld = 0.0;
+    rzPrev = 1.0;
+
+    while (residualNorm > targetNorm and cyclesUsed < inputParams.vcCount) {
+        // APPLY THE PRECONDITIONER. THE PRECONDITIONED RESIDUAL IS STORED IN pHat
+        mgSolver.applyPreconditioner(rVec, pHat);
+
+        cyclesUsed += 1;
+
+        localSums[0] = localDot(rVec, pHat);
+        localSums[1] = localDot(rOld, pHat);
+        startReduction(2, false);
+        finishReduction();
+        rzProd = globalSums[0];
+
+        // THE FIRST SEARCH DIRECTION IS THE PRECONDITIONED RESIDUAL ITSELF
+        beta = (cyclesUsed == 1)? 0.0: (globalSums[0] - globalSums[1])/rzPrev;
+        pVec = pHat + beta*pVec;
+
+        mgSolver.applyOperator(pVec, qVec);
+
+        // THE CURRENT RESIDUAL IS SAVED WHILE THE INNER PRODUCT FOR THE STEP LENGTH IS BEING REDUCED
+        localSums[0] = localDot(pVec, qVec);
+        startReduction(1, false);
+        rOld = rVec;
+        finishReduction();
+
+        alpha = rzProd/globalSums[0];
+        rVec -= alpha*qVec;
+
+        // THE SOLUTION IS UPDATED WHILE THE NORM OF THE NEW RESIDUAL IS BEING REDUCED
+        localSums[0] = localDot(rVec, rVec);
+        startReduction(1, true);
+        lhsData += alpha*pVec;
+        finishReduction();
+
+        residualNorm = reducedNorm(globalSums[0]);
+        rzPrev = rzProd;
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to perform the right-preconditioned BiCGStab iterations
+ *
+ *          BiCGStab does not need the operator to be symmetric, and hence remains robust when the first derivative terms of
+ *          stretched grids are significant.
+ *          Each iteration performs two multi-grid cycles and three reductions.
+ *          The inner products needed to compute the stabilization parameter, as well as those needed for the convergence check and
+ *          the next search direction, are reduced together, and both these reductions overlap with the update of the solution.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void krylov<mgReal>::bicgSolve() {
+    real alpha, beta, omega;
+    real rhoValue, rhoPrev;
+
+    // THE SHADOW RESIDUAL IS THE INITIAL RESIDUAL, AND HENCE THE FIRST VALUE OF rho IS ITS SUM OF SQUARES
+    rHat = rVec;
+    pVec = rVec;
+    rhoValue = globalSums[0];
+
+    while (residualNorm > targetNorm and cyclesUsed < inputParams.vcCount) {
+        // FIRST HALF-STEP ALONG THE PRECONDITIONED SEARCH DIRECTION. qVec HOLDS THE OPERATOR APPLIED TO IT
+        mgSolver.applyPreconditioner(pVec, pHat);
+        mgSolver.applyOperator(pHat, qVec);
+
+        localSums[0] = localDot(rHat, qVec);
+        startReduction(1, false);
+        finishReduction();
+
+        alpha = rhoValue/globalSums[0];
+        sVec = rVec - alpha*qVec;
+
+        // SECOND HALF-STEP ALONG THE PRECONDITIONED INTERMEDIATE RESIDUAL
+        mgSolver.applyPreconditioner(sVec, sHat);
+        mgSolver.applyOperator(sHat, tVec);
+
+        cyclesUsed += 2;
+
+        localSums[0] = localDot(tVec, sVec);
+        localSums[1] = localDot(tVec, tVec);
+        startReduction(2, false);
+        lhsData += alpha*pHat;
+        finishReduction();
+
+        omega = globalSums[0]/globalSums[1];
+        rVec = sVec - omega*tVec;
+
+        localSums[0] = localDot(rHat, rVec);
+        localSums[1] = localDot(rVec, rVec);
+        startReduction(2, true);
+        lhsData += omega*sHat;
+        finishReduction();
+
+        residualNorm = reducedNorm(globalSums[1]);
+
+        rhoPrev = rhoValue;
+        rhoValue = globalSums[0];
+
+        beta = (rhoValue/rhoPrev)*(alpha/omega);
+        pVec = rVec + beta*(pVec - omega*qVec);
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the inner product of two vectors over the points owned by the local sub-domain
+ *
+ *          The points shared with the neighbouring sub-domains are excluded as given by \ref poisson#ownedCore "ownedCore",
+ *          so that the sum of the local values over all sub-domains counts every grid point exactly once.
+ *
+ * \param   aVec is a const reference to the first vector of the inner product
+ * \param   bVec is a const reference to the second vector of the inner product
+ *
+ * \return  The real value of the local contribution to the inner product
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+real krylov<mgReal>::localDot(const blitz::Array<real, 3> &aVec, const blitz::Array<real, 3> &bVec) {
+    return blitz::sum(aVec(uniqCore)*bVec(uniqCore));
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to start the non-blocking reduction of the local inner products
+ *
+ *          The first sumCount values of the localSums array are added across all sub-domains in a single non-blocking reduction,
+ *          the results of which are available in globalSums after \ref finishReduction is called.
+ *          When the maximum norm of the residual is being used, it cannot be combined with the sums, and is reduced by a
+ *          second non-blocking reduction that proceeds alongside the first one.
+ *
+ * \param   sumCount is the integer value of the number of inner products to be reduced
+ * \param   withNorm is the boolean flag which is true when the norm of rVec is also needed
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void krylov<mgReal>::startReduction(const int sumCount, const bool withNorm) {
+    MPI_Iallreduce(localSums, globalSums, sumCount, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD, &reduceRequest[0]);
+
+    reduceRequest[1] = MPI_REQUEST_NULL;
+    if (withNorm and inputParams.normType == 1) {
+        localMax = blitz::max(fabs(rVec(uniqCore)));
+
+        MPI_Iallreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD, &reduceRequest[1]);
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to wait for the reductions started by \ref startReduction to complete
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void krylov<mgReal>::finishReduction() {
+    MPI_Waitall(2, reduceRequest, MPI_STATUSES_IGNORE);
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to get the norm of the residual from the completed reductions
+ *
+ *          Depending on the \ref parser#normType "normType" parameter, the norm is either the root-mean-square value computed
+ *          from the sum of squares, or the maximum absolute value reduced alongside it.
+ *
+ * \param   sumSquares is the real value of the sum of squares of the residual over all the grid points
+ *
+ * \return  The real value of the norm of the residual
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+real krylov<mgReal>::reducedNorm(const real sumSquares) {
+    if (inputParams.normType == 1) return globalMax;
+
+    return sqrt(sumSquares/pointCount);
+}
+
+template class krylov<float>;
+template class krylov<double>;
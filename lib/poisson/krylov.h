@@ -0,0 +1,69 @@
+#ifndef KRYLOV_H
+#define KRYLOV_H
+
+#include <blitz/array.h>
+#include <math.h>
+
+#include "poisson.h"
+
+template <typename mgReal>
+class krylov {
+    private:
+        real pointCount;
+        real targetNorm;
+
+        real localSums[3], globalSums[3];
+        real localMax, globalMax;
+
+        const grid &mesh;
+        const parser &inputParams;
+
+        poisson<mgReal> &mgSolver;
+
+        blitz::RectDomain<3> uniqCore;
+
+        blitz::Array<real, 3> lhsData, rhsData;
+        blitz::Array<real, 3> rVec, rOld, rHat;
+        blitz::Array<real, 3> pVec, pHat, qVec;
+        blitz::Array<real, 3> sVec, sHat, tVec;
+
+        MPI_Request reduceRequest[2];
+
+        void pcgSolve();
+        void bicgSolve();
+
+        real localDot(const blitz::Array<real, 3> &aVec, const blitz::Array<real, 3> &bVec);
+
+        void startReduction(const int sumCount, const bool withNorm);
+        void finishReduction();
+
+        real reducedNorm(const real sumSquares);
+
+    public:
+        int cyclesUsed;
+        real residualNorm;
+
+        krylov(const grid &mesh, const parser &solParam, poisson<mgReal> &mgSolver);
+
+        void krylovSolve(plainsf<real> &inFn, const plainsf<real> &rhs);
+
+        ~krylov() {};
+};
+
+/**
+ ********************************************************************************************************************************************
+ *  \class krylov krylov.h "lib/poisson/krylov.h"
+ *  \brief The class krylov accelerates the multi-grid solver with a Krylov subspace method
+ *
+ *  The class solves the Poisson equation with either the preconditioned conjugate gradient (CG) method or the BiCGStab method,
+ *  using one cycle of the multi-grid solver held by the \ref poisson class as the preconditioner.
+ *  Since the first derivative terms of the stretched grid make the discrete operator non-symmetric, BiCGStab is the more robust
+ *  choice on stretched grids, while CG needs fewer operations per iteration on uniform grids.
+ *  The class is templated on the scalar type of the multi-grid levels used by the preconditioner, while the Krylov vectors are
+ *  always held in the precision of the fields.
+ *  The inner products needed in each iteration are combined into as few reductions as possible, and these are performed
+ *  with non-blocking collectives so that the vector updates proceed while the reductions are in progress.
+ ********************************************************************************************************************************************
+ */
+
+#endif
@@ -7,8 +7,9 @@
  *          The short base constructor of the poisson class merely assigns the const references to the grid and parser
  *          class instances being used in the solver.
  *          Moreover, it resizes and populates a local array of multi-grid sizes as used in the grid class.
- *          An array of strides to be used at different V-cycle levels is also generated and stored.
- *          Finally, the maximum allowable number of iterations for the Jacobi iterative solver being used at the
+ *          The strides to be used at different V-cycle levels depend on the sizes of the local sub-domains, and are hence set
+ *          later by \ref setStrides, which is called from the constructors of the derived classes.
+ *          Finally, the maximum allowable number of iterations for the iterative solver being used at the
  *          coarsest mesh is set as \f$ N_{max} = N_x \times N_y \times N_z \f$, where \f$N_x\f$, \f$N_y\f$ and \f$N_z\f$
  *          are the number of grid points in the collocated grid at the local sub-domains along x, y and z directions
  *          respectively.
@@ -17,7 +18,8 @@
  * \param   solParam is a const reference to the user-set parameters contained in the parser class
  ********************************************************************************************************************************************
  */
-poisson::poisson(const grid &mesh, const parser &solParam): mesh(mesh), inputParams(solParam) {
+template <typename mgReal>
+poisson<mgReal>::poisson(const grid &mesh, const parser &solParam): mesh(mesh), inputParams(solParam) {
     int maxIndex = 15;
 
     mgSizeArray.resize(maxIndex);
@@ -27,51 +29,352 @@ poisson::poisson(const grid &mesh, const parser &solParam): mesh(mesh), inputPar
 
     mgSizeArray(0) = 1;
 
-    strideValues.resize(inputParams.vcDepth + 1);
-    for (int i=0; i<=inputParams.vcDepth; i++) {
-        strideValues(i) = int(pow(2, i));
-    }
-
     vLevel = 0;
+    fineLevel = 0;
     maxCount = mesh.collocCoreSize(0)*mesh.collocCoreSize(1)*mesh.collocCoreSize(2);
 
+    cyclesUsed = 0;
+    residualNorm = 0.0;
+
+    // THE CYCLES COMPUTE CORRECTIONS TO A SOLUTION HELD SEPARATELY WHEN THE LEVELS ARE STORED IN LOWER PRECISION THAN THE FIELDS
+    mixedPrecision = sizeof(mgReal) < sizeof(real);
+
+    mgDataType = (sizeof(mgReal) == sizeof(float))? MPI_FLOAT: MPI_DOUBLE;
+
+    // THE DIRECT SOLVER MAY STILL BE REPLACED BY THE ITERATIVE ONE IN factorCoarseSystem IF THE COARSEST LEVEL IS TOO LARGE FOR IT
+    directCoarse = (inputParams.coarseSolver == 1);
+
 #ifdef TIME_RUN
     solveTimeComp = 0.0;
     solveTimeTran = 0.0;
     smothTimeComp = 0.0;
     smothTimeTran = 0.0;
+    padsTimePack = 0.0;
 #endif
 }
 
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the strides of all the levels of the V-cycle along each direction
+ *
+ *          The stride of a level along a direction is the number of intervals of the finest level spanned by one interval of
+ *          that level.
+ *          With full coarsening, the stride along every direction is doubled from one level to the next.
+ *          With semi-coarsening, the directions to be coarsened are chosen anew at each level, based on the physical grid spacing.
+ *          The smallest and largest spacings along each direction at the finest level are computed from the grid metrics over the
+ *          entire domain, so that all the sub-domains coarsen the same directions.
+ *          Since the grid is a tensor product of 1D grids, a direction has a spacing less than twice that of every other direction
+ *          at all the points of the grid only if its largest spacing is less than twice the smallest spacing of each of the others.
+ *          Among the directions whose sub-domains still have at least 4 intervals, only those which are the finest in this sense
+ *          everywhere are coarsened.
+ *          Hence a direction which is much finer than the others throughout the domain is coarsened alone till its spacing becomes
+ *          comparable to theirs, after which all of them are coarsened together as in full coarsening.
+ *          If no direction is the finest everywhere, as on a grid stretched along one direction only, where the stretched direction
+ *          is the finest near the walls and the coarsest elsewhere, all the directions are coarsened together as in full coarsening.
+ *          Moreover, once the sub-domains cannot be coarsened further along X and Y, the remaining levels coarsen Z alone.
+ *          The function must be called after the \ref localSizeIndex has been set.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::setStrides() {
+    int cellCount;
+    bool finestFound;
+    real localSpacing[6], dirSpacing[6];
+
+    blitz::TinyVector<bool, 3> coarsenDir, finestDir;
+
+    strideValues.resize(inputParams.vcDepth + 1, 3);
+    strideValues = 1;
+
+    // SMALLEST AND LARGEST PHYSICAL GRID SPACINGS ALONG EACH DIRECTION. THE LARGEST ONES ARE NEGATED SO THAT ALL ARE REDUCED WITH MPI_MIN
+    // THE Y-DIRECTION HAS NO INTERVALS IN 2D SIMULATIONS, AND IS NEVER COARSENED
+    localSpacing[0] = mesh.dXi/blitz::max(mesh.xi_xStaggr(blitz::Range(0, mgSizeArray(localSizeIndex(0)) - 1)));
+    localSpacing[1] = (localSizeIndex(1) > 0)? mesh.dEt/blitz::max(mesh.et_yStaggr(blitz::Range(0, mgSizeArray(localSizeIndex(1)) - 1))): 0.0;
+    localSpacing[2] = mesh.dZt/blitz::max(mesh.zt_zStaggr(blitz::Range(0, mgSizeArray(localSizeIndex(2)) - 1)));
+
+    localSpacing[3] = -mesh.dXi/blitz::min(mesh.xi_xStaggr(blitz::Range(0, mgSizeArray(localSizeIndex(0)) - 1)));
+    localSpacing[4] = (localSizeIndex(1) > 0)? -mesh.dEt/blitz::min(mesh.et_yStaggr(blitz::Range(0, mgSizeArray(localSizeIndex(1)) - 1))): 0.0;
+    localSpacing[5] = -mesh.dZt/blitz::min(mesh.zt_zStaggr(blitz::Range(0, mgSizeArray(localSizeIndex(2)) - 1)));
+
+    MPI_Allreduce(localSpacing, dirSpacing, 6, MPI_FP_REAL, MPI_MIN, MPI_COMM_WORLD);
+
+    for (int i=1; i<=inputParams.vcDepth; i++) {
+        // A DIRECTION CAN BE COARSENED ONLY IF THE SUB-DOMAINS HAVE AT LEAST 4 INTERVALS ALONG IT AT THE PREVIOUS LEVEL
+        for (int j=0; j<3; j++) {
+            cellCount = (mgSizeArray(localSizeIndex(j)) - 1)/strideValues(i - 1, j);
+            coarsenDir(j) = (cellCount >= 4);
+        }
+
+        // WITH SEMI-COARSENING, A DIRECTION IS THE FINEST EVERYWHERE IF ITS LARGEST SPACING IS LESS THAN TWICE THE SMALLEST SPACING OF
+        // EVERY OTHER DIRECTION WHICH CAN BE COARSENED. IF NO DIRECTION IS, ALL THE DIRECTIONS WHICH CAN BE COARSENED ARE COARSENED
+        if (inputParams.coarsenType == 1) {
+            finestFound = false;
+            for (int j=0; j<3; j++) {
+                finestDir(j) = coarsenDir(j);
+                for (int k=0; k<3; k++) {
+                    if (k != j and coarsenDir(k) and strideValues(i - 1, j)*(-dirSpacing[j + 3]) >= 2.0*strideValues(i - 1, k)*dirSpacing[k]) {
+                        finestDir(j) = false;
+                    }
+                }
+                finestFound = finestFound or finestDir(j);
+            }
+
+            if (finestFound) coarsenDir = finestDir;
+        }
+
+        for (int j=0; j<3; j++) {
+            strideValues(i, j) = coarsenDir(j)? 2*strideValues(i - 1, j): strideValues(i - 1, j);
+        }
+    }
+}
+
 /**
  ********************************************************************************************************************************************
  * \brief   Function to initialize the arrays used in multi-grid
  *
  *          The memory required for various arrays in multi-grid solver are pre-allocated through this function.
  *          The function is called from within the constructor to perform this allocation once and for all.
+ *          The arrays \ref pressureData, \ref residualData, \ref smoothedPres and \ref inputRHSData are allocated separately
+ *          for each level of the V-cycle, using the limits in \ref stagFull for the corresponding level.
+ *          The coarser levels of \ref inputRHSData are used only to hold the restricted RHS during full multi-grid.
  *          The arrays are initialized to 0.
  ********************************************************************************************************************************************
  */
-void poisson::initializeArrays() {
-    pressureData.resize(blitz::TinyVector<int, 3>(stagFull.ubound() - stagFull.lbound() + 1));
-    pressureData.reindexSelf(stagFull.lbound());
-    pressureData = 0.0;
+template <typename mgReal>
+void poisson<mgReal>::initializeArrays() {
+    pressureData.resize(inputParams.vcDepth + 1);
+    residualData.resize(inputParams.vcDepth + 1);
+    smoothedPres.resize(inputParams.vcDepth + 1);
+    inputRHSData.resize(inputParams.vcDepth + 1);
+
+    for (int i=0; i<=inputParams.vcDepth; i++) {
+        pressureData(i).resize(blitz::TinyVector<int, 3>(stagFull(i).ubound() - stagFull(i).lbound() + 1));
+        pressureData(i).reindexSelf(stagFull(i).lbound());
+        pressureData(i) = 0.0;
+
+        residualData(i).resize(blitz::TinyVector<int, 3>(stagFull(i).ubound() - stagFull(i).lbound() + 1));
+        residualData(i).reindexSelf(stagFull(i).lbound());
+        residualData(i) = 0.0;
+
+        smoothedPres(i).resize(blitz::TinyVector<int, 3>(stagFull(i).ubound() - stagFull(i).lbound() + 1));
+        smoothedPres(i).reindexSelf(stagFull(i).lbound());
+        smoothedPres(i) = 0.0;
+
+        inputRHSData(i).resize(blitz::TinyVector<int, 3>(stagFull(i).ubound() - stagFull(i).lbound() + 1));
+        inputRHSData(i).reindexSelf(stagFull(i).lbound());
+        inputRHSData(i) = 0.0;
+    }
+
+    // WITH MIXED PRECISION, THE SOLUTION, ALONG WITH ITS RHS AND RESIDUAL, IS HELD IN THE PRECISION OF THE FIELDS AT THE FINEST LEVEL
+    if (mixedPrecision) {
+        fineSolution.resize(blitz::TinyVector<int, 3>(stagFull(0).ubound() - stagFull(0).lbound() + 1));
+        fineSolution.reindexSelf(stagFull(0).lbound());
+        fineSolution = 0.0;
+
+        fineRHS.resize(blitz::TinyVector<int, 3>(stagFull(0).ubound() - stagFull(0).lbound() + 1));
+        fineRHS.reindexSelf(stagFull(0).lbound());
+        fineRHS = 0.0;
+
+        fineResidual.resize(blitz::TinyVector<int, 3>(stagFull(0).ubound() - stagFull(0).lbound() + 1));
+        fineResidual.reindexSelf(stagFull(0).lbound());
+        fineResidual = 0.0;
+    }
+
+    setMeanWeights();
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to set the weights used to compute the mean of a field at all the levels of the V-cycle
+ *
+ *          Since the boundary conditions are either periodic or Neumann, the operator is singular, and the RHS is compatible only
+ *          when its weighted sum vanishes, with the weights given by the left null vector of the operator.
+ *          For the Laplacian in the transformed plane, this vector is approximated by the volume of the grid cell around each
+ *          point, which is the product of the inverse grid metrics along the three directions.
+ *          At the points lying on a non-periodic wall, where the Neumann condition folds the pad into its mirror point, only half
+ *          the cell lies within the domain, and the weight is halved.
+ *          The weights are stored separately for each direction, and are exact for uniform grids.
+ *          The function must be called after the grid metrics of all the levels have been copied by \ref copyStaggrDerivs.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::setMeanWeights() {
+    xWeight.resize(inputParams.vcDepth + 1, stagFull(0).ubound(0) - stagFull(0).lbound(0) + 1);
+    xWeight.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(0)));
+    xWeight = 0.0;
+
+    yWeight.resize(inputParams.vcDepth + 1, stagFull(0).ubound(1) - stagFull(0).lbound(1) + 1);
+    yWeight.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(1)));
+    yWeight = 0.0;
+
+    zWeight.resize(inputParams.vcDepth + 1, stagFull(0).ubound(2) - stagFull(0).lbound(2) + 1);
+    zWeight.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(2)));
+    zWeight = 0.0;
+
+    for (int i=0; i<=inputParams.vcDepth; i++) {
+        for (int iX = 0; iX <= stagCore(i).ubound(0); iX++) {
+            xWeight(i, iX) = 1.0/sqrt(xix2(i, iX));
+        }
+        if (not inputParams.xPer and mesh.rankData.xRank == 0) xWeight(i, 0) *= 0.5;
+        if (not inputParams.xPer and mesh.rankData.xRank == mesh.rankData.npX - 1) xWeight(i, stagCore(i).ubound(0)) *= 0.5;
+
+        // IN 2D, THE GRID HAS A SINGLE POINT ALONG Y, AND THE METRICS ALONG Y ARE NOT USED
+        if (stagCore(i).ubound(1) == 0) {
+            yWeight(i, 0) = 1.0;
+        } else {
+            for (int iY = 0; iY <= stagCore(i).ubound(1); iY++) {
+                yWeight(i, iY) = 1.0/sqrt(ety2(i, iY));
+            }
+            if (not inputParams.yPer and mesh.rankData.yRank == 0) yWeight(i, 0) *= 0.5;
+            if (not inputParams.yPer and mesh.rankData.yRank == mesh.rankData.npY - 1) yWeight(i, stagCore(i).ubound(1)) *= 0.5;
+        }
+
+        for (int iZ = 0; iZ <= stagCore(i).ubound(2); iZ++) {
+            zWeight(i, iZ) = 1.0/sqrt(ztz2(i, iZ));
+        }
+        if (not inputParams.zPer) {
+            zWeight(i, 0) *= 0.5;
+            zWeight(i, stagCore(i).ubound(2)) *= 0.5;
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to copy the coefficients of the Laplacian at the points of the deep pads from the neighbouring sub-domains
+ *
+ *          At the levels using deep pads, the points of the pads are relaxed along with the sub-domain, and the coefficients of the
+ *          Laplacian along X and Y are needed at these points as well.
+ *          These are the coefficients of the neighbouring sub-domains at the points lying within \ref parser#haloDepth "haloDepth"
+ *          points of the common boundary, and are transferred once when the solver is created.
+ *          Since the neighbouring sub-domains share their boundary points, the points 1 to haloDepth are sent to the pads
+ *          beyond the upper end of the neighbour on the lower side, and the points N - haloDepth to N - 1 are sent to the pads
+ *          below the lower end of the neighbour on the upper side.
+ *          The pads facing a wall are left unchanged, since they are never relaxed.
+ *
+ * \param   coeffData is a reference to the 2D array of coefficients, indexed by the level and the index along the direction
+ * \param   level is the integer value of the level whose coefficients are transferred
+ * \param   coreEnd is the integer value of the last index of the core along the direction at the given level
+ * \param   lftRank is the integer value of the rank of the neighbour on the lower side along the direction
+ * \param   rgtRank is the integer value of the rank of the neighbour on the upper side along the direction
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::shareCoefficients(blitz::Array<mgReal, 2> &coeffData, const int level, const int coreEnd, const int lftRank, const int rgtRank) {
+    int hDepth = inputParams.haloDepth;
+
+    MPI_Sendrecv(&coeffData(level, 1), hDepth, mgDataType, lftRank, 1,
+                 &coeffData(level, coreEnd + 1), hDepth, mgDataType, rgtRank, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    MPI_Sendrecv(&coeffData(level, coreEnd - hDepth), hDepth, mgDataType, rgtRank, 2,
+                 &coeffData(level, -hDepth), hDepth, mgDataType, lftRank, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to find the position within the packed buffer of a face at which the points of a line start
+ *
+ *          The faces of the sub-domain transferred during red-black smoothing lie at odd indices, and are made of lines along Z,
+ *          each of which has zEnd + 1 points.
+ *          Hence the points of a given colour on the first line start at the index (1 + colour) % 2 along Z, and on the subsequent
+ *          lines they alternately start at the other index.
+ *          Since zEnd is even, any two consecutive lines together hold zEnd + 1 points of each colour.
+ *          When lineIndex is the number of lines of the face, the function returns the size of the packed buffer.
+ *
+ * \param   level is the integer value of the level of the V-cycle
+ * \param   lineIndex is the integer value of the index of the line within the face
+ * \param   colour is the integer value of the colour being transferred - 0 for red and 1 for black
+ *
+ * \return  The integer value of the number of points of the colour lying on the lines before the given line
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+int poisson<mgReal>::faceOffset(const int level, const int lineIndex, const int colour) {
+    int firstCount;
+
+    firstCount = (zEnd(level) - (1 + colour) % 2)/2 + 1;
+
+    return (lineIndex/2)*(zEnd(level) + 1) + (lineIndex % 2)*firstCount;
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to pack the points of one colour on a face of the sub-domain into a contiguous buffer
+ *
+ *          The face is given by the position of its first point, along with the number of its lines along Z and the distance
+ *          between the starting points of consecutive lines within the array.
+ *          The lines are packed one after the other by multiple threads, each at the position given by \ref faceOffset.
+ *
+ * \param   faceData is a pointer to the first point of the face within the array at the current level of the V-cycle
+ * \param   lineStride is the distance between the starting points of consecutive lines of the face
+ * \param   lineCount is the integer value of the number of lines of the face
+ * \param   colour is the integer value of the colour being transferred - 0 for red and 1 for black
+ * \param   bufferData is a pointer to the buffer into which the points are packed
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::packFace(const mgReal *faceData, const long lineStride, const int lineCount, const int colour, mgReal *bufferData) {
+#ifdef TIME_RUN
+    struct timeval begin, end;
+    gettimeofday(&begin, NULL);
+#endif
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(faceData, bufferData) firstprivate(lineStride, lineCount, colour)
+    for (int iLine = 0; iLine < lineCount; iLine++) {
+        int zStart = (1 + iLine + colour) % 2;
+
+        const mgReal *lineData = faceData + iLine*lineStride;
+        mgReal *packData = bufferData + faceOffset(vLevel, iLine, colour);
+
+#pragma omp simd
+        for (int iZ = zStart; iZ <= zEnd(vLevel); iZ += 2) {
+            packData[(iZ - zStart)/2] = lineData[iZ];
+        }
+    }
+
+#ifdef TIME_RUN
+    gettimeofday(&end, NULL);
+    padsTimePack += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+#endif
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to unpack a contiguous buffer into the points of one colour on a pad of the sub-domain
+ *
+ *          This function performs the reverse operation of \ref packFace, and the pad is given in the same manner as the face.
+ *
+ * \param   bufferData is a pointer to the buffer from which the points are unpacked
+ * \param   lineStride is the distance between the starting points of consecutive lines of the pad
+ * \param   lineCount is the integer value of the number of lines of the pad
+ * \param   colour is the integer value of the colour being transferred - 0 for red and 1 for black
+ * \param   faceData is a pointer to the first point of the pad within the array at the current level of the V-cycle
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::unpackFace(const mgReal *bufferData, const long lineStride, const int lineCount, const int colour, mgReal *faceData) {
+#ifdef TIME_RUN
+    struct timeval begin, end;
+    gettimeofday(&begin, NULL);
+#endif
 
-    smoothedPres.resize(blitz::TinyVector<int, 3>(stagFull.ubound() - stagFull.lbound() + 1));
-    smoothedPres.reindexSelf(stagFull.lbound());
-    smoothedPres = 0.0;
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(faceData, bufferData) firstprivate(lineStride, lineCount, colour)
+    for (int iLine = 0; iLine < lineCount; iLine++) {
+        int zStart = (1 + iLine + colour) % 2;
 
-    iteratorTemp.resize(blitz::TinyVector<int, 3>(stagFull.ubound() - stagFull.lbound() + 1));
-    iteratorTemp.reindexSelf(stagFull.lbound());
-    iteratorTemp = 0.0;
+        mgReal *lineData = faceData + iLine*lineStride;
+        const mgReal *packData = bufferData + faceOffset(vLevel, iLine, colour);
 
-    inputRHSData.resize(blitz::TinyVector<int, 3>(stagFull.ubound() - stagFull.lbound() + 1));
-    inputRHSData.reindexSelf(stagFull.lbound());
-    inputRHSData = 0.0;
+#pragma omp simd
+        for (int iZ = zStart; iZ <= zEnd(vLevel); iZ += 2) {
+            lineData[iZ] = packData[(iZ - zStart)/2];
+        }
+    }
 
-    residualData.resize(blitz::TinyVector<int, 3>(stagFull.ubound() - stagFull.lbound() + 1));
-    residualData.reindexSelf(stagFull.lbound());
-    residualData = 0.0;
+#ifdef TIME_RUN
+    gettimeofday(&end, NULL);
+    padsTimePack += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+#endif
 }
 
 /**
@@ -79,37 +382,149 @@ void poisson::initializeArrays() {
  * \brief   Function to solve the poisson equation at the coarsest multi-grid level
  *
  *          This function operates exclusively at the lowest level of the multi-grid V-cycle.
- *          It uses the Jacobi iterative solver to solve the residual of the Poisson equation on the coarsest mesh.
+ *          It uses the red-black Gauss-Seidel iterative solver to solve the residual of the Poisson equation on the coarsest mesh.
+ *          When the direct solver is selected through the \ref parser#coarseSolver "coarseSolver" parameter, it instead calls
+ *          \ref directSolve, which uses the LU factors of the coarsest level matrix computed at initialization, unless the coarsest
+ *          level was too large for them to be computed.
+ *          With the red-black point smoother, the pads of the red points are transferred while the black points away from the
+ *          sub-domain boundaries are being relaxed, as described in \ref smooth.
+ *          The convergence is checked once every \ref parser#checkInterval "checkInterval" iterations, and the maximum of the
+ *          residual over all the sub-domains is reduced with a non-blocking collective whose result is read after the next iteration.
+ *          With the red-black point smoother, the residual is found within the sweeps themselves, so that it lags by one iteration.
  *          Note that the all calculations are performed assuming that the \ref vLevel variable is maximal when the function
  *          is being called.
  ********************************************************************************************************************************************
  */
-void poisson::solve() { };
+template <typename mgReal>
+void poisson<mgReal>::solve() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to perform restriction on the residual array
+ *
+ *          Restriction makes the grid coarser by transferring the residual at the current level onto the next coarser level.
+ *          As a result, the number of points in the domain decreases from \f$ 2^{N+1} + 1 \f$ at the input level to \f$ 2^N + 1 \f$
+ *          along each of the directions being coarsened, as given by the ratio of the \ref strideValues of the two levels.
+ *          Along the other directions, which are left as they are when using semi-coarsening, the weights of full-weighting reduce to 1.
+ *          Depending on the \ref parser#restrictOp "restrictOp" parameter, the residual is either directly injected from the coincident
+ *          points of the finer level, or computed as a weighted average of the neighbouring points using full-weighting.
+ *          The vLevel variable is accordingly increased by 1 to reflect this descent by one step down the V-Cycle.
+ *          The array \ref pressureData at the coarser level is reset to 0 as it serves as the initial guess for the correction.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::coarsen() { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to perform prolongation on the array being solved
  *
  *          Prolongation makes the grid finer by averaging values at two adjacent nodes onto an intermediate point between them
- *          As a result, the number of points in the domain increases from \f$ 2^N + 1 \f$ at the input level to \f$ 2^{N+1} + 1 \f$.
+ *          As a result, the number of points in the domain increases from \f$ 2^N + 1 \f$ at the input level to \f$ 2^{N+1} + 1 \f$
+ *          along each of the directions which were coarsened during restriction, and the interpolation is performed only along these.
+ *          When the Galerkin coarse grid operator is used, the interpolation is operator-dependent, i.e., each new point of the
+ *          finer level is computed such that the operator of that level, collapsed onto the directions along which the point lies
+ *          between coarse points, is satisfied by the interpolated values.
+ *          This follows the jumps in the coefficients of the operator much better than linear interpolation.
+ *          Only the correction held in \ref pressureData is interpolated.
+ *          The residual at the finer level is left as it was restricted, since it serves as the RHS for the smoothing at that level.
  *          The vLevel variable is accordingly reduced by 1 to reflect this ascent by one step up the V-Cycle.
  ********************************************************************************************************************************************
  */
-void poisson::prolong() { };
+template <typename mgReal>
+void poisson<mgReal>::prolong() { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to perform smoothing operation on the input array
  *
  *          The smoothing operation is always performed on the data contained in the array \ref pressureData.
- *          The array \ref iteratorTemp is used to store the temporary data and it is continuously swapped with the
- *          \ref pressureData array at every iteration.
+ *          Each smoothing iteration consists of one red-black Gauss-Seidel sweep, performed by the \ref gsSweep function, or one
+ *          zebra line Gauss-Seidel sweep, performed by the \ref lineSweep function, as specified by the
+ *          \ref parser#smoothType "smoothType" parameter.
+ *          The pads of each colour are updated right after the points of that colour are relaxed.
+ *          With the red-black point smoother, this update is started by \ref beginPadUpdate, and the points of the next colour
+ *          which lie away from the faces of the sub-domain along X and Y are relaxed while the pads are being transferred.
+ *          The points on these faces are relaxed only after the transfer is completed by \ref finishPadUpdate.
+ *          At the levels using the Galerkin coarse grid operator, whose stencil couples the diagonal neighbours as well, the
+ *          points are relaxed in 8 colours (or the lines in 4 colours), and all the pads are updated after each colour.
+ *          When the \ref parser#sweepBlock "sweepBlock" parameter exceeds 1, consecutive point smoothing sweeps at the other levels
+ *          are fused in blocks of that many sweeps by \ref blockSweep, and all the pads are updated after each block.
  *          This operation can be performed at any level of the V-cycle.
  *
  * \param   smoothCount is the integer value of the number of smoothing iterations to be performed
  ********************************************************************************************************************************************
  */
-void poisson::smooth(const int smoothCount) { };
+template <typename mgReal>
+void poisson<mgReal>::smooth(const int smoothCount) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to relax the points of one colour of the red-black ordering in place
+ *
+ *          The points of the grid are coloured red or black depending on whether the sum of their indices is even or odd.
+ *          Since the local sub-domains always have an even number of intervals, this colouring is consistent across sub-domains.
+ *          The points of one colour depend only on the points of the other colour, so that all the points of a colour can be
+ *          updated in place within \ref pressureData by multiple threads without any data race.
+ *          The Gauss-Seidel update is over-relaxed with the \ref parser#sorParam "sorParam" parameter.
+ *          At the levels using the Galerkin coarse grid operator, the colour is instead given by the parities of the three indices.
+ *
+ * \param   colour is the integer value of the colour being relaxed - 0 for red and 1 for black points (0 to 7 with Galerkin operators)
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::gsSweep(const int colour) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to relax the lines along Z-direction of one colour of the zebra ordering in place
+ *
+ *          Since the grid is never decomposed along Z-direction, each sub-domain holds complete lines of points along Z.
+ *          The lines are coloured red or black depending on whether the sum of their X and Y indices is even or odd, so that the
+ *          lines of one colour depend only on the lines of the other colour.
+ *          All the points along each line are updated together by solving the tridiagonal system formed by the Z-derivative
+ *          terms of the Laplacian, with the terms along X and Y taken from the current values of the neighbouring lines.
+ *          This makes the smoother robust when the coupling along Z is much stronger than along X and Y, as happens on grids
+ *          that are strongly stretched or refined along Z.
+ *          The Gauss-Seidel update of each line is over-relaxed with the \ref parser#sorParam "sorParam" parameter.
+ *          At the levels using the Galerkin coarse grid operator in 3D, the colour of a line is instead given by the parities of its
+ *          X and Y indices.
+ *          When asked for by the iterative solver at the coarsest level, the largest residual at the points of the lines is found
+ *          from the tridiagonal system of each line before it is solved, so that no separate pass is needed to check convergence.
+ *
+ * \param   colour is the integer value of the colour being relaxed - 0 for red and 1 for black lines (0 to 3 with Galerkin operators)
+ * \param   findError is the boolean flag which is true if the largest residual at the points of the lines has to be found
+ *
+ * \return  The real value of the largest absolute residual at the points of the lines before they were relaxed, or 0 if not asked for
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+real poisson<mgReal>::lineSweep(const int colour, const bool findError) { return 0; };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to perform several red-black Gauss-Seidel sweeps in a single pass over the level
+ *
+ *          Each sweep streams the entire level through memory twice, once for each colour, and at the finer levels this traffic
+ *          limits the speed of the smoother.
+ *          Here the 2 x sweepCount half-sweeps of the block are instead performed together as a wavefront moving along X.
+ *          At each step of the wavefront, the half-sweep h relaxes the plane of constant X lying h planes behind the front, so that
+ *          the planes it reads have already been relaxed by the half-sweep h - 1.
+ *          Only about 2 x sweepCount planes are active at any step, and they remain in cache while they are relaxed repeatedly.
+ *          Within the sub-domain, the result is the same as that of sweepCount sweeps performed one after the other.
+ *          The pads received from the neighbouring sub-domains are however updated only by the caller after the block, while the
+ *          remaining pads of each plane are updated by \ref imposePlaneBC as soon as the plane is relaxed.
+ *          At the levels listed in \ref haloLevel, these pads are instead deep enough to hold all the points which affect the
+ *          sub-domain during the block.
+ *          The points of the deep pads are then relaxed along with the sub-domain, with each half-sweep relaxing one layer less
+ *          than the previous one, since the outermost layer it reads has not been relaxed.
+ *          The result is then the same as that of the unfused sweeps across the sub-domains as well.
+ *
+ * \param   sweepCount is the integer value of the number of red-black sweeps fused in the block
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::blockSweep(const int sweepCount) { };
 
 /**
  ********************************************************************************************************************************************
@@ -117,18 +532,25 @@ void poisson::smooth(const int smoothCount) { };
  *
  *          The Range objects defined here are used for reading the values of grid metrics at all the V-cycle levels.
  *          Since these values are required at all the grid levels, there are \ref parser#vcDepth "vcDepth" + 1 number of Range objects.
+ *          The upper limits of the loops over the core of each level are also set here.
  ********************************************************************************************************************************************
  */
-void poisson::initMeshRanges() { };
+template <typename mgReal>
+void poisson<mgReal>::initMeshRanges() { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to set the RectDomain variables for all future references throughout the poisson solver
  *
- *          The function sets the core and full domain staggered grid sizes for all the sub-domains.
+ *          The function sets the core and full domain staggered grid sizes for all the sub-domains at every level of the V-cycle.
+ *          The pads of the full domain along X and Y are \ref parser#haloDepth "haloDepth" points wide at all the levels.
+ *          This is 1 for single pads, and 2 x \ref parser#sweepBlock "sweepBlock" when the deep pads used by the fused red-black
+ *          sweeps are asked for, although the deep pads are exchanged only at the levels marked in \ref haloLevel.
+ *          Along Z, which is never decomposed, the pads are always one point wide.
  ********************************************************************************************************************************************
  */
-void poisson::setStagBounds() { };
+template <typename mgReal>
+void poisson<mgReal>::setStagBounds() { };
 
 /**
  ********************************************************************************************************************************************
@@ -141,7 +563,8 @@ void poisson::setStagBounds() { };
  *          where \f$ np \f$ is the number of processors along the direction under consideration.
  ********************************************************************************************************************************************
  */
-void poisson::setLocalSizeIndex() { };
+template <typename mgReal>
+void poisson<mgReal>::setLocalSizeIndex() { };
 
 /**
  ********************************************************************************************************************************************
@@ -151,86 +574,1069 @@ void poisson::setLocalSizeIndex() { };
  *          These coefficients are repeatedly used at many places in the Poisson solver.
  ********************************************************************************************************************************************
  */
-void poisson::setCoefficients() { };
+template <typename mgReal>
+void poisson<mgReal>::setCoefficients() { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to copy the staggered grid derivatives from the grid class to local arrays
  *
  *          Though the grid derivatives in the grid class can be read and accessed, they cannot be used directly
- *          along with the arrays defined in the poisson class as the local arrays have wide pads on both sides.
- *          Therefore, correspondingly wide arrays for grid derivatives are used, into which the staggered grid
- *          derivatives from the grid class are written and stored.
+ *          along with the arrays defined in the poisson class, as the coarser levels of the V-cycle use only every
+ *          \f$ 2^{vLevel} \f$-th point of the grid.
+ *          Therefore, the grid derivatives at the points of each level are copied into a separate row of 2D arrays,
+ *          which are indexed by the level and the local index of the point within that level.
  *          This function serves this purpose of copying the grid derivatives.
  ********************************************************************************************************************************************
  */
-void poisson::copyStaggrDerivs() { };
+template <typename mgReal>
+void poisson<mgReal>::copyStaggrDerivs() { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to impose the boundary conditions of Poisson solver at different levels of the V-cycle
  *
- *          This function is called mainly during smoothing operations to impose the boundary conditions for the
- *          Poisson equation.
+ *          This function is called during smoothing operations, and by the iterative solver at the coarsest level, to impose the
+ *          boundary conditions for the Poisson equation.
  *          The sub-domains close to the wall will have the Neumann boundary condition on pressure imposeed at the walls.
  *          Meanwhile at the interior boundaries at the inter-processor sub-domains, data is transferred from the neighbouring cells
  *          by calling the \ref updatePads function.
+ *          The boundary conditions are imposed on the pads along the edges and corners of the sub-domain as well, so that the
+ *          array can also be used with the 27-point full-weighting restriction operator.
+ *          During red-black smoothing, only the pad points of the colour that was just relaxed are transferred across sub-domains.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose pads have to be updated
+ * \param   colour is the integer value of the points to be transferred - 0 for red, 1 for black, 2 for all points and 3 for all
+ *          the points of the deep pads
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::imposeBC(blitz::Array<mgReal, 3> &data, const int colour) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to impose the boundary conditions on the pads of a single plane of constant X during fused smoothing sweeps
+ *
+ *          This function is called by \ref blockSweep right after the points of a plane have been relaxed, so that the plane can
+ *          be relaxed again before the wavefront has crossed the rest of the level.
+ *          Only the boundary conditions that need no data from the neighbouring sub-domains are imposed here.
+ *          These are the Neumann or periodic conditions along Z and the Neumann conditions at the walls along Y, imposed on the
+ *          pads of the plane itself, and the Neumann conditions at the walls along X, imposed by copying the plane into the
+ *          pad plane facing it across the wall.
+ *          The pads received from the neighbouring sub-domains are left as they were at the start of the block.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose pads have to be updated
+ * \param   iX is the integer value of the index along X of the plane which was just relaxed
  ********************************************************************************************************************************************
  */
-void poisson::imposeBC() { };
+template <typename mgReal>
+void poisson<mgReal>::imposePlaneBC(blitz::Array<mgReal, 3> &data, const int iX) { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to update the pad points of the local sub-domains at different levels of the V-cycle
  *
- *          This function is called mainly during smoothing operations by the \ref imposeBC function.
- *          It is also specifically called by the \ref solve function while solving the equation at the coarsest mesh level.
+ *          This function is called during smoothing operations, and while solving the equation at the coarsest mesh level, by
+ *          the \ref imposeBC function.
  *          At the interior boundaries at the inter-processor sub-domains, data is transferred from the neighbouring cells
  *          using a combination of MPI_Irecv and MPI_Send functions.
+ *          Data along X-direction is transferred first, and the data along Y-direction is transferred afterwards along with the
+ *          X-direction pads, so that the pads along the edges of the sub-domain are also filled correctly.
+ *          When only the points of one colour are to be transferred, the MPI datatypes holding the points of that colour are used,
+ *          so that only half the data is sent across.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose pads have to be updated
+ * \param   colour is the integer value of the points to be transferred - 0 for red, 1 for black, 2 for all points and 3 for all
+ *          the points of the deep pads
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::updatePads(blitz::Array<mgReal, 3> &data, const int colour) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to update the deep pad points of the local sub-domains, used by the fused smoothing sweeps
+ *
+ *          This function is called by \ref updatePads when all the points of the deep pads are to be transferred.
+ *          At the levels listed in \ref haloLevel, the pads along X and Y are \ref parser#haloDepth "haloDepth" points deep, and
+ *          are filled with the points of the neighbouring sub-domains lying within that distance of the common boundary.
+ *          As in \ref updatePads, the data along X-direction is transferred first, and the data along Y-direction is transferred
+ *          afterwards along with the X-direction pads, so that the deep pads along the edges of the sub-domain are also filled.
+ *          Since the pads are transferred as a whole, each direction needs just one message to each neighbour.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose deep pads have to be updated
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::updateHalos(blitz::Array<mgReal, 3> &data) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to start the update of the pad points of one colour, without waiting for the transfer to complete
+ *
+ *          This function is called during red-black point smoothing in place of \ref updatePads, so that the points which do not
+ *          need the pads can be relaxed while the data is being transferred.
+ *          Unlike \ref updatePads, the data along X and Y directions is transferred at the same time, using the persistent requests
+ *          created for each level and colour in \ref createMGSubArrays.
+ *          The points of the colour on each face are first packed by \ref packFace into a contiguous buffer, which is sent as it is.
+ *          Hence the data along Y-direction is transferred without the X-direction pads, and the pads along the edges of the
+ *          sub-domain are not updated.
+ *          These are not used by the stencils of the Laplacian, which couple each point only with its neighbours along the axes.
+ *          The transfer must be completed by calling \ref finishPadUpdate before the pads or the points sent are used or modified.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose pads have to be updated
+ * \param   colour is the integer value of the points to be transferred - 0 for red and 1 for black
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::beginPadUpdate(blitz::Array<mgReal, 3> &data, const int colour) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to complete the update of the pad points started by \ref beginPadUpdate
+ *
+ *          The function waits for all the transfers started by \ref beginPadUpdate, and unpacks the received buffers into the pads
+ *          facing the neighbouring sub-domains with \ref unpackFace.
+ *          The pads facing the walls are left unchanged, and the boundary conditions there have to be imposed by calling
+ *          \ref imposeWallBC.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose pads have to be updated
+ * \param   colour is the integer value of the points being transferred - 0 for red and 1 for black
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::finishPadUpdate(blitz::Array<mgReal, 3> &data, const int colour) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to impose the boundary conditions at the walls of the domain on the pads of the local sub-domain
+ *
+ *          This function imposes the Neumann boundary conditions at the non-periodic walls, and the periodic boundary condition
+ *          along Z, which is never decomposed across processors.
+ *          It is called by \ref imposeBC after the pads have been updated, and during smoothing after the transfer started by
+ *          \ref beginPadUpdate is completed.
+ *
+ * \param   data is a reference to the array at the current level of the V-cycle whose pads have to be updated
  ********************************************************************************************************************************************
  */
-void poisson::updatePads() { };
+template <typename mgReal>
+void poisson<mgReal>::imposeWallBC(blitz::Array<mgReal, 3> &data) { };
 
 /**
  ********************************************************************************************************************************************
  * \brief   Function to create the MPI sub-array data types necessary to transfer data across sub-domains
  *
- *          The inter-domain boundaries of all the sub-domains at different V-cycle levels need data to be transfered at
- *          with different mesh strides.
+ *          The inter-domain boundaries of all the sub-domains at different V-cycle levels need data to be transfered
+ *          from the arrays of the corresponding level.
  *          The number of sub-arrays along each edge/face of the sub-domains are equal to the number of V-cycle levels.
  *          Since this data transfer has to take place at all the mesh levels including the finest mesh, there will be
  *          vcDepth + 1 elements.
+ *          For the transfers of red-black point smoothing started by \ref beginPadUpdate, the contiguous buffers of each face
+ *          and the persistent MPI requests sending and receiving them are created here for each level instead, so that no
+ *          MPI datatype is used on this path.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::createMGSubArrays() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to perform one multi-grid cycle
+ *
+ *          The cycle starts from the current level, \ref vLevel, which is the finest level of the cycle.
+ *          This is always the finest level of the grid, except during full multi-grid, where cycles are performed at the coarser
+ *          levels too, with the RHS in \ref inputRHSData at that level.
+ *          The input data contained in \ref pressureData is first smoothed at this level.
+ *          It is then corrected using the coarser levels by the \ref levelCycle function, which visits the levels as per the
+ *          cycle type (V, W or F) set by the user.
+ *          Finally, the corrected data is smoothed again at the finest level.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::vCycle() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the solution by full multi-grid (nested iteration)
+ *
+ *          The RHS of the Poisson equation is first restricted to all the coarser levels and stored in \ref inputRHSData.
+ *          The equation is solved at the coarsest level, and the solution is interpolated to the next finer level by \ref prolong.
+ *          The interpolated solution is used as the initial guess for one multi-grid cycle at that level, and this is repeated till
+ *          the finest level is reached.
+ *          A single pass of full multi-grid thus gives a solution whose error is comparable to the discretization error at
+ *          roughly the cost of one or two cycles at the finest level.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::fmgCycle() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to correct the data at the current level of the multi-grid hierarchy using the coarser levels
+ *
+ *          The function is called recursively, descending one level with each call, till the coarsest level is reached.
+ *          In each visit to the coarser levels, the residual at the current level is restricted by \ref coarsen, the correction is
+ *          computed at the coarser levels, and then transferred back by \ref prolong and smoothed.
+ *          Whenever the data at the current level is non-zero (at the finest level of the cycle, or at any level after the first visit), its
+ *          residual is computed before restriction, and the data is shifted into \ref smoothedPres so that the correction can be
+ *          added to it after prolongation.
+ *          The V-cycle visits the coarser levels once.
+ *          The W-cycle visits them twice with a W-cycle each time, whereas the F-cycle visits them first with an F-cycle and then
+ *          with a V-cycle.
+ *
+ * \param   cycleType is the integer value of the cycle to be performed - 0 for V, 1 for W and 2 for F-cycle
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::levelCycle(const int cycleType) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the residual of the Poisson equation at the current level
+ *
+ *          The Laplacian of the data in \ref pressureData at the current level, or the Galerkin operator held in \ref stencilData
+ *          at the coarser levels, is applied and subtracted from the given RHS,
+ *          and the difference is stored in the \ref residualData array of the current level.
+ *          The RHS may be the \ref residualData array itself, in which case it is overwritten by the residual.
+ *          The pads of \ref pressureData are expected to be updated before this function is called.
+ *
+ * \param   rhsData is a const reference to the array holding the RHS of the Poisson equation at the current level
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::computeResidual(const blitz::Array<mgReal, 3> &rhsData) { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the residual of the Poisson equation at the finest level in the precision of the solution
+ *
+ *          The Laplacian of \ref fineSolution is computed using the grid metrics of the \ref grid class directly, and subtracted from
+ *          \ref fineRHS, and the difference is stored in \ref fineResidual.
+ *          Since none of the arrays of the multi-grid levels are used, the residual is as accurate as the solution even when the
+ *          levels are stored in single precision.
+ *          The pads of \ref fineSolution are expected to be updated before this function is called.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::computeFineResidual() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the global norm of an array at the finest level
+ *
+ *          The norm is computed over the points owned by each sub-domain, as given by \ref ownedCore, so that every grid point
+ *          is counted exactly once.
+ *          The norm is specified by the \ref parser#normType "normType" parameter - either the root-mean-square (L2) norm or the
+ *          maximum absolute value.
+ *
+ *          The array may be in the precision of either the multi-grid levels or the fields, and the norm is always computed and
+ *          returned in the precision of the fields.
+ *
+ * \param   data is a const reference to the array at the finest level whose norm has to be computed
+ *
+ * \return  The real value of the global norm of the array
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+template <typename dataReal>
+real poisson<mgReal>::computeNorm(const blitz::Array<dataReal, 3> &data) {
+    real localNorm[2], globalNorm[2];
+    blitz::RectDomain<3> uniqCore = ownedCore(0);
+
+    if (inputParams.normType == 1) {
+        localNorm[0] = blitz::max(fabs(data(uniqCore)));
+
+        MPI_Allreduce(localNorm, globalNorm, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD);
+
+        return globalNorm[0];
+    }
+
+    // THE SUM OF SQUARES AND THE NUMBER OF POINTS ARE ADDED ACROSS ALL SUB-DOMAINS IN A SINGLE REDUCTION
+    localNorm[0] = blitz::sum(blitz::pow2(data(uniqCore)));
+    localNorm[1] = blitz::product(uniqCore.ubound() - uniqCore.lbound() + 1);
+
+    MPI_Allreduce(localNorm, globalNorm, 2, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD);
+
+    return sqrt(globalNorm[0]/globalNorm[1]);
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to remove the null space of the singular operator from the RHS and the solution at the current level
+ *
+ *          With periodic and Neumann boundary conditions, the solution is determined only up to a constant, and the RHS must be
+ *          compatible with the operator for the iterations to converge.
+ *          Hence the weighted mean of the RHS, computed with the weights set in \ref setMeanWeights, is subtracted from it, so that
+ *          any part of the RHS that cannot be satisfied does not stall the iterations.
+ *          Likewise, the weighted mean of the solution is subtracted from it, including its pads, which pins the arbitrary constant
+ *          and keeps the iterations from drifting along the null space.
+ *          The weighted sums of both the fields and the sum of the weights are added across all sub-domains in a single reduction.
+ *
+ * \param   rhsData is a reference to the blitz array holding the RHS at the current level
+ * \param   lhsData is a reference to the blitz array holding the solution at the current level
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::removeNullSpace(blitz::Array<mgReal, 3> &rhsData, blitz::Array<mgReal, 3> &lhsData) {
+    real localSum[3], globalSum[3];
+    real pointWeight;
+
+    blitz::RectDomain<3> uniqCore = ownedCore(vLevel);
+
+    localSum[0] = 0.0;
+    localSum[1] = 0.0;
+    localSum[2] = 0.0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iY = uniqCore.lbound(1); iY <= uniqCore.ubound(1); iY++) {
+            for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+                pointWeight = xWeight(vLevel, iX)*yWeight(vLevel, iY)*zWeight(vLevel, iZ);
+
+                localSum[0] += pointWeight*rhsData(iX, iY, iZ);
+                localSum[1] += pointWeight*lhsData(iX, iY, iZ);
+                localSum[2] += pointWeight;
+            }
+        }
+    }
+
+    MPI_Allreduce(localSum, globalSum, 3, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD);
+
+    rhsData(stagCore(vLevel)) -= globalSum[0]/globalSum[2];
+    lhsData -= globalSum[1]/globalSum[2];
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to remove the null space of the singular operator from the RHS and the solution at the finest level
+ *
+ *          This is the same as \ref removeNullSpace, but acts on \ref fineRHS and \ref fineSolution, which are held in the
+ *          precision of the solution.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::removeFineNullSpace() {
+    real localSum[3], globalSum[3];
+    real pointWeight;
+
+    blitz::RectDomain<3> uniqCore = ownedCore(0);
+
+    localSum[0] = 0.0;
+    localSum[1] = 0.0;
+    localSum[2] = 0.0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iY = uniqCore.lbound(1); iY <= uniqCore.ubound(1); iY++) {
+            for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+                pointWeight = xWeight(0, iX)*yWeight(0, iY)*zWeight(0, iZ);
+
+                localSum[0] += pointWeight*fineRHS(iX, iY, iZ);
+                localSum[1] += pointWeight*fineSolution(iX, iY, iZ);
+                localSum[2] += pointWeight;
+            }
+        }
+    }
+
+    MPI_Allreduce(localSum, globalSum, 3, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD);
+
+    fineRHS(stagCore(0)) -= globalSum[0]/globalSum[2];
+    fineSolution -= globalSum[1]/globalSum[2];
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the weighted mean of a field at the finest level held in the precision of the solution
+ *
+ *          The mean is computed over the points owned by all the sub-domains, with the same weights as in \ref removeNullSpace.
+ *          It is used by the Krylov solvers, which hold their vectors outside this class, to remove the null space of the operator.
+ *
+ * \param   data is a const reference to the field whose mean is computed, with the same limits as the finest level
+ *
+ * \return  The weighted mean of the field over the whole domain
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+real poisson<mgReal>::weightedMean(const blitz::Array<real, 3> &data) {
+    real localSum[2], globalSum[2];
+    real pointWeight;
+
+    blitz::RectDomain<3> uniqCore = ownedCore(0);
+
+    localSum[0] = 0.0;
+    localSum[1] = 0.0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iY = uniqCore.lbound(1); iY <= uniqCore.ubound(1); iY++) {
+            for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+                pointWeight = xWeight(0, iX)*yWeight(0, iY)*zWeight(0, iZ);
+
+                localSum[0] += pointWeight*data(iX, iY, iZ);
+                localSum[1] += pointWeight;
+            }
+        }
+    }
+
+    MPI_Allreduce(localSum, globalSum, 2, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD);
+
+    return globalSum[0]/globalSum[1];
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to impose the boundary conditions on a field at the finest level held in the precision of the solution
+ *
+ *          Since updating the pads only copies values between points, the field is split into a high part, which is its value
+ *          rounded to the precision of the multi-grid levels, and a low part, which is the remainder.
+ *          Both parts are stored in the arrays of the finest level, and \ref imposeBC is called on each of them, after which their
+ *          sum gives the pads.
+ *          When the levels are in the precision of the field, the low part is zero and the pads are exact.
+ *          With single precision levels and a double precision field, the two parts carry about 48 of the 53 bits of the field,
+ *          so that the pads have a relative error of about 1.0e-14.
+ *          This is far below the tolerances of the V-Cycles, but bounds how far the iterative refinement can reduce the residual.
+ *          The \ref pressureData and \ref smoothedPres arrays of the finest level are overwritten in the process.
+ *
+ * \param   data is a reference to the field whose pads are updated, with the same limits as the finest level
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::imposeFineBC(blitz::Array<real, 3> &data) {
+    blitz::Array<mgReal, 3> &highPart = pressureData(0);
+    blitz::Array<mgReal, 3> &lowPart = smoothedPres(0);
+
+    vLevel = 0;
+
+    for (int iX = stagFull(0).lbound(0); iX <= stagFull(0).ubound(0); iX++) {
+        for (int iY = stagFull(0).lbound(1); iY <= stagFull(0).ubound(1); iY++) {
+            for (int iZ = stagFull(0).lbound(2); iZ <= stagFull(0).ubound(2); iZ++) {
+                highPart(iX, iY, iZ) = data(iX, iY, iZ);
+                lowPart(iX, iY, iZ) = data(iX, iY, iZ) - real(highPart(iX, iY, iZ));
+            }
+        }
+    }
+
+    imposeBC(highPart, 2);
+    imposeBC(lowPart, 2);
+
+    for (int iX = stagFull(0).lbound(0); iX <= stagFull(0).ubound(0); iX++) {
+        for (int iY = stagFull(0).lbound(1); iY <= stagFull(0).ubound(1); iY++) {
+            for (int iZ = stagFull(0).lbound(2); iZ <= stagFull(0).ubound(2); iZ++) {
+                data(iX, iY, iZ) = real(highPart(iX, iY, iZ)) + real(lowPart(iX, iY, iZ));
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to solve the Poisson equation by iterative refinement with multi-grid cycles in lower precision
+ *
+ *          The solution and its residual are held in \ref fineSolution and \ref fineResidual, in the precision of the input fields.
+ *          In each iteration, the residual is rounded into \ref inputRHSData, and one cycle starting from a zero initial guess
+ *          computes the correction in the precision of the multi-grid levels, which is then added to the solution.
+ *          Since the residual is always computed in full precision, the solution converges to the same accuracy as with the cycles
+ *          in full precision, while the smoothing, restriction and prolongation stream only half the data.
+ *          The first correction is computed by full multi-grid if the \ref parser#initGuess "initGuess" parameter asks for it.
+ *          The iterations stop under the same conditions as in \ref mgSolve.
+ *
+ * \param   inFn is a reference to the plain scalar field into which the computed solution is written
+ * \param   rhs is a const reference to the plain scalar field which holds the RHS of the Poisson equation
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::mixedSolve(plainsf<real> &inFn, const plainsf<real> &rhs) {
+    real targetNorm;
+
+    vLevel = 0;
+
+    fineRHS(stagCore(0)) = rhs.F(stagCore(0));
+
+    if (inputParams.initGuess == 2) {
+        fineSolution(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound())) = inFn.F;
+        imposeFineBC(fineSolution);
+    } else {
+        fineSolution = 0.0;
+    }
+
+    // THE RHS IS MADE COMPATIBLE WITH THE SINGULAR OPERATOR, AND THE MEAN OF THE INITIAL GUESS IS REMOVED
+    removeFineNullSpace();
+
+    // THE RELATIVE TOLERANCE IS MEASURED AGAINST THE NORM OF THE RHS, WHICH IS THE RESIDUAL NORM OF A ZERO INITIAL GUESS
+    targetNorm = std::max(inputParams.absTol, inputParams.relTol*computeNorm(fineRHS));
+
+    computeFineResidual();
+    residualNorm = computeNorm(fineResidual);
+
+    cyclesUsed = 0;
+
+    while (residualNorm > targetNorm and cyclesUsed < inputParams.vcCount) {
+        // THE CORRECTION IS COMPUTED FROM A ZERO INITIAL GUESS, WITH THE ROUNDED RESIDUAL AS ITS RHS
+        inputRHSData(0) = fineResidual;
+        pressureData(0) = 0.0;
+
+        if (inputParams.initGuess == 1 and cyclesUsed == 0) {
+            fmgCycle();
+        } else {
+            vCycle();
+        }
+
+        // THE PADS OF THE CORRECTION ARE UPDATED BEFORE IT IS ADDED, SO THAT THOSE OF THE SOLUTION STAY CONSISTENT
+        imposeBC(pressureData(0), 2);
+        fineSolution += pressureData(0);
+
+        cyclesUsed += 1;
+
+        computeFineResidual();
+        residualNorm = computeNorm(fineResidual);
+    }
+
+    // THE SOLUTION IS RETURNED WITH ZERO MEAN
+    removeFineNullSpace();
+
+    // RETURN CALCULATED PRESSURE DATA
+    inFn.F = fineSolution(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the Galerkin operators of all the coarser levels
+ *
+ *          The operator of each coarser level is computed as R.A.P, where A is the operator of the next finer level, R is the
+ *          restriction operator and P is the operator-dependent prolongation.
+ *          Since R, A and P are all applied by the existing functions \ref coarsen, \ref computeResidual and \ref prolong,
+ *          the stencil at every point is obtained by probing, i.e., by applying R.A.P to a set of vectors which are 1 at the points of
+ *          one colour and 0 elsewhere.
+ *          The colours are chosen such that every coarse point is coupled to at most one point of each colour, so that the
+ *          restricted value at a point is the coefficient of its neighbour of that colour.
+ *          The levels are processed from the finest to the coarsest, since the operator of each level is needed for the next one.
+ *          This needs 27 probes per level for non-periodic domains (64 for periodic domains in 3D), which are performed only once.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::createGalerkinOperators() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to find the neighbour of each point having the colour being probed, along one direction
+ *
+ *          The points along a direction are coloured by their global index, modulo 3 for a non-periodic direction.
+ *          For a periodic direction, the colours have to repeat consistently across the periodic boundary, and since the number of
+ *          points is a power of 2, the global index is taken modulo 4.
+ *          For each local point, the offset (-1, 0 or 1) of the neighbour having the given colour is stored, with 2 indicating that
+ *          no such neighbour exists.
+ *          Points outside a non-periodic domain are not unknowns of the coarse problem, and are never chosen.
+ *
+ * \param   offset is a reference to the array into which the offsets are written, for all the core points along the direction
+ * \param   gStart is the integer value of the global index of the first local point
+ * \param   gSize is the integer value of the number of intervals along the direction in the global domain
+ * \param   periodic is the boolean flag which is true if the direction is periodic
+ * \param   colour is the integer value of the colour being probed
  ********************************************************************************************************************************************
  */
-void poisson::createMGSubArrays() { };
+template <typename mgReal>
+void poisson<mgReal>::setProbeOffsets(blitz::Array<int, 1> &offset, const int gStart, const int gSize, const bool periodic, const int colour) {
+    int gIndx, cStride;
+
+    cStride = periodic? 4: 3;
+
+    for (int i=offset.lbound(0); i<=offset.ubound(0); i++) {
+        offset(i) = 2;
+
+        // THE FIRST MATCHING NEIGHBOUR IS CHOSEN, SINCE THE TWO NEIGHBOURS OF A POINT ARE THE SAME POINT WHEN A PERIODIC DIRECTION HAS 2 INTERVALS
+        for (int d=-1; d<=1; d++) {
+            gIndx = gStart + i + d;
+            if (periodic) {
+                gIndx = (gIndx + gSize) % gSize;
+            } else if (gIndx < 0 or gIndx > gSize) {
+                continue;
+            }
+
+            if (gIndx % cStride == colour) {
+                offset(i) = d;
+                break;
+            }
+        }
+    }
+}
 
 /**
  ********************************************************************************************************************************************
- * \brief   Function to perform one loop of V-cycle
+ * \brief   Function to solve the tridiagonal system along one line in the Z-direction at the current level
+ *
+ *          The sub-diagonal and super-diagonal entries are the coefficients of the neighbouring points along Z in the operator
+ *          of the current level.
+ *          For a non-periodic Z-direction, the Neumann boundary condition folds the coefficient of the pad into that of its
+ *          mirror point, and the system is solved with the Thomas algorithm.
+ *          For a periodic Z-direction, the last point is the image of the first, and the resulting cyclic system is solved with
+ *          the Thomas algorithm by using the Sherman-Morrison formula to correct for the corner entries.
+ *          Since the forward elimination depends only on the matrix, the correction vector is eliminated in the same pass.
  *
- *          The V-cycle of restrictions, prolongations and smoothings are performed within this function.
- *          First the input data contained in \ref pressureData is smoothed, after which the residual is computed and stored
- *          in the \ref residualData array.
- *          The restrictions, smoothing, and prolongations are performed on these two arrays subsequently.
+ * \param   lowDiag is a reference to the array of sub-diagonal entries at all the points of the line
+ * \param   diagVal is a reference to the array of diagonal entries at all the points of the line
+ * \param   uppDiag is a reference to the array of super-diagonal entries at all the points of the line
+ * \param   lineVal is a reference to the array holding the RHS on input, and the solution at all the points of the line on output
+ * \param   workVal is a reference to a scratch array of the same size as the line
+ * \param   corrVal is a reference to a scratch array of the same size as the line, used only for periodic Z-direction
  ********************************************************************************************************************************************
  */
-void poisson::vCycle() { };
+template <typename mgReal>
+void poisson<mgReal>::solveZLine(blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal, blitz::Array<real, 1> &uppDiag,
+                         blitz::Array<real, 1> &lineVal, blitz::Array<real, 1> &workVal, blitz::Array<real, 1> &corrVal) {
+    int nPts;
+    real lowVal, uppVal, denVal;
+    real gamVal, lftVal, rgtVal, corrFact;
+
+    nPts = inputParams.zPer? zEnd(vLevel): zEnd(vLevel) + 1;
+
+    lftVal = 0.0;
+    rgtVal = 0.0;
+    gamVal = 1.0;
+    if (inputParams.zPer) {
+        // THE CORNER ENTRIES OF THE CYCLIC SYSTEM, AND THE CORRESPONDING MODIFICATION OF THE FIRST AND LAST DIAGONAL ENTRIES
+        lftVal = lowDiag(0);
+        rgtVal = uppDiag(nPts - 1);
+        gamVal = -diagVal(0);
+
+        diagVal(0) -= gamVal;
+        diagVal(nPts - 1) -= lftVal*rgtVal/gamVal;
+
+        corrVal = 0.0;
+        corrVal(0) = gamVal;
+        corrVal(nPts - 1) = rgtVal;
+    }
+
+    // FORWARD ELIMINATION
+    for (int iZ = 0; iZ < nPts; iZ++) {
+        lowVal = lowDiag(iZ);
+        uppVal = uppDiag(iZ);
+
+        if (inputParams.zPer) {
+            if (iZ == 0) lowVal = 0.0;
+            if (iZ == nPts - 1) uppVal = 0.0;
+        } else {
+            // THE PAD AT EITHER END IS THE MIRROR IMAGE OF THE POINT NEXT TO THE WALL
+            if (iZ == 0) {
+                uppVal += lowVal;
+                lowVal = 0.0;
+            }
+            if (iZ == nPts - 1) {
+                lowVal += uppVal;
+                uppVal = 0.0;
+            }
+        }
+
+        if (iZ == 0) {
+            denVal = diagVal(iZ);
+            lineVal(iZ) = lineVal(iZ)/denVal;
+            if (inputParams.zPer) corrVal(iZ) = corrVal(iZ)/denVal;
+        } else {
+            denVal = diagVal(iZ) - lowVal*workVal(iZ - 1);
+            lineVal(iZ) = (lineVal(iZ) - lowVal*lineVal(iZ - 1))/denVal;
+            if (inputParams.zPer) corrVal(iZ) = (corrVal(iZ) - lowVal*corrVal(iZ - 1))/denVal;
+        }
+        workVal(iZ) = uppVal/denVal;
+    }
+
+    // BACK SUBSTITUTION
+    for (int iZ = nPts - 2; iZ >= 0; iZ--) {
+        lineVal(iZ) -= workVal(iZ)*lineVal(iZ + 1);
+        if (inputParams.zPer) corrVal(iZ) -= workVal(iZ)*corrVal(iZ + 1);
+    }
+
+    if (inputParams.zPer) {
+        corrFact = (lineVal(0) + lftVal*lineVal(nPts - 1)/gamVal)/(1.0 + corrVal(0) + lftVal*corrVal(nPts - 1)/gamVal);
+        for (int iZ = 0; iZ < nPts; iZ++) {
+            lineVal(iZ) -= corrFact*corrVal(iZ);
+        }
+
+        // THE LAST POINT OF THE LINE IS THE PERIODIC IMAGE OF THE FIRST
+        lineVal(nPts) = lineVal(0);
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to compute the Laplacian of a field at the finest level
+ *
+ *          The pads of the input field are first made consistent with the boundary conditions, after which the Laplacian is
+ *          computed at all the core points using the same stencil as \ref computeResidual.
+ *          With mixed precision, the Laplacian is instead computed by \ref computeFineResidual in the precision of the field.
+ *          This public function allows the operator of the Poisson equation to be used by solvers that use multi-grid only as a
+ *          preconditioner, like the \ref krylov class.
+ *
+ * \param   lhs is a reference to the field whose Laplacian is computed, with the same limits as the finest level
+ * \param   result is a reference to the array into which the Laplacian is written
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::applyOperator(blitz::Array<real, 3> &lhs, blitz::Array<real, 3> &result) {
+    vLevel = 0;
+
+    if (mixedPrecision) {
+        // THE OPERATOR IS APPLIED IN THE PRECISION OF THE SOLUTION, AND ONLY THE PRECONDITIONER USES THE LOWER PRECISION
+        imposeFineBC(lhs);
+        fineSolution = lhs;
+
+        // THE RESIDUAL WITH ZERO RHS IS THE NEGATIVE OF THE LAPLACIAN
+        fineRHS = 0.0;
+        computeFineResidual();
+
+        result = -fineResidual;
+    } else {
+        // THE PADS ARE UPDATED ON THE LEVEL ARRAY AND COPIED BACK, SINCE THE OPERATOR MAY ALSO BE INSTANTIATED IN LOWER PRECISION
+        pressureData(0) = lhs;
+        imposeBC(pressureData(0), 2);
+        lhs = pressureData(0);
+
+        // THE RESIDUAL WITH ZERO RHS IS THE NEGATIVE OF THE LAPLACIAN
+        residualData(0) = 0.0;
+        computeResidual(residualData(0));
+
+        result = -residualData(0);
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to apply one multi-grid cycle, starting from a zero initial guess, to a given RHS at the finest level
+ *
+ *          The cycle type and smoothing counts are the same as those used by \ref mgSolve.
+ *          This public function allows solvers like the \ref krylov class to use the multi-grid cycle as a preconditioner.
+ *
+ * \param   rhs is a const reference to the RHS to which the cycle is applied, with the same limits as the finest level
+ * \param   result is a reference to the array into which the approximate solution is written, including its pads
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::applyPreconditioner(const blitz::Array<real, 3> &rhs, blitz::Array<real, 3> &result) {
+    vLevel = 0;
+
+    inputRHSData(0) = rhs;
+    pressureData(0) = 0.0;
+
+    vCycle();
+
+    result = pressureData(0);
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to get the limits of the points owned by the local sub-domain at a given level
+ *
+ *          Since the last point of each sub-domain is the same as the first point of the next sub-domain (or of the same
+ *          sub-domain when the domain is periodic), this point is owned by the local sub-domain only when it lies on a
+ *          non-periodic wall.
+ *          The returned limits exclude the last point along the directions where it is not owned.
+ *
+ * \param   level is the integer value of the level of the V-cycle at which the limits are needed
+ *
+ * \return  The RectDomain object holding the limits of the owned points at the given level
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+blitz::RectDomain<3> poisson<mgReal>::ownedCore(const int level) {
+    blitz::TinyVector<int, 3> uniqEnd;
+
+    uniqEnd = stagCore(level).ubound();
+    if (inputParams.xPer or mesh.rankData.xRank < mesh.rankData.npX - 1) uniqEnd(0) -= 1;
+    if (uniqEnd(1) > 0 and (inputParams.yPer or mesh.rankData.yRank < mesh.rankData.npY - 1)) uniqEnd(1) -= 1;
+    if (inputParams.zPer) uniqEnd(2) -= 1;
+
+    return blitz::RectDomain<3>(stagCore(level).lbound(), uniqEnd);
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to map the local indices of the coarsest level along one direction to the indices of the global grid
+ *
+ *          The local index of each point, including the pads at either end, is offset by the position of the sub-domain in the
+ *          global grid.
+ *          Points lying beyond the global grid are mapped onto their periodic images along periodic directions, and onto their
+ *          mirror images about the wall along non-periodic directions, consistent with the Neumann condition imposed by \ref imposeBC.
+ *
+ * \param   gIndx is a reference to the array of global indices, whose bounds must span the local points along with the pads
+ * \param   offset is the integer value of the global index of the first core point of the sub-domain
+ * \param   gSize is the integer value of the number of unknowns along the direction in the global grid
+ * \param   periodic is the boolean flag which is true when the direction is periodic
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::setGlobalIndex(blitz::Array<int, 1> &gIndx, const int offset, const int gSize, const bool periodic) {
+    int gIndex;
+
+    for (int i = gIndx.lbound(0); i <= gIndx.ubound(0); i++) {
+        gIndex = offset + i;
+
+        if (periodic) {
+            gIndex = parallel::pmod(gIndex, gSize);
+        } else {
+            if (gIndex < 0) gIndex = -gIndex;
+            if (gIndex > gSize - 1) gIndex = 2*(gSize - 1) - gIndex;
+        }
+
+        gIndx(i) = gIndex;
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to build the matrix of the Poisson equation at the coarsest level for the direct solver
+ *
+ *          Each sub-domain computes the non-zero entries of the rows of the matrix for the points it owns, with the neighbouring
+ *          points across periodic and Neumann boundaries mapped onto the corresponding interior points.
+ *          The entries are taken from the stencil of the operator used at the coarsest level, which is either the Laplacian or the
+ *          Galerkin operator.
+ *          It also computes the global index of each of its owned points and of each point in its core.
+ *          These are passed to \ref factorCoarseSystem, which assembles and factors the matrix once and for all.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::createCoarseSystem() { };
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to gather the matrix of the coarsest level onto the root rank and compute its LU factorization
+ *
+ *          The entries of the matrix computed by all the sub-domains are gathered onto rank 0, which assembles them into a dense
+ *          matrix.
+ *          Since the boundary conditions are either periodic or Neumann, the matrix is singular with the constant as its null space.
+ *          Hence the matrix is bordered with an extra row and column of 1s, which impose a zero mean on the solution and absorb
+ *          any part of the RHS that is incompatible with the singular operator.
+ *          The bordered matrix is factored by LU decomposition with partial pivoting, and the factors are stored in \ref coarseLU
+ *          and \ref coarsePivot to be reused by \ref directSolve every time the coarsest level is solved.
+ *          The global indices of the owned and core points of all the sub-domains are also gathered, so that the RHS and solution
+ *          can later be transferred with a single MPI_Gatherv and MPI_Scatterv respectively.
+ *          If the coarsest level has more than 4096 points, nothing is factored and \ref solve uses the iterative solver instead.
+ *
+ * \param   rowIndx is a const reference to the array of global row indices of the local matrix entries
+ * \param   colIndx is a const reference to the array of global column indices of the local matrix entries
+ * \param   matVals is a const reference to the array of values of the local matrix entries
+ * \param   ownedIndx is a const reference to the array of global indices of the points owned by the local sub-domain
+ * \param   coreIndx is a const reference to the array of global indices of all the core points of the local sub-domain
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::factorCoarseSystem(const blitz::Array<int, 1> &rowIndx, const blitz::Array<int, 1> &colIndx, const blitz::Array<real, 1> &matVals,
+                                 const blitz::Array<int, 1> &ownedIndx, const blitz::Array<int, 1> &coreIndx) {
+    int nProc, rootRank;
+    int localCount, totalCount, nSize;
+    int pivotRow;
+    real maxValue, tempValue;
+
+    blitz::Array<int, 1> entryCounts, entryDispls;
+    blitz::Array<int, 1> allRows, allCols;
+    blitz::Array<real, 1> allVals;
+
+    rootRank = 0;
+    nProc = mesh.rankData.nProc;
+
+    // CHECK IF THE COARSEST LEVEL IS SMALL ENOUGH FOR ITS DENSE MATRIX TO BE FACTORED ON A SINGLE RANK, AND USE THE ITERATIVE SOLVER OTHERWISE
+    // THIS IS CHECKED HERE RATHER THAN IN THE PARSER, SINCE THE SIZE OF THE COARSEST LEVEL DEPENDS ON THE DIRECTIONS CHOSEN FOR SEMI-COARSENING
+    localCount = ownedIndx.size();
+    MPI_Allreduce(&localCount, &totalCount, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (totalCount > 4096) {
+        if (mesh.rankData.rank == rootRank) {
+            std::cout << "WARNING: The coarsest level has " << totalCount << " points, more than the 4096 allowed for the DIRECT solver. "
+                      << "Using the ITERATIVE solver at the coarsest level instead. Increase the V-Cycle Depth to use the DIRECT solver" << std::endl;
+        }
+        directCoarse = false;
+        return;
+    }
+
+    entryCounts.resize(nProc);          entryDispls.resize(nProc);
+    ownedCounts.resize(nProc);          ownedDispls.resize(nProc);
+    coreCounts.resize(nProc);           coreDispls.resize(nProc);
+
+    // GATHER THE NUMBER OF MATRIX ENTRIES, OWNED POINTS AND CORE POINTS OF ALL SUB-DOMAINS ON THE ROOT RANK
+    localCount = rowIndx.size();
+    MPI_Gather(&localCount, 1, MPI_INT, entryCounts.dataFirst(), 1, MPI_INT, rootRank, MPI_COMM_WORLD);
+
+    localCount = ownedIndx.size();
+    MPI_Gather(&localCount, 1, MPI_INT, ownedCounts.dataFirst(), 1, MPI_INT, rootRank, MPI_COMM_WORLD);
+
+    localCount = coreIndx.size();
+    MPI_Gather(&localCount, 1, MPI_INT, coreCounts.dataFirst(), 1, MPI_INT, rootRank, MPI_COMM_WORLD);
+
+    entryDispls(0) = 0;
+    ownedDispls(0) = 0;
+    coreDispls(0) = 0;
+    for (int i=1; i<nProc; i++) {
+        entryDispls(i) = entryDispls(i - 1) + entryCounts(i - 1);
+        ownedDispls(i) = ownedDispls(i - 1) + ownedCounts(i - 1);
+        coreDispls(i) = coreDispls(i - 1) + coreCounts(i - 1);
+    }
+
+    // THE ARRAYS TO RECEIVE THE GATHERED DATA ARE ALLOCATED WITH THEIR FULL SIZE ONLY ON THE ROOT RANK
+    totalCount = (mesh.rankData.rank == rootRank)? blitz::sum(entryCounts): 1;
+    allRows.resize(totalCount);
+    allCols.resize(totalCount);
+    allVals.resize(totalCount);
+
+    totalCount = (mesh.rankData.rank == rootRank)? blitz::sum(ownedCounts): 1;
+    ownedGlobal.resize(totalCount);
+    rhsBuffer.resize(totalCount);
+
+    totalCount = (mesh.rankData.rank == rootRank)? blitz::sum(coreCounts): 1;
+    coreGlobal.resize(totalCount);
+    solBuffer.resize(totalCount);
+
+    ownedBuffer.resize(ownedIndx.size());
+    coreBuffer.resize(coreIndx.size());
+
+    MPI_Gatherv(rowIndx.data(), rowIndx.size(), MPI_INT, allRows.dataFirst(), entryCounts.dataFirst(), entryDispls.dataFirst(), MPI_INT, rootRank, MPI_COMM_WORLD);
+    MPI_Gatherv(colIndx.data(), colIndx.size(), MPI_INT, allCols.dataFirst(), entryCounts.dataFirst(), entryDispls.dataFirst(), MPI_INT, rootRank, MPI_COMM_WORLD);
+    MPI_Gatherv(matVals.data(), matVals.size(), MPI_FP_REAL, allVals.dataFirst(), entryCounts.dataFirst(), entryDispls.dataFirst(), MPI_FP_REAL, rootRank, MPI_COMM_WORLD);
+
+    MPI_Gatherv(ownedIndx.data(), ownedIndx.size(), MPI_INT, ownedGlobal.dataFirst(), ownedCounts.dataFirst(), ownedDispls.dataFirst(), MPI_INT, rootRank, MPI_COMM_WORLD);
+    MPI_Gatherv(coreIndx.data(), coreIndx.size(), MPI_INT, coreGlobal.dataFirst(), coreCounts.dataFirst(), coreDispls.dataFirst(), MPI_INT, rootRank, MPI_COMM_WORLD);
+
+    if (mesh.rankData.rank != rootRank) return;
+
+    // ASSEMBLE THE DENSE MATRIX BORDERED BY THE ZERO-MEAN CONSTRAINT - THE LAST ROW AND COLUMN
+    nSize = ownedGlobal.size() + 1;
+    coarseLU.resize(nSize, nSize);
+    coarsePivot.resize(nSize);
+
+    coarseLU = 0.0;
+    for (int i=0; i<int(allRows.size()); i++) {
+        coarseLU(allRows(i), allCols(i)) += allVals(i);
+    }
+    for (int i=0; i<nSize - 1; i++) {
+        coarseLU(i, nSize - 1) = 1.0;
+        coarseLU(nSize - 1, i) = 1.0;
+    }
+
+    // LU DECOMPOSITION WITH PARTIAL PIVOTING - THE MULTIPLIERS OF L ARE STORED BELOW THE DIAGONAL AND U ON AND ABOVE IT
+    for (int k=0; k<nSize; k++) {
+        pivotRow = k;
+        maxValue = fabs(coarseLU(k, k));
+        for (int i=k+1; i<nSize; i++) {
+            if (fabs(coarseLU(i, k)) > maxValue) {
+                maxValue = fabs(coarseLU(i, k));
+                pivotRow = i;
+            }
+        }
+        coarsePivot(k) = pivotRow;
+
+        if (pivotRow != k) {
+            for (int j=0; j<nSize; j++) {
+                tempValue = coarseLU(k, j);
+                coarseLU(k, j) = coarseLU(pivotRow, j);
+                coarseLU(pivotRow, j) = tempValue;
+            }
+        }
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(k, nSize)
+        for (int i=k+1; i<nSize; i++) {
+            coarseLU(i, k) /= coarseLU(k, k);
+            for (int j=k+1; j<nSize; j++) {
+                coarseLU(i, j) -= coarseLU(i, k)*coarseLU(k, j);
+            }
+        }
+    }
+}
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Function to solve the Poisson equation at the coarsest level using the LU factors computed at initialization
+ *
+ *          The RHS at the points owned by each sub-domain is gathered onto the root rank, which solves the bordered system by
+ *          forward and backward substitution with the factors in \ref coarseLU.
+ *          The solution at all the core points of each sub-domain is then scattered back, and the pads are updated by \ref imposeBC.
+ *          Hence the coarsest level is solved with just one gather and one scatter, instead of a global reduction per iteration.
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void poisson<mgReal>::directSolve() {
+    int nSize, pointCount;
+    int rootRank = 0;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    blitz::RectDomain<3> uniqCore = ownedCore(vLevel);
+
+    // COPY THE RHS AT THE OWNED POINTS IN THE SAME ORDER AS THE INDICES PASSED TO factorCoarseSystem
+    pointCount = 0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iY = uniqCore.lbound(1); iY <= uniqCore.ubound(1); iY++) {
+            for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+                ownedBuffer(pointCount) = rData(iX, iY, iZ);
+                pointCount += 1;
+            }
+        }
+    }
+
+    MPI_Gatherv(ownedBuffer.dataFirst(), ownedBuffer.size(), MPI_FP_REAL, rhsBuffer.dataFirst(), ownedCounts.dataFirst(), ownedDispls.dataFirst(), MPI_FP_REAL, rootRank, MPI_COMM_WORLD);
+
+    if (mesh.rankData.rank == rootRank) {
+        nSize = coarsePivot.size();
+
+        blitz::Array<real, 1> xVec(nSize);
+
+        for (int i=0; i<nSize - 1; i++) {
+            xVec(ownedGlobal(i)) = rhsBuffer(i);
+        }
+        xVec(nSize - 1) = 0.0;
+
+        // APPLY THE ROW INTERCHANGES, AND THEN PERFORM FORWARD AND BACKWARD SUBSTITUTION
+        for (int k=0; k<nSize; k++) {
+            std::swap(xVec(k), xVec(coarsePivot(k)));
+        }
+
+        for (int i=1; i<nSize; i++) {
+            for (int j=0; j<i; j++) {
+                xVec(i) -= coarseLU(i, j)*xVec(j);
+            }
+        }
+
+        for (int i=nSize - 1; i>=0; i--) {
+            for (int j=i+1; j<nSize; j++) {
+                xVec(i) -= coarseLU(i, j)*xVec(j);
+            }
+            xVec(i) /= coarseLU(i, i);
+        }
+
+        for (int i=0; i<int(solBuffer.size()); i++) {
+            solBuffer(i) = xVec(coreGlobal(i));
+        }
+    }
+
+    MPI_Scatterv(solBuffer.dataFirst(), coreCounts.dataFirst(), coreDispls.dataFirst(), MPI_FP_REAL, coreBuffer.dataFirst(), coreBuffer.size(), MPI_FP_REAL, rootRank, MPI_COMM_WORLD);
+
+    pointCount = 0;
+    for (int iX = stagCore(vLevel).lbound(0); iX <= stagCore(vLevel).ubound(0); iX++) {
+        for (int iY = stagCore(vLevel).lbound(1); iY <= stagCore(vLevel).ubound(1); iY++) {
+            for (int iZ = stagCore(vLevel).lbound(2); iZ <= stagCore(vLevel).ubound(2); iZ++) {
+                pData(iX, iY, iZ) = coreBuffer(pointCount);
+                pointCount += 1;
+            }
+        }
+    }
+
+    imposeBC(pData, 2);
+}
 
 /**
  ********************************************************************************************************************************************
  * \brief   The core, publicly accessible function of poisson to compute the solution for the Poisson equation
  *
- *          The function calls the V-cycle as many times as set by the user.
- *          Before doing so, the input data is transferred into the data-structures used by the poisson class to
+ *          The function performs multi-grid cycles until the norm of the residual falls below either the absolute tolerance,
+ *          \ref parser#absTol "absTol", or the relative tolerance, \ref parser#relTol "relTol", times the norm of the RHS.
+ *          The cycles start either from zero, from the solution computed by full multi-grid, or from the data in the input field
+ *          itself (warm start), as set by the user.
+ *          With a warm start from the solution of a nearby problem, as in time-marching, the tolerance is often met within one cycle.
+ *          The number of cycles is limited to the maximum number set by the user, and the number of cycles performed along
+ *          with the final norm of the residual are stored in \ref cyclesUsed and \ref residualNorm respectively.
+ *          If full multi-grid is chosen as the initial guess, the solution is first computed by \ref fmgCycle, which is counted
+ *          as one cycle.
+ *          Before performing the cycles, the input data is transferred into the data-structures used by the poisson class to
  *          perform restrictions and prolongations without copying.
  *          Finally, the computed solution is transferred back from the internal data-structures back into the
  *          scalar field supplied by the calling function.
  *
- * \param   inFn is a pointer to the plain scalar field (cell-centered) into which the computed soltuion must be transferred
+ * \param   inFn is a pointer to the plain scalar field (cell-centered) into which the computed soltuion must be transferred, and
+ *          whose data is used as the initial guess for a warm start
  * \param   rhs is a const reference to the plain scalar field (cell-centered) which contains the RHS for the Poisson equation to solve
  ********************************************************************************************************************************************
  */
-void poisson::mgSolve(plainsf &inFn, const plainsf &rhs) { };
+template <typename mgReal>
+void poisson<mgReal>::mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs) { };
 
 /**
  ********************************************************************************************************************************************
@@ -241,7 +1647,8 @@ void poisson::mgSolve(plainsf &inFn, const plainsf &rhs) { };
  *          This done by printing the contents of the arrays for visual inspection for now.
  ********************************************************************************************************************************************
  */
-real poisson::testTransfer() { return 0; };
+template <typename mgReal>
+real poisson<mgReal>::testTransfer() { return 0; };
 
 /**
  ********************************************************************************************************************************************
@@ -252,7 +1659,8 @@ real poisson::testTransfer() { return 0; };
  *          This done by returning the average deviation from correct values as a real value
  ********************************************************************************************************************************************
  */
-real poisson::testProlong() { return 0; };
+template <typename mgReal>
+real poisson<mgReal>::testProlong() { return 0; };
 
 /**
  ********************************************************************************************************************************************
@@ -263,7 +1671,8 @@ real poisson::testProlong() { return 0; };
  *          This done by printing the contents of the arrays for visual inspection for now.
  ********************************************************************************************************************************************
  */
-real poisson::testPeriodic() { return 0; };
+template <typename mgReal>
+real poisson<mgReal>::testPeriodic() { return 0; };
 
 /**
  ********************************************************************************************************************************************
@@ -274,15 +1683,26 @@ real poisson::testPeriodic() { return 0; };
  *          This done by printing the contents of the arrays for visual inspection for now.
  ********************************************************************************************************************************************
  */
-real poisson::testSolve() { return 0; };
+template <typename mgReal>
+real poisson<mgReal>::testSolve() { return 0; };
 
-poisson::~poisson() {
+template <typename mgReal>
+poisson<mgReal>::~poisson() {
 #ifdef TIME_RUN
     if (mesh.rankData.rank == 0) {
         std::cout << std::left << std::setw(50) << "Time taken in computation within solve: "            << std::fixed << std::setprecision(6) << solveTimeComp << std::endl;
         std::cout << std::left << std::setw(50) << "Time taken in data-transfer within solve: "          << std::fixed << std::setprecision(6) << solveTimeTran << std::endl;
         std::cout << std::left << std::setw(50) << "Time taken in computation within smooth: "           << std::fixed << std::setprecision(6) << smothTimeComp << std::endl;
         std::cout << std::left << std::setw(50) << "Time taken in data-transfer within smooth: "         << std::fixed << std::setprecision(6) << smothTimeTran << std::endl;
+        std::cout << std::left << std::setw(50) << "Time taken in packing and unpacking the pads: "      << std::fixed << std::setprecision(6) << padsTimePack << std::endl;
     }
 #endif
 };
+
+template class poisson<float>;
+template class poisson<double>;
+
+template real poisson<float>::computeNorm(const blitz::Array<float, 3> &data);
+template real poisson<float>::computeNorm(const blitz::Array<double, 3> &data);
+template real poisson<double>::computeNorm(const blitz::Array<float, 3> &data);
+template real poisson<double>::computeNorm(const blitz::Array<double, 3> &data);
@@ -8,45 +8,85 @@
 #include "plainsf.h"
 #include "grid.h"
 
+template <typename mgReal>
 class poisson {
     protected:
         int vLevel, maxCount;
+        int fineLevel;
         int xStr, yStr, zStr;
-        int xEnd, yEnd, zEnd;
+
+        bool mixedPrecision;
+        bool directCoarse;
+
+        MPI_Datatype mgDataType;
+
+        blitz::Array<int, 1> xEnd, yEnd, zEnd;
 
 #ifdef TIME_RUN
         real solveTimeComp;
         real solveTimeTran;
         real smothTimeComp;
         real smothTimeTran;
+        real padsTimePack;
 #endif
 
         const grid &mesh;
         const parser &inputParams;
 
-        blitz::Array<real, 3> residualData;
-        blitz::Array<real, 3> iteratorTemp;
-        blitz::Array<real, 3> smoothedPres;
+        blitz::Array<real, 2> coarseLU;
+        blitz::Array<int, 1> coarsePivot;
+
+        blitz::Array<int, 1> ownedGlobal, ownedCounts, ownedDispls;
+        blitz::Array<int, 1> coreGlobal, coreCounts, coreDispls;
+
+        blitz::Array<real, 1> ownedBuffer, coreBuffer;
+        blitz::Array<real, 1> rhsBuffer, solBuffer;
+
+        blitz::Array<blitz::Array<mgReal, 3>, 1> smoothedPres;
+        blitz::Array<blitz::Array<mgReal, 3>, 1> residualData;
+
+        blitz::Array<blitz::Array<mgReal, 4>, 1> stencilData;
 
         blitz::Array<int, 1> mgSizeArray;
-        blitz::Array<int, 1> strideValues;
+        blitz::Array<int, 2> strideValues;
 
         blitz::TinyVector<int, 3> localSizeIndex;
 
         blitz::Array<MPI_Request, 1> recvRequest;
         blitz::Array<MPI_Status, 1> recvStatus;
 
-        blitz::Array<real, 1> hx, hy, hz;
+        blitz::Array<MPI_Status, 1> sendStatus;
+
+        blitz::Array<mgReal, 1> hx, hy, hz;
+
+        blitz::Array<mgReal, 2> xixx, xix2;
+        blitz::Array<mgReal, 2> etyy, ety2;
+        blitz::Array<mgReal, 2> ztzz, ztz2;
 
-        blitz::Array<real, 1> xixx, xix2;
-        blitz::Array<real, 1> etyy, ety2;
-        blitz::Array<real, 1> ztzz, ztz2;
+        blitz::Array<mgReal, 2> xixxCoeff, xix2Coeff;
+        blitz::Array<mgReal, 2> etyyCoeff, ety2Coeff;
+        blitz::Array<mgReal, 2> ztzzCoeff, ztz2Coeff;
+
+        blitz::Array<mgReal, 2> xWeight, yWeight, zWeight;
+
+        blitz::Array<real, 3> fineSolution, fineRHS, fineResidual;
 
         blitz::Array<blitz::Range, 1> xMeshRange, yMeshRange, zMeshRange;
 
         blitz::Array<MPI_Datatype, 1> xMGArray;
         blitz::Array<MPI_Datatype, 1> yMGArray;
 
+        blitz::Array<MPI_Datatype, 2> xMGRBArray;
+        blitz::Array<MPI_Datatype, 2> yMGRBArray;
+
+        blitz::Array<MPI_Datatype, 1> xMGHalo;
+        blitz::Array<MPI_Datatype, 1> yMGHalo;
+
+        blitz::Array<bool, 1> haloLevel;
+
+        blitz::Array<blitz::Array<mgReal, 1>, 2> padSendBuffer, padRecvBuffer;
+        blitz::Array<MPI_Request, 3> padSendRequest, padRecvRequest;
+
         blitz::Array<blitz::TinyVector<int, 3>, 1> mgSendLft, mgSendRgt;
         blitz::Array<blitz::TinyVector<int, 3>, 1> mgRecvLft, mgRecvRgt;
 
@@ -54,8 +94,12 @@ class poisson {
         blitz::Array<blitz::TinyVector<int, 3>, 1> mgRecvFrn, mgRecvBak;
 
         virtual void solve();
+        virtual void coarsen();
         virtual void prolong();
         virtual void smooth(const int smoothCount);
+        virtual void gsSweep(const int colour);
+        virtual real lineSweep(const int colour, const bool findError);
+        virtual void blockSweep(const int sweepCount);
 
         virtual void initMeshRanges();
 
@@ -65,24 +109,71 @@ class poisson {
         virtual void setCoefficients();
         virtual void copyStaggrDerivs();
 
-        virtual void imposeBC();
-        virtual void updatePads();
+        virtual void imposeBC(blitz::Array<mgReal, 3> &data, const int colour);
+        virtual void imposePlaneBC(blitz::Array<mgReal, 3> &data, const int iX);
+        virtual void updatePads(blitz::Array<mgReal, 3> &data, const int colour);
+        virtual void updateHalos(blitz::Array<mgReal, 3> &data);
+        virtual void beginPadUpdate(blitz::Array<mgReal, 3> &data, const int colour);
+        virtual void finishPadUpdate(blitz::Array<mgReal, 3> &data, const int colour);
+        virtual void imposeWallBC(blitz::Array<mgReal, 3> &data);
         virtual void createMGSubArrays();
+        virtual void createCoarseSystem();
+        virtual void createGalerkinOperators();
 
         virtual void vCycle();
+        virtual void fmgCycle();
+        virtual void levelCycle(const int cycleType);
+        virtual void computeResidual(const blitz::Array<mgReal, 3> &rhsData);
+        virtual void computeFineResidual();
 
+        void setStrides();
         void initializeArrays();
+        void setMeanWeights();
+        void shareCoefficients(blitz::Array<mgReal, 2> &coeffData, const int level, const int coreEnd, const int lftRank, const int rgtRank);
+
+        int faceOffset(const int level, const int lineIndex, const int colour);
+        void packFace(const mgReal *faceData, const long lineStride, const int lineCount, const int colour, mgReal *bufferData);
+        void unpackFace(const mgReal *bufferData, const long lineStride, const int lineCount, const int colour, mgReal *faceData);
+
+        void removeNullSpace(blitz::Array<mgReal, 3> &rhsData, blitz::Array<mgReal, 3> &lhsData);
+        void removeFineNullSpace();
+
+        void imposeFineBC(blitz::Array<real, 3> &data);
+        void mixedSolve(plainsf<real> &inFn, const plainsf<real> &rhs);
+
+        template <typename dataReal> real computeNorm(const blitz::Array<dataReal, 3> &data);
+
+        void solveZLine(blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal, blitz::Array<real, 1> &uppDiag,
+                        blitz::Array<real, 1> &lineVal, blitz::Array<real, 1> &workVal, blitz::Array<real, 1> &corrVal);
+
+        void setProbeOffsets(blitz::Array<int, 1> &offset, const int gStart, const int gSize, const bool periodic, const int colour);
+
+        void setGlobalIndex(blitz::Array<int, 1> &gIndx, const int offset, const int gSize, const bool periodic);
+
+        void factorCoarseSystem(const blitz::Array<int, 1> &rowIndx, const blitz::Array<int, 1> &colIndx, const blitz::Array<real, 1> &matVals,
+                                const blitz::Array<int, 1> &ownedIndx, const blitz::Array<int, 1> &coreIndx);
+        void directSolve();
 
     public:
-        blitz::Array<real, 3> pressureData;
-        blitz::Array<real, 3> inputRHSData;
+        blitz::Array<blitz::Array<mgReal, 3>, 1> pressureData;
+        blitz::Array<blitz::Array<mgReal, 3>, 1> inputRHSData;
 
-        blitz::RectDomain<3> stagFull;
-        blitz::RectDomain<3> stagCore;
+        blitz::Array<blitz::RectDomain<3>, 1> stagFull;
+        blitz::Array<blitz::RectDomain<3>, 1> stagCore;
+
+        int cyclesUsed;
+        real residualNorm;
 
         poisson(const grid &mesh, const parser &solParam);
 
-        virtual void mgSolve(plainsf &inFn, const plainsf &rhs);
+        virtual void mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs);
+
+        void applyOperator(blitz::Array<real, 3> &lhs, blitz::Array<real, 3> &result);
+        void applyPreconditioner(const blitz::Array<real, 3> &rhs, blitz::Array<real, 3> &result);
+
+        blitz::RectDomain<3> ownedCore(const int level);
+
+        real weightedMean(const blitz::Array<real, 3> &data);
 
         virtual real testTransfer();
         virtual real testProlong();
@@ -99,25 +190,125 @@ class poisson {
  *
  *  The class implements the geometric multi-grid method for solving the Poisson equation on a non-uniform grid across MPI decomposed
  *  domains for parallel computations.
- *  The data structure used by the class for computing multi-grid V-cycles across sub-domains is a blitz array with very wide overlap.
- *  When calculating the finite differences at the sub-domain boundaries, at the coarsest level of the V-cycle, data points from very
- *  deep within the neighbouring sub-domains are necessary.
- *  This is the reason for using a wide pad, that spans up to the nearest node of the adjacent sub-domain at the coarsest mesh.
- *  This increases the memory footprint, but doesn't increase the computational time as only a single finite-difference calculation
- *  is being done using the pads at all levels of the V-cycle.
+ *  The data structure used by the class is a hierarchy of blitz arrays, with one separately allocated array for each level of the V-cycle.
+ *  The array of a coarse level stores only the points of that level contiguously, so that all the operations at every level of the
+ *  V-cycle access memory with unit stride.
+ *  Since the sub-domain boundaries are exchanged at each level separately, the pads of every level are only one point wide, unless
+ *  deeper pads along X and Y are asked for through the \ref parser#haloDepth "haloDepth" parameter to fuse the smoothing sweeps.
+ *  The operator at the coarser levels is either the Laplacian discretized using the grid metrics at the points of that level, or
+ *  the Galerkin operator computed from the finer level, which is stored as a full stencil at each point in \ref stencilData.
+ *  The classes are templated on the scalar type mgReal of the arrays of all the levels, which is chosen at run-time through the
+ *  \ref parser#mgPrecision "mgPrecision" parameter, and the templates are instantiated for both float and double.
+ *  When mgReal is of lower precision than the fields, the cycles compute corrections to a solution which is held, along with its
+ *  residual, in the precision of the fields at the finest level.
+ *  The grid is coarsened either along all the directions at every level, or, with semi-coarsening, only along the directions with
+ *  the smallest physical grid spacing, so that strongly anisotropic grids are still smoothed effectively.
  *
  *  All the necessary functions to perform the V-cycle - prolongation, solving at coarsest mesh, smoothening, etc. are implemented
  *  within the \ref poisson class.
  ********************************************************************************************************************************************
  */
 
-class multigrid_d2: public poisson {
+template <typename mgReal>
+class multigrid_d2: public poisson<mgReal> {
     private:
-        blitz::Array<real, 1> hx2, hz2, hzhx;
+        using poisson<mgReal>::vLevel;
+        using poisson<mgReal>::maxCount;
+        using poisson<mgReal>::fineLevel;
+        using poisson<mgReal>::xStr;
+        using poisson<mgReal>::zStr;
+
+        using poisson<mgReal>::mixedPrecision;
+        using poisson<mgReal>::directCoarse;
+        using poisson<mgReal>::mgDataType;
+
+        using poisson<mgReal>::xEnd;
+        using poisson<mgReal>::zEnd;
+
+        using poisson<mgReal>::mesh;
+        using poisson<mgReal>::inputParams;
+
+        using poisson<mgReal>::smoothedPres;
+        using poisson<mgReal>::residualData;
+        using poisson<mgReal>::stencilData;
+
+        using poisson<mgReal>::mgSizeArray;
+        using poisson<mgReal>::strideValues;
+        using poisson<mgReal>::localSizeIndex;
+
+        using poisson<mgReal>::recvRequest;
+        using poisson<mgReal>::recvStatus;
+
+        using poisson<mgReal>::sendStatus;
+
+        using poisson<mgReal>::hx;
+        using poisson<mgReal>::hz;
+        using poisson<mgReal>::xixx;
+        using poisson<mgReal>::xix2;
+        using poisson<mgReal>::ztzz;
+        using poisson<mgReal>::ztz2;
+        using poisson<mgReal>::xixxCoeff;
+        using poisson<mgReal>::xix2Coeff;
+        using poisson<mgReal>::ztzzCoeff;
+        using poisson<mgReal>::ztz2Coeff;
+
+        using poisson<mgReal>::fineSolution;
+        using poisson<mgReal>::fineRHS;
+        using poisson<mgReal>::fineResidual;
+
+        using poisson<mgReal>::xMeshRange;
+        using poisson<mgReal>::zMeshRange;
+
+        using poisson<mgReal>::xMGArray;
+        using poisson<mgReal>::xMGRBArray;
+        using poisson<mgReal>::xMGHalo;
+
+        using poisson<mgReal>::haloLevel;
+
+        using poisson<mgReal>::padSendBuffer;
+        using poisson<mgReal>::padRecvBuffer;
+        using poisson<mgReal>::padSendRequest;
+        using poisson<mgReal>::padRecvRequest;
+
+        using poisson<mgReal>::mgSendLft;
+        using poisson<mgReal>::mgSendRgt;
+        using poisson<mgReal>::mgRecvLft;
+        using poisson<mgReal>::mgRecvRgt;
+
+        using poisson<mgReal>::setStrides;
+        using poisson<mgReal>::initializeArrays;
+        using poisson<mgReal>::shareCoefficients;
+        using poisson<mgReal>::faceOffset;
+        using poisson<mgReal>::packFace;
+        using poisson<mgReal>::unpackFace;
+        using poisson<mgReal>::removeNullSpace;
+        using poisson<mgReal>::mixedSolve;
+        using poisson<mgReal>::computeNorm;
+        using poisson<mgReal>::solveZLine;
+        using poisson<mgReal>::setProbeOffsets;
+        using poisson<mgReal>::setGlobalIndex;
+        using poisson<mgReal>::factorCoarseSystem;
+        using poisson<mgReal>::directSolve;
+
+        blitz::Array<mgReal, 1> hx2, hz2, hzhx;
+
+        void (multigrid_d2<mgReal>::*residualKernel)(const blitz::Array<mgReal, 3> &rhsData);
+        real (multigrid_d2<mgReal>::*pointKernel)(const int colour, const int sweepRegion);
+        real (multigrid_d2<mgReal>::*checkKernel)(const int colour, const int sweepRegion);
+        void (multigrid_d2<mgReal>::*planeKernel)(const int iX, const int colour);
+        void (multigrid_d2<mgReal>::*lineKernel)(const int iX,
+                                                 blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal, blitz::Array<real, 1> &uppDiag,
+                                                 blitz::Array<real, 1> &lineVal);
+
+        void getStencil(const int iX, const int iZ, blitz::TinyVector<real, 9> &aVal);
 
         void solve();
+        void coarsen();
         void prolong();
         void smooth(const int smoothCount);
+        void gsSweep(const int colour);
+        real lineSweep(const int colour, const bool findError);
+        void blockSweep(const int sweepCount);
 
         void initMeshRanges();
 
@@ -127,23 +318,52 @@ class multigrid_d2: public poisson {
         void setCoefficients();
         void copyStaggrDerivs();
 
-        void imposeBC();
-        void updatePads();
+        void setKernels();
+        template <bool xUniform, bool zUniform> void selectKernels();
+
+        template <bool xUniform, bool zUniform> void residualSweep(const blitz::Array<mgReal, 3> &rhsData);
+        template <bool xUniform, bool zUniform, bool findError> real pointSweep(const int colour, const int sweepRegion);
+        template <bool xUniform, bool zUniform> void planeSweep(const int iX, const int colour);
+        template <bool xUniform, bool zUniform> void lineSystem(const int iX,
+                                                               blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal,
+                                                               blitz::Array<real, 1> &uppDiag, blitz::Array<real, 1> &lineVal);
+
+        void imposeBC(blitz::Array<mgReal, 3> &data, const int colour);
+        void imposePlaneBC(blitz::Array<mgReal, 3> &data, const int iX);
+        void updatePads(blitz::Array<mgReal, 3> &data, const int colour);
+        void updateHalos(blitz::Array<mgReal, 3> &data);
+        void beginPadUpdate(blitz::Array<mgReal, 3> &data, const int colour);
+        void finishPadUpdate(blitz::Array<mgReal, 3> &data, const int colour);
+        void imposeWallBC(blitz::Array<mgReal, 3> &data);
         void createMGSubArrays();
+        void createCoarseSystem();
+        void createGalerkinOperators();
 
         void vCycle();
+        void fmgCycle();
+        void levelCycle(const int cycleType);
+        void computeResidual(const blitz::Array<mgReal, 3> &rhsData);
+        void computeFineResidual();
 
     public:
+        using poisson<mgReal>::pressureData;
+        using poisson<mgReal>::inputRHSData;
+        using poisson<mgReal>::stagFull;
+        using poisson<mgReal>::stagCore;
+        using poisson<mgReal>::cyclesUsed;
+        using poisson<mgReal>::residualNorm;
+        using poisson<mgReal>::ownedCore;
+
         multigrid_d2(const grid &mesh, const parser &solParam);
 
-        void mgSolve(plainsf &inFn, const plainsf &rhs);
+        void mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs);
 
         real testTransfer();
         real testProlong();
         real testPeriodic();
         real testSolve();
 
-        ~multigrid_d2() {};
+        ~multigrid_d2();
 };
 
 /**
@@ -155,13 +375,129 @@ class multigrid_d2: public poisson {
  ********************************************************************************************************************************************
  */
 
-class multigrid_d3: public poisson {
+template <typename mgReal>
+class multigrid_d3: public poisson<mgReal> {
     private:
-        blitz::Array<real, 1> hxhy, hyhz, hzhx, hxhyhz;
+        using poisson<mgReal>::vLevel;
+        using poisson<mgReal>::maxCount;
+        using poisson<mgReal>::fineLevel;
+        using poisson<mgReal>::xStr;
+        using poisson<mgReal>::yStr;
+        using poisson<mgReal>::zStr;
+
+        using poisson<mgReal>::mixedPrecision;
+        using poisson<mgReal>::directCoarse;
+        using poisson<mgReal>::mgDataType;
+
+        using poisson<mgReal>::xEnd;
+        using poisson<mgReal>::yEnd;
+        using poisson<mgReal>::zEnd;
+
+#ifdef TIME_RUN
+        using poisson<mgReal>::solveTimeComp;
+        using poisson<mgReal>::solveTimeTran;
+        using poisson<mgReal>::smothTimeComp;
+        using poisson<mgReal>::smothTimeTran;
+
+#endif
+
+        using poisson<mgReal>::mesh;
+        using poisson<mgReal>::inputParams;
+
+        using poisson<mgReal>::smoothedPres;
+        using poisson<mgReal>::residualData;
+        using poisson<mgReal>::stencilData;
+
+        using poisson<mgReal>::mgSizeArray;
+        using poisson<mgReal>::strideValues;
+        using poisson<mgReal>::localSizeIndex;
+
+        using poisson<mgReal>::recvRequest;
+        using poisson<mgReal>::recvStatus;
+
+        using poisson<mgReal>::sendStatus;
+
+        using poisson<mgReal>::hx;
+        using poisson<mgReal>::hy;
+        using poisson<mgReal>::hz;
+        using poisson<mgReal>::xixx;
+        using poisson<mgReal>::xix2;
+        using poisson<mgReal>::etyy;
+        using poisson<mgReal>::ety2;
+        using poisson<mgReal>::ztzz;
+        using poisson<mgReal>::ztz2;
+        using poisson<mgReal>::xixxCoeff;
+        using poisson<mgReal>::xix2Coeff;
+        using poisson<mgReal>::etyyCoeff;
+        using poisson<mgReal>::ety2Coeff;
+        using poisson<mgReal>::ztzzCoeff;
+        using poisson<mgReal>::ztz2Coeff;
+
+        using poisson<mgReal>::fineSolution;
+        using poisson<mgReal>::fineRHS;
+        using poisson<mgReal>::fineResidual;
+
+        using poisson<mgReal>::xMeshRange;
+        using poisson<mgReal>::yMeshRange;
+        using poisson<mgReal>::zMeshRange;
+
+        using poisson<mgReal>::xMGArray;
+        using poisson<mgReal>::yMGArray;
+        using poisson<mgReal>::xMGRBArray;
+        using poisson<mgReal>::yMGRBArray;
+        using poisson<mgReal>::xMGHalo;
+        using poisson<mgReal>::yMGHalo;
+
+        using poisson<mgReal>::haloLevel;
+
+        using poisson<mgReal>::padSendBuffer;
+        using poisson<mgReal>::padRecvBuffer;
+        using poisson<mgReal>::padSendRequest;
+        using poisson<mgReal>::padRecvRequest;
+
+        using poisson<mgReal>::mgSendLft;
+        using poisson<mgReal>::mgSendRgt;
+        using poisson<mgReal>::mgRecvLft;
+        using poisson<mgReal>::mgRecvRgt;
+        using poisson<mgReal>::mgSendFrn;
+        using poisson<mgReal>::mgSendBak;
+        using poisson<mgReal>::mgRecvFrn;
+        using poisson<mgReal>::mgRecvBak;
+
+        using poisson<mgReal>::setStrides;
+        using poisson<mgReal>::initializeArrays;
+        using poisson<mgReal>::shareCoefficients;
+        using poisson<mgReal>::faceOffset;
+        using poisson<mgReal>::packFace;
+        using poisson<mgReal>::unpackFace;
+        using poisson<mgReal>::removeNullSpace;
+        using poisson<mgReal>::mixedSolve;
+        using poisson<mgReal>::computeNorm;
+        using poisson<mgReal>::solveZLine;
+        using poisson<mgReal>::setProbeOffsets;
+        using poisson<mgReal>::setGlobalIndex;
+        using poisson<mgReal>::factorCoarseSystem;
+        using poisson<mgReal>::directSolve;
+
+        blitz::Array<mgReal, 1> hxhy, hyhz, hzhx, hxhyhz;
+
+        void (multigrid_d3<mgReal>::*residualKernel)(const blitz::Array<mgReal, 3> &rhsData);
+        real (multigrid_d3<mgReal>::*pointKernel)(const int colour, const int sweepRegion);
+        real (multigrid_d3<mgReal>::*checkKernel)(const int colour, const int sweepRegion);
+        void (multigrid_d3<mgReal>::*planeKernel)(const int iX, const int colour, const int padCount);
+        void (multigrid_d3<mgReal>::*lineKernel)(const int iX, const int iY,
+                                                 blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal, blitz::Array<real, 1> &uppDiag,
+                                                 blitz::Array<real, 1> &lineVal);
+
+        void getStencil(const int iX, const int iY, const int iZ, blitz::TinyVector<real, 27> &aVal);
 
         void solve();
+        void coarsen();
         void prolong();
         void smooth(const int smoothCount);
+        void gsSweep(const int colour);
+        real lineSweep(const int colour, const bool findError);
+        void blockSweep(const int sweepCount);
 
         void initMeshRanges();
 
@@ -171,23 +507,52 @@ class multigrid_d3: public poisson {
         void setCoefficients();
         void copyStaggrDerivs();
 
-        void imposeBC();
-        void updatePads();
+        void setKernels();
+        template <bool xUniform, bool yUniform, bool zUniform> void selectKernels();
+
+        template <bool xUniform, bool yUniform, bool zUniform> void residualSweep(const blitz::Array<mgReal, 3> &rhsData);
+        template <bool xUniform, bool yUniform, bool zUniform, bool findError> real pointSweep(const int colour, const int sweepRegion);
+        template <bool xUniform, bool yUniform, bool zUniform> void planeSweep(const int iX, const int colour, const int padCount);
+        template <bool xUniform, bool yUniform, bool zUniform> void lineSystem(const int iX, const int iY,
+                                                                              blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal,
+                                                                              blitz::Array<real, 1> &uppDiag, blitz::Array<real, 1> &lineVal);
+
+        void imposeBC(blitz::Array<mgReal, 3> &data, const int colour);
+        void imposePlaneBC(blitz::Array<mgReal, 3> &data, const int iX);
+        void updatePads(blitz::Array<mgReal, 3> &data, const int colour);
+        void updateHalos(blitz::Array<mgReal, 3> &data);
+        void beginPadUpdate(blitz::Array<mgReal, 3> &data, const int colour);
+        void finishPadUpdate(blitz::Array<mgReal, 3> &data, const int colour);
+        void imposeWallBC(blitz::Array<mgReal, 3> &data);
         void createMGSubArrays();
+        void createCoarseSystem();
+        void createGalerkinOperators();
 
         void vCycle();
+        void fmgCycle();
+        void levelCycle(const int cycleType);
+        void computeResidual(const blitz::Array<mgReal, 3> &rhsData);
+        void computeFineResidual();
 
     public:
+        using poisson<mgReal>::pressureData;
+        using poisson<mgReal>::inputRHSData;
+        using poisson<mgReal>::stagFull;
+        using poisson<mgReal>::stagCore;
+        using poisson<mgReal>::cyclesUsed;
+        using poisson<mgReal>::residualNorm;
+        using poisson<mgReal>::ownedCore;
+
         multigrid_d3(const grid &mesh, const parser &solParam);
 
-        void mgSolve(plainsf &inFn, const plainsf &rhs);
+        void mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs);
 
         real testTransfer();
         real testProlong();
         real testPeriodic();
         real testSolve();
 
-        ~multigrid_d3() {};
+        ~multigrid_d3();
 };
 
 /**
@@ -7,22 +7,28 @@
  *          The constructor of the derived multigrid_d2 class frst calls the base poisson class with the arguments passed to it.
  *          It then calls a series of functions in sequence to initialize all the necessary parameters and data structures to
  *          store and manipulate the multi-grid data.
- *          Since the multi-grid solver operates on the staggered grid, it first computes the limits of the full and core
- *          staggered grid, as the grid class does the same for the collocated grid.
+ *          Since the multi-grid solver operates on the staggered grid, it first computes the strides of each level along every
+ *          direction, followed by the limits of the full and core staggered grid, as the grid class does the same for the collocated grid.
  *
  *          It then initializes all the Range objects to obtain the correct slices of the full grid at various
  *          levels of the V-cycle.
- *          It also copies the staggered grid derivatives to local arrays with wide pads, and finally generates the MPI datatypes
- *          for data transfer between sub-domain boundaries.
+ *          It also copies the staggered grid derivatives at the points of every level to local arrays, allocates the arrays
+ *          for each level of the V-cycle, and generates the MPI datatypes for data transfer between sub-domain boundaries.
+ *          If the Galerkin coarse grid operator is used, the stencils of all the coarser levels are then computed.
+ *          Finally, if the direct solver is used at the coarsest level, the matrix of the coarsest level is assembled and factored.
  *
  * \param   mesh is a const reference to the global data contained in the grid class
  * \param   solParam is a const reference to the user-set parameters contained in the parser class
  ********************************************************************************************************************************************
  */
-multigrid_d2::multigrid_d2(const grid &mesh, const parser &solParam): poisson(mesh, solParam) {
+template <typename mgReal>
+multigrid_d2<mgReal>::multigrid_d2(const grid &mesh, const parser &solParam): poisson<mgReal>(mesh, solParam) {
     // GET THE localSizeIndex AS IT WILL BE USED TO SET THE FULL AND CORE LIMITS OF THE STAGGERED POINTS
     setLocalSizeIndex();
 
+    // SET THE STRIDES OF ALL THE LEVELS ALONG EACH DIRECTION, WHICH DEPEND ON THE localSizeIndex AND THE COARSENING TYPE
+    setStrides();
+
     // SET THE FULL AND CORE LIMTS USING THE localSizeIndex VARIBLE SET ABOVE
     setStagBounds();
 
@@ -35,244 +41,918 @@ multigrid_d2::multigrid_d2(const grid &mesh, const parser &solParam): poisson(me
     // COPY THE STAGGERED GRID DERIVATIVES TO LOCAL ARRAYS
     copyStaggrDerivs();
 
+    // CHOOSE THE KERNELS OF THE LAPLACIAN SPECIALISED FOR THE DIRECTIONS ALONG WHICH THE GRID IS UNIFORM
+    setKernels();
+
     // RESIZE AND INITIALIZE NECESSARY ARRAYS
     initializeArrays();
 
     // CREATE THE MPI SUB-ARRAYS NECESSARY TO TRANSFER DATA ACROSS SUB-DOMAINS AT ALL MESH LEVELS
     createMGSubArrays();
+
+    // COMPUTE THE GALERKIN OPERATORS OF THE COARSER LEVELS ONCE, IF THEY ARE USED INSTEAD OF THE REDISCRETIZED LAPLACIAN
+    if (inputParams.coarseOperator == 1) createGalerkinOperators();
+
+    // ASSEMBLE AND FACTOR THE MATRIX OF THE COARSEST LEVEL ONCE, IF IT IS TO BE SOLVED BY THE DIRECT SOLVER
+    if (directCoarse) createCoarseSystem();
 }
 
-void multigrid_d2::mgSolve(plainsf &inFn, const plainsf &rhs) {
-    pressureData = 0.0;
-    residualData = 0.0;
-    inputRHSData = 0.0;
+template <typename mgReal>
+void multigrid_d2<mgReal>::mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs) {
+    real targetNorm;
 
+    // WITH MIXED PRECISION, THE CYCLES COMPUTE CORRECTIONS TO THE SOLUTION, WHICH IS HELD IN THE PRECISION OF THE FIELDS
+    if (mixedPrecision) {
+        mixedSolve(inFn, rhs);
+        return;
+    }
+
+    vLevel = 0;
+
+    // ONLY THE ARRAYS AT THE FINEST LEVEL NEED TO BE SET HERE. THE ARRAYS AT COARSER LEVELS ARE ALWAYS WRITTEN BEFORE THEY ARE READ
     // TRANSFER DATA FROM THE INPUT SCALAR FIELD INTO THE DATA-STRUCTURES USED BY poisson
-    inputRHSData(stagCore) = rhs.F(stagCore);
+    inputRHSData(0)(stagCore(0)) = rhs.F(stagCore(0));
+
+    if (inputParams.initGuess == 2) {
+        // THE INPUT LHS, INCLUDING ITS PADS, IS USED AS THE INITIAL GUESS, AND THE PADS ARE MADE CONSISTENT WITH THE BOUNDARY CONDITIONS
+        pressureData(0)(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound())) = inFn.F;
+        imposeBC(pressureData(0), 2);
+    } else {
+        pressureData(0) = 0.0;
+    }
+
+    // THE RHS IS MADE COMPATIBLE WITH THE SINGULAR OPERATOR, AND THE MEAN OF THE INITIAL GUESS IS REMOVED
+    removeNullSpace(inputRHSData(0), pressureData(0));
+
+    // THE RELATIVE TOLERANCE IS MEASURED AGAINST THE NORM OF THE RHS, WHICH IS THE RESIDUAL NORM OF A ZERO INITIAL GUESS
+    targetNorm = std::max(inputParams.absTol, inputParams.relTol*computeNorm(inputRHSData(0)));
 
-    // PERFORM V-CYCLES AS MANY TIMES AS REQUIRED
-    for (int i=0; i<inputParams.vcCount; i++) {
-        smoothedPres = 0.0;
-        iteratorTemp = 0.0;
+    computeResidual(inputRHSData(0));
+    residualNorm = computeNorm(residualData(0));
 
+    cyclesUsed = 0;
+
+    // WITH FULL MULTI-GRID, THE SOLUTION IS FIRST BUILT UP FROM THE COARSEST LEVEL, AND THIS PASS IS COUNTED AS ONE CYCLE
+    if (inputParams.initGuess == 1 and residualNorm > targetNorm) {
+        fmgCycle();
+
+        cyclesUsed += 1;
+
+        computeResidual(inputRHSData(0));
+        residualNorm = computeNorm(residualData(0));
+    }
+
+    // PERFORM MULTI-GRID CYCLES UNTIL THE RESIDUAL IS SMALL ENOUGH, OR TILL THE MAXIMUM NUMBER OF CYCLES ARE DONE
+    while (residualNorm > targetNorm and cyclesUsed < inputParams.vcCount) {
         vCycle();
+
+        cyclesUsed += 1;
+
+        computeResidual(inputRHSData(0));
+        residualNorm = computeNorm(residualData(0));
     }
 
+    // THE SOLUTION IS RETURNED WITH ZERO MEAN
+    removeNullSpace(inputRHSData(0), pressureData(0));
+
     // RETURN CALCULATED PRESSURE DATA
-    inFn.F = pressureData(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
+    inFn.F = pressureData(0)(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
 }
 
-void multigrid_d2::vCycle() {
-    int iY = 0;
+template <typename mgReal>
+void multigrid_d2<mgReal>::fmgCycle() {
     vLevel = 0;
 
+    // TRANSFER THE RHS TO ALL THE COARSER LEVELS USING THE SAME RESTRICTION OPERATOR AS USED FOR THE RESIDUAL
+    residualData(0) = inputRHSData(0);
+    for (int i=0; i<inputParams.vcDepth; i++) {
+        coarsen();
+        removeNullSpace(residualData(vLevel), pressureData(vLevel));
+        inputRHSData(vLevel) = residualData(vLevel);
+    }
+
+    // SOLVE AT COARSEST MESH RESOLUTION
+    solve();
+
+    // THE SOLUTION AT EACH LEVEL IS INTERPOLATED TO THE NEXT FINER LEVEL AS ITS INITIAL GUESS, AND IMPROVED WITH ONE CYCLE AT THAT LEVEL
+    for (int i=0; i<inputParams.vcDepth; i++) {
+        prolong();
+        vCycle();
+    }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::vCycle() {
+    // THE CYCLE STARTS FROM THE CURRENT LEVEL, WHICH IS THE FINEST LEVEL EXCEPT DURING FULL MULTI-GRID
+    fineLevel = vLevel;
+
     // PRE-SMOOTHING - SMOOTH FUNCTION OPERATES WITH residualData AS RHS AND pressureData AS LHS.
     // HENCE FOR PRE-SMOOTHING AND POST-SMOOTHING, inputRHSData HAS TO BE WRITTEN INTO residualData TEMPORARILY.
     // ALL SUBSEQUENT SMOOTHING CALLS AUTOMATICALLY OPERATE WITH THE residualData ARRAY.
-    swap(inputRHSData, residualData);
+    swap(inputRHSData(fineLevel), residualData(fineLevel));
     smooth(inputParams.preSmooth);
-    swap(residualData, inputRHSData);
+    swap(residualData(fineLevel), inputRHSData(fineLevel));
     // After above 3 lines, pressureData has the pre-smoothed values of pressure, inputRHSData has original RHS data, and residualData = 0.0
 
+    // CORRECT THE PRE-SMOOTHED PRESSURE FIELD USING THE COARSER LEVELS, VISITING THEM AS PER THE CYCLE TYPE
+    levelCycle(inputParams.cycleType);
+
+    // POST-SMOOTHING
+    swap(inputRHSData(fineLevel), residualData(fineLevel));
+    smooth(inputParams.postSmooth);
+    swap(residualData(fineLevel), inputRHSData(fineLevel));
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::levelCycle(const int cycleType) {
+    int visitCount, subCycleType;
+
+    // THE V-CYCLE VISITS THE COARSER LEVELS ONCE, WHILE THE W AND F-CYCLES VISIT THEM TWICE
+    visitCount = (cycleType == 0)? 1: 2;
+
+    for (int n=0; n<visitCount; n++) {
+        // AT THE FINEST LEVEL OF THE CYCLE, AND AT ALL LEVELS AFTER THE FIRST VISIT, pressureData IS NON-ZERO.
+        // ITS RESIDUAL IS THEN TRANSFERRED TO THE COARSER LEVELS, AND ITS VALUE IS SHIFTED INTO smoothedPres TILL THE CORRECTION IS COMPUTED
+        if (vLevel == fineLevel or n > 0) {
+            if (vLevel == fineLevel) {
+                computeResidual(inputRHSData(vLevel));
+            } else {
+                computeResidual(residualData(vLevel));
+            }
+            swap(smoothedPres(vLevel), pressureData(vLevel));
+        }
+
+        coarsen();
+
+        // THE RESTRICTED RESIDUAL IS MADE COMPATIBLE WITH THE SINGULAR OPERATOR OF THE COARSER LEVEL
+        removeNullSpace(residualData(vLevel), pressureData(vLevel));
+
+        if (vLevel == inputParams.vcDepth) {
+            // SOLVE AT COARSEST MESH RESOLUTION
+            solve();
+        } else {
+            // THE F-CYCLE FOLLOWS ITS FIRST VISIT WITH A V-CYCLE, WHILE THE W-CYCLE RECURSES WITH A W-CYCLE BOTH TIMES
+            subCycleType = (n > 0 and cycleType == 2)? 0: cycleType;
+
+            levelCycle(subCycleType);
+        }
+
+        prolong();
+        smooth(inputParams.interSmooth[inputParams.vcDepth - vLevel - 1]);
+
+        if (vLevel == fineLevel or n > 0) {
+            pressureData(vLevel) += smoothedPres(vLevel);
+        }
+    }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::computeResidual(const blitz::Array<mgReal, 3> &rhsData) {
+    int iY = 0;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    if (inputParams.coarseOperator == 1 and vLevel > 0) {
+        blitz::Array<mgReal, 4> &aData = stencilData(vLevel);
+
+        // APPLY THE 9-POINT STENCIL OF THE GALERKIN OPERATOR TO THE PRESSURE FIELD AND SUBTRACT IT FROM THE RHS
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, pData, rData, rhsData, aData)
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                int sIndx = 0;
+                real aSum = 0.0;
+
+                for (int dX = -1; dX <= 1; dX++) {
+                    for (int dZ = -1; dZ <= 1; dZ++) {
+                        aSum += aData(iX, iY, iZ, sIndx)*pData(iX + dX, iY, iZ + dZ);
+                        sIndx += 1;
+                    }
+                }
+
+                rData(iX, iY, iZ) = rhsData(iX, iY, iZ) - aSum;
+            }
+        }
+
+        return;
+    }
+
     // Compute Laplacian of the pressure field and subtract it from the RHS of Poisson equation to obtain the residual
+    (this->*residualKernel)(rhsData);
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::computeFineResidual() {
+    int iY = 0;
+
+    // THE FINEST LEVEL HAS UNIT STRIDE, AND ITS POINTS ARE THE STAGGERED POINTS OF THE grid CLASS
 #pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY)
-    for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-        for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-            residualData(iX, iY, iZ) =  inputRHSData(iX, iY, iZ) -
-                                       (xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))/(hx(vLevel)*hx(vLevel)) +
-                                        xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))/(2.0*hx(vLevel)) +
-                                        ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX, iY, iZ - strideValues(vLevel)))/(hz(vLevel)*hz(vLevel)) +
-                                        ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))/(2.0*hz(vLevel)));
+    for (int iX = xStr; iX <= xEnd(0); iX++) {
+        for (int iZ = zStr; iZ <= zEnd(0); iZ++) {
+            fineResidual(iX, iY, iZ) =  fineRHS(iX, iY, iZ) -
+                                       (mesh.xix2Staggr(iX) * (fineSolution(iX + 1, iY, iZ) - 2.0*fineSolution(iX, iY, iZ) + fineSolution(iX - 1, iY, iZ))/(mesh.dXi*mesh.dXi) +
+                                        mesh.xixxStaggr(iX) * (fineSolution(iX + 1, iY, iZ) - fineSolution(iX - 1, iY, iZ))/(2.0*mesh.dXi) +
+                                        mesh.ztz2Staggr(iZ) * (fineSolution(iX, iY, iZ + 1) - 2.0*fineSolution(iX, iY, iZ) + fineSolution(iX, iY, iZ - 1))/(mesh.dZt*mesh.dZt) +
+                                        mesh.ztzzStaggr(iZ) * (fineSolution(iX, iY, iZ + 1) - fineSolution(iX, iY, iZ - 1))/(2.0*mesh.dZt));
         }
     }
+}
 
-    // Shift pressureData into smoothedPres
-    swap(smoothedPres, pressureData);
-    // Now pressureData = 0.0 (since smoothedPres was 0.0), and smoothedPres has the pre-smoothed values of pressure
+template <typename mgReal>
+template <bool xUniform, bool zUniform>
+void multigrid_d2<mgReal>::residualSweep(const blitz::Array<mgReal, 3> &rhsData) {
+    int iY = 0;
+    mgReal xCoeff, zCoeff;
 
-    // RESTRICTION OPERATIONS
-    for (int i=0; i<inputParams.vcDepth; i++) {
-        // Direct-injection restriction simply increases the stride for accessing the memory by a factor of 2
-        // This is done by simply increasing the vLevel, which correspondingly reads the correct stride from strideValues array
-        vLevel += 1;
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    xCoeff = xix2Coeff(vLevel, 0);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    // THE POINTS ALONG Z ARE CONTIGUOUS, AND EACH LINE IS SWEPT THROUGH RAW POINTERS SO THAT THE INNERMOST LOOP IS VECTORIZED
+    // THE COEFFICIENTS AND TEMPORARIES ARE OF THE SAME PRECISION AS THE ARRAYS, SO THAT SINGLE PRECISION LEVELS USE THE FULL VECTOR WIDTH
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, pData, rData, rhsData) firstprivate(xCoeff, zCoeff)
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        mgReal x2Coeff = xUniform? xCoeff: xix2Coeff(vLevel, iX);
+        mgReal x1Coeff = xUniform? 0.0: xixxCoeff(vLevel, iX);
+
+        const mgReal *pLine = &pData(iX, iY, 0);
+        const mgReal *xLft = &pData(iX - 1, iY, 0), *xRgt = &pData(iX + 1, iY, 0);
+        const mgReal *z2Line = &ztz2Coeff(vLevel, 0), *z1Line = &ztzzCoeff(vLevel, 0);
+        const mgReal *fLine = &rhsData(iX, iY, 0);
+        mgReal *rLine = &rData(iX, iY, 0);
+
+#pragma omp simd
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+            mgReal lapVal = x2Coeff * (xRgt[iZ] - 2*pLine[iZ] + xLft[iZ]) +
+                            (zUniform? zCoeff: z2Line[iZ]) * (pLine[iZ + 1] - 2*pLine[iZ] + pLine[iZ - 1]);
+
+            if (not xUniform) lapVal += x1Coeff * (xRgt[iZ] - xLft[iZ]);
+            if (not zUniform) lapVal += z1Line[iZ] * (pLine[iZ + 1] - pLine[iZ - 1]);
+
+            rLine[iZ] = fLine[iZ] - lapVal;
+        }
     }
+}
 
-    // SOLVE AT COARSEST MESH RESOLUTION
-    solve();
+template <typename mgReal>
+template <bool xUniform, bool zUniform, bool findError>
+real multigrid_d2<mgReal>::pointSweep(const int colour, const int sweepRegion) {
+    int iY = 0;
+    int faceGap, xStep;
+    mgReal sorParam;
+    mgReal sweepMax;
+    mgReal xCoeff, zCoeff;
 
-    // PROLONGATION OPERATIONS BACK TO FINE MESH
-    for (int i=0; i<inputParams.vcDepth; i++) {
-        prolong();
-        smooth(inputParams.interSmooth[i]);
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    sorParam = inputParams.sorParam;
+
+    xCoeff = xix2Coeff(vLevel, 0);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    // THE STARTING INDEX ALONG Z IS CHOSEN SUCH THAT (iX + iZ) HAS THE SAME PARITY AS colour
+    // SINCE THE POINTS OF ONE COLOUR DEPEND ONLY ON THOSE OF THE OTHER COLOUR, THE UPDATES ALONG A LINE ARE INDEPENDENT AND ARE VECTORIZED
+    // THE INVERSE OF THE DIAGONAL IS COMPUTED ONCE PER LINE WHEN THE GRID IS UNIFORM ALONG Z, AND AT EACH POINT OTHERWISE
+    // sweepRegion SELECTS THE LINES ALONG Z TO BE RELAXED - 0 FOR ALL THE LINES, 1 FOR THE LINES AWAY FROM THE FACES OF THE SUB-DOMAIN
+    // ALONG X, WHICH DO NOT USE THE PADS RECEIVED FROM THE NEIGHBOURING SUB-DOMAINS, AND 2 FOR THE TWO LINES ON THESE FACES
+    // WHEN findError IS SET, THE MAXIMUM ABSOLUTE RESIDUAL AT THE RELAXED POINTS, JUST BEFORE THEY ARE RELAXED, IS RETURNED FOR THE
+    // CONVERGENCE CHECK OF solve. OTHERWISE IT IS NOT COMPUTED, AND THE SMOOTHER RETURNS 0
+    faceGap = (sweepRegion == 1)? 1: 0;
+    xStep = (sweepRegion == 2)? std::max(xEnd(vLevel) - xStr, 1): 1;
+    sweepMax = 0.0;
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, pData, rData) firstprivate(colour, faceGap, xStep, sorParam, xCoeff, zCoeff) reduction(max:sweepMax)
+    for (int iX = xStr + faceGap; iX <= xEnd(vLevel) - faceGap; iX += xStep) {
+        mgReal x2Coeff = xUniform? xCoeff: xix2Coeff(vLevel, iX);
+        mgReal x1Coeff = xUniform? 0.0: xixxCoeff(vLevel, iX);
+
+        mgReal lineCntr = 2*(x2Coeff + zCoeff);
+        mgReal lineDiag = 1/lineCntr;
+
+        mgReal *pLine = &pData(iX, iY, 0);
+        const mgReal *xLft = &pData(iX - 1, iY, 0), *xRgt = &pData(iX + 1, iY, 0);
+        const mgReal *z2Line = &ztz2Coeff(vLevel, 0), *z1Line = &ztzzCoeff(vLevel, 0);
+        const mgReal *rLine = &rData(iX, iY, 0);
+
+#pragma omp simd reduction(max:sweepMax)
+        for (int iZ = zStr + (iX + colour) % 2; iZ <= zEnd(vLevel); iZ += 2) {
+            mgReal z2Coeff = zUniform? zCoeff: z2Line[iZ];
+            mgReal pCntr = zUniform? lineCntr: 2*(x2Coeff + z2Coeff);
+
+            mgReal pSum = x2Coeff * (xRgt[iZ] + xLft[iZ]) +
+                          z2Coeff * (pLine[iZ + 1] + pLine[iZ - 1]) - rLine[iZ];
+
+            if (not xUniform) pSum += x1Coeff * (xRgt[iZ] - xLft[iZ]);
+            if (not zUniform) pSum += z1Line[iZ] * (pLine[iZ + 1] - pLine[iZ - 1]);
+
+            if (findError) sweepMax = std::max(sweepMax, mgReal(fabs(pSum - pCntr * pLine[iZ])));
+
+            pLine[iZ] = (1 - sorParam) * pLine[iZ] + sorParam * pSum * (zUniform? lineDiag: 1/pCntr);
+        }
     }
 
-    pressureData += smoothedPres;
+    return sweepMax;
+}
 
-    // POST-SMOOTHING
-    swap(inputRHSData, residualData);
-    smooth(inputParams.postSmooth);
-    swap(residualData, inputRHSData);
+template <typename mgReal>
+template <bool xUniform, bool zUniform>
+void multigrid_d2<mgReal>::planeSweep(const int iX, const int colour) {
+    int iY = 0;
+    mgReal sorParam;
+    mgReal x2Coeff, x1Coeff, zCoeff, lineDiag;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    sorParam = inputParams.sorParam;
+
+    x2Coeff = xix2Coeff(vLevel, xUniform? 0: iX);
+    x1Coeff = xUniform? 0.0: xixxCoeff(vLevel, iX);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    lineDiag = 1/(2*(x2Coeff + zCoeff));
+
+    mgReal *pLine = &pData(iX, iY, 0);
+    const mgReal *xLft = &pData(iX - 1, iY, 0), *xRgt = &pData(iX + 1, iY, 0);
+    const mgReal *z2Line = &ztz2Coeff(vLevel, 0), *z1Line = &ztzzCoeff(vLevel, 0);
+    const mgReal *rLine = &rData(iX, iY, 0);
+
+    // IN 2D, THE PLANE OF CONSTANT X IS A SINGLE LINE ALONG Z, WHOSE POINTS ARE SHARED AMONG THE THREADS OF THE ENCLOSING PARALLEL
+    // REGION IN blockSweep. THE POINTS ARE RELAXED EXACTLY AS IN pointSweep, WITH THE PARITY TAKEN FROM THE ABSOLUTE VALUE SINCE
+    // THE INDICES OF THE PADS ARE NEGATIVE
+#pragma omp for simd
+    for (int iZ = zStr + std::abs(iX + colour) % 2; iZ <= zEnd(vLevel); iZ += 2) {
+        mgReal z2Coeff = zUniform? zCoeff: z2Line[iZ];
+
+        mgReal pSum = x2Coeff * (xRgt[iZ] + xLft[iZ]) +
+                      z2Coeff * (pLine[iZ + 1] + pLine[iZ - 1]) - rLine[iZ];
+
+        if (not xUniform) pSum += x1Coeff * (xRgt[iZ] - xLft[iZ]);
+        if (not zUniform) pSum += z1Line[iZ] * (pLine[iZ + 1] - pLine[iZ - 1]);
+
+        pLine[iZ] = (1 - sorParam) * pLine[iZ] + sorParam * pSum * (zUniform? lineDiag: 1/(2*(x2Coeff + z2Coeff)));
+    }
+}
+
+template <typename mgReal>
+template <bool xUniform, bool zUniform>
+void multigrid_d2<mgReal>::lineSystem(const int iX,
+                                      blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal, blitz::Array<real, 1> &uppDiag,
+                                      blitz::Array<real, 1> &lineVal) {
+    int iY = 0;
+    real xCoeff, zCoeff;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    // THE COEFFICIENT ALONG X IS CONSTANT ALONG THE LINE, AND ALONG Z IT IS CONSTANT ONLY IF THE GRID IS UNIFORM ALONG Z
+    xCoeff = xix2Coeff(vLevel, iX);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+        if (zUniform) {
+            lowDiag(iZ) = zCoeff;
+            uppDiag(iZ) = zCoeff;
+
+            diagVal(iZ) = -2.0*(xCoeff + zCoeff);
+        } else {
+            lowDiag(iZ) = ztz2Coeff(vLevel, iZ) - ztzzCoeff(vLevel, iZ);
+            uppDiag(iZ) = ztz2Coeff(vLevel, iZ) + ztzzCoeff(vLevel, iZ);
+
+            diagVal(iZ) = -2.0*(xCoeff + ztz2Coeff(vLevel, iZ));
+        }
+
+        lineVal(iZ) = rData(iX, iY, iZ) - xCoeff * (pData(iX + 1, iY, iZ) + pData(iX - 1, iY, iZ));
+
+        if (not xUniform) lineVal(iZ) -= xixxCoeff(vLevel, iX) * (pData(iX + 1, iY, iZ) - pData(iX - 1, iY, iZ));
+    }
 }
 
-void multigrid_d2::smooth(const int smoothCount) {
-    iteratorTemp = 0.0;
+template <typename mgReal>
+void multigrid_d2<mgReal>::smooth(const int smoothCount) {
+    int colourCount, sweepCount;
+    bool splitSweep, padsPending;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+
+    // IMPOSE BOUNDARY CONDITION ON ALL THE POINTS BEFORE THE FIRST SWEEP
+    // AT THE LEVELS USING DEEP PADS, THE RHS IS ALSO NEEDED AT THE POINTS OF THE PADS, WHICH ARE RELAXED ALONG WITH THE CORE
+    imposeBC(pData, haloLevel(vLevel)? 3: 2);
+    if (haloLevel(vLevel)) updatePads(residualData(vLevel), 3);
+
+    // THE 9-POINT STENCIL OF THE GALERKIN OPERATOR ALSO COUPLES THE DIAGONAL NEIGHBOURS, WHICH HAVE THE SAME RED-BLACK COLOUR.
+    // HENCE AT THE LEVELS USING IT, THE POINTS ARE RELAXED IN 4 COLOURS, UPDATING ALL THE PADS AFTER EACH COLOUR.
+    // THE LINES ALONG Z ARE STILL COUPLED ONLY TO THE ADJACENT LINES, AND NEED ONLY 2 COLOURS
+    colourCount = 2;
+    if (inputParams.coarseOperator == 1 and vLevel > 0 and inputParams.smoothType == 0) colourCount = 4;
+
+    // WITH THE RED-BLACK POINT SMOOTHER, THE PADS OF EACH COLOUR ARE TRANSFERRED WHILE THE INTERIOR POINTS OF THE NEXT COLOUR ARE RELAXED
+    splitSweep = (inputParams.smoothType == 0 and colourCount == 2);
+    padsPending = false;
+
+    for(int n=0; n<smoothCount; n += sweepCount) {
+        // WITH THE RED-BLACK POINT SMOOTHER, UP TO sweepBlock CONSECUTIVE SWEEPS ARE FUSED INTO A SINGLE PASS OVER THE LEVEL
+        sweepCount = 1;
+        if (inputParams.smoothType == 0 and colourCount == 2) sweepCount = std::min(inputParams.sweepBlock, smoothCount - n);
+
+        if (sweepCount > 1) {
+            blockSweep(sweepCount);
+
+            // THE PADS RECEIVED FROM THE NEIGHBOURING SUB-DOMAINS ARE UPDATED ONLY AFTER ALL THE SWEEPS OF THE BLOCK
+            imposeBC(pData, haloLevel(vLevel)? 3: 2);
+
+        } else {
+            // RELAX THE RED POINTS (OR LINES) FIRST, AND THEN THE BLACK POINTS (OR LINES) USING THE UPDATED RED ONES
+            for (int colour=0; colour<colourCount; colour++) {
+                if (splitSweep) {
+                    // THE POINTS ON THE FACES OF THE SUB-DOMAIN ARE RELAXED ONLY AFTER THE PADS OF THE OTHER COLOUR HAVE ARRIVED
+                    (this->*pointKernel)(colour, 1);
+                    if (padsPending) {
+                        finishPadUpdate(pData, 1 - colour);
+                        imposeWallBC(pData);
+                    }
+                    (this->*pointKernel)(colour, 2);
+
+                } else if (inputParams.smoothType == 0) {
+                    gsSweep(colour);
+                } else {
+                    lineSweep(colour, false);
+                }
 
-    for(int n=0; n<smoothCount; n++) {
-        // IMPOSE BOUNDARY CONDITION
-        imposeBC();
+                // IMPOSE BOUNDARY CONDITION ON THE POINTS OF THE COLOUR THAT WAS JUST RELAXED
+                // WHEN THE SWEEP IS SPLIT, ONLY THE PADS ALONG Z, WHICH ARE NEEDED BY THE INTERIOR POINTS, ARE SET BEFORE THE NEXT COLOUR
+                if (splitSweep) {
+                    beginPadUpdate(pData, colour);
+                    padsPending = true;
 
-        int iY = 0;
-#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY)
-        for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-            for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                iteratorTemp(iX, iY, iZ) = (hz2(vLevel) * xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))*2.0 +
-                                            hz2(vLevel) * xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))*hx(vLevel) +
-                                            hx2(vLevel) * ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) + pressureData(iX, iY, iZ - strideValues(vLevel)))*2.0 +
-                                            hx2(vLevel) * ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))*hz(vLevel) -
-                                      2.0 * hzhx(vLevel) * residualData(iX, iY, iZ))/
-                                    (4.0 * (hz2(vLevel)*xix2(iX) + hx2(vLevel)*ztz2(iZ)));
+                    pData(xMeshRange(vLevel), 0, -1) = pData(xMeshRange(vLevel), 0, inputParams.zPer? zEnd(vLevel) - 1: 1);
+                    pData(xMeshRange(vLevel), 0, zEnd(vLevel) + 1) = pData(xMeshRange(vLevel), 0, inputParams.zPer? 1: zEnd(vLevel) - 1);
+                } else {
+                    imposeBC(pData, (colourCount == 2)? colour: 2);
+                }
             }
         }
+    }
 
-        swap(iteratorTemp, pressureData);
+    // THE TRANSFER STARTED AFTER THE LAST COLOUR IS COMPLETED BEFORE THE PADS ARE USED OUTSIDE THE SMOOTHER
+    if (padsPending) {
+        finishPadUpdate(pData, 1);
+        imposeWallBC(pData);
     }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::blockSweep(const int sweepCount) {
+    int stepCount, padDepth;
+    bool lftWall, rgtWall;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+
+    // AT THE LEVELS USING DEEP PADS, THE FIRST HALF-SWEEP ALSO RELAXES (2 x sweepCount - 1) LINES OF THE PADS SHARED WITH THE
+    // NEIGHBOURING SUB-DOMAINS, AND EACH SUBSEQUENT HALF-SWEEP RELAXES ONE LINE LESS. THE PADS FACING THE WALLS ARE NEVER RELAXED
+    padDepth = haloLevel(vLevel)? 2*sweepCount - 1: 0;
+
+    lftWall = (not inputParams.xPer and mesh.rankData.xRank == 0);
+    rgtWall = (not inputParams.xPer and mesh.rankData.xRank == mesh.rankData.npX - 1);
 
-    imposeBC();
+    // AT STEP wStep OF THE WAVEFRONT, THE HALF-SWEEP hSweep RELAXES THE LINE iX = xStr - padDepth + wStep - hSweep, WITH THE RED AND
+    // BLACK HALF-SWEEPS ALTERNATING. SINCE THE HALF-SWEEPS OF A STEP ARE PERFORMED IN INCREASING ORDER, EACH LINE IS RELAXED ONLY AFTER
+    // ITS NEIGHBOURING LINES HAVE BEEN RELAXED BY THE PREVIOUS HALF-SWEEP, AND BEFORE THEY ARE RELAXED BY THE NEXT ONE
+    stepCount = xEnd(vLevel) - xStr + 2*padDepth + 2*sweepCount;
+
+    // THE THREADS SHARE THE POINTS OF EACH LINE, AND WAIT FOR ONE ANOTHER BEFORE MOVING TO THE NEXT LINE
+#pragma omp parallel num_threads(inputParams.nThreads) default(none) shared(pData) firstprivate(sweepCount, stepCount, padDepth, lftWall, rgtWall)
+    {
+        for (int wStep = 0; wStep < stepCount; wStep++) {
+            for (int hSweep = 0; hSweep < 2*sweepCount; hSweep++) {
+                int padCount = std::max(padDepth - hSweep, 0);
+
+                int iX = xStr - padDepth + wStep - hSweep;
+                if (iX < xStr - (lftWall? 0: padCount) or iX > xEnd(vLevel) + (rgtWall? 0: padCount)) continue;
+
+                (this->*planeKernel)(iX, hSweep % 2);
+
+#pragma omp single
+                imposePlaneBC(pData, iX);
+            }
+        }
+    }
 }
 
-void multigrid_d2::solve() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::gsSweep(const int colour) {
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    int iY = 0;
+
+    if (inputParams.coarseOperator == 1 and vLevel > 0) {
+        blitz::Array<mgReal, 4> &aData = stencilData(vLevel);
+
+        // THE 4 COLOURS OF THE GALERKIN OPERATOR ARE GIVEN BY THE PARITIES OF iX AND iZ. THE CENTRAL ENTRY OF THE STENCIL IS AT INDEX 4
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, pData, rData, aData) firstprivate(colour)
+        for (int iX = xStr + colour/2; iX <= xEnd(vLevel); iX += 2) {
+            for (int iZ = zStr + colour % 2; iZ <= zEnd(vLevel); iZ += 2) {
+                int sIndx = 0;
+                real aSum = rData(iX, iY, iZ);
+
+                for (int dX = -1; dX <= 1; dX++) {
+                    for (int dZ = -1; dZ <= 1; dZ++) {
+                        if (sIndx != 4) aSum -= aData(iX, iY, iZ, sIndx)*pData(iX + dX, iY, iZ + dZ);
+                        sIndx += 1;
+                    }
+                }
+
+                pData(iX, iY, iZ) = (1.0 - inputParams.sorParam) * pData(iX, iY, iZ) + inputParams.sorParam * aSum/aData(iX, iY, iZ, 4);
+            }
+        }
+
+        return;
+    }
+
+    (this->*pointKernel)(colour, 0);
+}
+
+template <typename mgReal>
+real multigrid_d2<mgReal>::lineSweep(const int colour, const bool findError) {
+    int iY = 0;
+    bool galerkinLevel;
+    real sweepMax;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    galerkinLevel = (inputParams.coarseOperator == 1 and vLevel > 0);
+
+    sweepMax = 0.0;
+
+    // EACH THREAD NEEDS ITS OWN ARRAYS TO HOLD THE TRIDIAGONAL SYSTEM OF THE LINE IT IS SOLVING
+    // THE STARTING INDEX ALONG X IS CHOSEN SUCH THAT iX HAS THE SAME PARITY AS colour
+#pragma omp parallel num_threads(inputParams.nThreads) default(none) shared(iY, pData, rData, galerkinLevel) firstprivate(colour, findError) reduction(max:sweepMax)
+    {
+        blitz::Array<real, 1> lowDiag(zEnd(vLevel) + 1), diagVal(zEnd(vLevel) + 1), uppDiag(zEnd(vLevel) + 1);
+        blitz::Array<real, 1> lineVal(zEnd(vLevel) + 1), workVal(zEnd(vLevel) + 1), corrVal(zEnd(vLevel) + 1);
+
+#pragma omp for
+        for (int iX = xStr + (xStr + colour) % 2; iX <= xEnd(vLevel); iX += 2) {
+            if (galerkinLevel) {
+                blitz::Array<mgReal, 4> &aData = stencilData(vLevel);
+
+                // THE ENTRIES AT INDICES 3, 4 AND 5 OF THE STENCIL COUPLE THE POINTS ALONG THE LINE
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    lowDiag(iZ) = aData(iX, iY, iZ, 3);
+                    diagVal(iZ) = aData(iX, iY, iZ, 4);
+                    uppDiag(iZ) = aData(iX, iY, iZ, 5);
+
+                    lineVal(iZ) = rData(iX, iY, iZ);
+                    for (int dZ = -1; dZ <= 1; dZ++) {
+                        lineVal(iZ) -= aData(iX, iY, iZ, dZ + 1)*pData(iX - 1, iY, iZ + dZ) + aData(iX, iY, iZ, dZ + 7)*pData(iX + 1, iY, iZ + dZ);
+                    }
+                }
+            } else {
+                (this->*lineKernel)(iX, lowDiag, diagVal, uppDiag, lineVal);
+            }
+
+            // AS IN pointSweep, THE RESIDUAL AT THE POINTS OF THE LINE IS FOUND FROM THE SYSTEM OF THE LINE BEFORE THEY ARE RELAXED
+            if (findError) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    sweepMax = std::max(sweepMax, real(fabs(lineVal(iZ) - lowDiag(iZ)*pData(iX, iY, iZ - 1) - diagVal(iZ)*pData(iX, iY, iZ) -
+                                                            uppDiag(iZ)*pData(iX, iY, iZ + 1))));
+                }
+            }
+
+            solveZLine(lowDiag, diagVal, uppDiag, lineVal, workVal, corrVal);
+
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                pData(iX, iY, iZ) = (1.0 - inputParams.sorParam) * pData(iX, iY, iZ) + inputParams.sorParam * lineVal(iZ);
+            }
+
+            // THE PADS ALONG Z ARE SET AS PER THE BOUNDARY CONDITIONS USED IN solveZLine, SINCE THE COARSEST LEVEL SOLVER DOES NOT IMPOSE THEM
+            pData(iX, iY, -1) = inputParams.zPer? pData(iX, iY, zEnd(vLevel) - 1): pData(iX, iY, 1);
+            pData(iX, iY, zEnd(vLevel) + 1) = inputParams.zPer? pData(iX, iY, 1): pData(iX, iY, zEnd(vLevel) - 1);
+        }
+    }
+
+    return sweepMax;
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::solve() {
     int iY = 0;
     int iterCount = 0;
-    real tempValue;
+    int colourCount;
+    bool splitSweep, padsPending, checkPending;
+    real sweepMax, redMax, blackMax, blackLast;
     real localMax, globalMax;
 
+    MPI_Request checkRequest;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    // THE LU FACTORS OF THE DIRECT SOLVER ARE AVAILABLE ONLY FOR THE COARSEST LEVEL OF THE V-CYCLE
+    if (directCoarse and vLevel == inputParams.vcDepth) {
+        directSolve();
+        return;
+    }
+
+    // THE NUMBER OF COLOURS IS THE SAME AS IN smooth
+    colourCount = 2;
+    if (inputParams.coarseOperator == 1 and vLevel > 0 and inputParams.smoothType == 0) colourCount = 4;
+
+    // AS IN smooth, THE PADS OF THE RED POINTS ARE TRANSFERRED WHILE THE INTERIOR BLACK POINTS ARE RELAXED, AND THE PADS OF THE BLACK
+    // POINTS ARE TRANSFERRED WHILE THE INTERIOR RED POINTS OF THE NEXT ITERATION ARE RELAXED
+    splitSweep = (inputParams.smoothType == 0 and colourCount == 2);
+    padsPending = false;
+    checkPending = false;
+
+    redMax = blackMax = blackLast = 0.0;
+
     while (true) {
-        // JACOBI ITERATIVE SOLVER
-#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY)
-        for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-            for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                iteratorTemp(iX, iY, iZ) = (hz2(vLevel) * xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))*2.0 +
-                                            hz2(vLevel) * xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))*hx(vLevel) +
-                                            hx2(vLevel) * ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) + pressureData(iX, iY, iZ - strideValues(vLevel)))*2.0 +
-                                            hx2(vLevel) * ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))*hz(vLevel) -
-                                      2.0 * hzhx(vLevel) * residualData(iX, iY, iZ))/
-                                    (4.0 * (hz2(vLevel)*xix2(iX) + hx2(vLevel)*ztz2(iZ)));
+        // RED-BLACK (OR MULTI-COLOUR) GAUSS-SEIDEL ITERATIVE SOLVER, RELAXING EITHER POINTS OR LINES ALONG Z
+        for (int colour=0; colour<colourCount; colour++) {
+            if (splitSweep) {
+                sweepMax = (this->*checkKernel)(colour, 1);
+                if (padsPending) {
+                    finishPadUpdate(pData, 1 - colour);
+                    imposeWallBC(pData);
+                }
+                sweepMax = std::max(sweepMax, (this->*checkKernel)(colour, 2));
+
+                if (colour == 0) redMax = sweepMax; else blackMax = sweepMax;
+
+            } else if (inputParams.smoothType == 0) {
+                gsSweep(colour);
+            } else {
+                // THE LINES GIVE THE RESIDUAL AT THEIR POINTS BEFORE THEY ARE RELAXED, JUST AS THE SPLIT POINT SWEEPS DO
+                sweepMax = lineSweep(colour, true);
+
+                if (colour == 0) redMax = sweepMax; else blackMax = sweepMax;
+            }
+
+            // THE BOUNDARY CONDITIONS ARE IMPOSED AS IN smooth, SINCE THE PADS ALONG Z AND AT THE WALLS ARE READ BY THE NEXT COLOUR
+            // WHEN THE SWEEP IS SPLIT, ONLY THE PADS ALONG Z, WHICH ARE NEEDED BY THE INTERIOR POINTS, ARE SET BEFORE THE NEXT COLOUR
+            if (splitSweep) {
+                beginPadUpdate(pData, colour);
+                padsPending = true;
+
+                pData(xMeshRange(vLevel), 0, -1) = pData(xMeshRange(vLevel), 0, inputParams.zPer? zEnd(vLevel) - 1: 1);
+                pData(xMeshRange(vLevel), 0, zEnd(vLevel) + 1) = pData(xMeshRange(vLevel), 0, inputParams.zPer? 1: zEnd(vLevel) - 1);
+            } else {
+                imposeBC(pData, (colourCount == 2)? colour: 2);
             }
         }
 
-        swap(iteratorTemp, pressureData);
+        // THE REDUCTION STARTED AT THE PREVIOUS CHECK HAS PROCEEDED WHILE THE ABOVE ITERATION WAS PERFORMED
+        // IT IS COMPLETED AT THE SAME ITERATION ON ALL THE RANKS, SO THAT THEY ALL STOP TOGETHER
+        if (checkPending) {
+            MPI_Wait(&checkRequest, MPI_STATUS_IGNORE);
+            checkPending = false;
 
-        // Only the pads within the domain at the sub-domain boundaries are updated here.
-        // Boundary conditions are *NOT* applied while solving at the coarsest level.
-        // Boundary conditions are applied only while smoothing the solution.
-        updatePads();
+            if (globalMax < inputParams.tolerance) {
+                break;
+            }
+        }
 
-        // Compute the Laplacian of pressure field and subtract the residual. Find the maximum of the absolute value of this difference
-        tempValue = 0.0;
-        localMax = -1.0e-10;
+        iterCount += 1;
+        if (iterCount > maxCount) {
+            if (mesh.rankData.rank == 0) std::cout << "ERROR: Gauss-Seidel iterations for solution at coarsest level not converging. Aborting" << std::endl;
 
+            MPI_Finalize();
+            exit(0);
+        }
+
+        // Find the maximum of the absolute value of the residual once every inputParams.checkInterval iterations
+        // When it is found within the sweeps, it is available only from the second iteration, since it lags by one iteration
         // Problem with Koenig lookup is that when using the function abs with blitz arrays, it automatically computes
         // the absolute of the float values without hitch.
         // When replacing with computing absolute of individual array elements in a loop, ADL chooses a version of
         // abs in the STL which **rounds off** the number.
         // In this case, abs has to be replaced with fabs.
-        for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-            for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                tempValue = fabs((xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))/(hx(vLevel)*hx(vLevel)) +
-                                  xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))/(2.0*hx(vLevel)) +
-                                  ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX, iY, iZ - strideValues(vLevel)))/(hz(vLevel)*hz(vLevel)) +
-                                  ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))/(2.0*hz(vLevel))) - residualData(iX, iY, iZ));
-
-                if (tempValue > localMax) {
-                    localMax = tempValue;
+        if (iterCount % inputParams.checkInterval == 0 and not (colourCount == 2 and iterCount == 1)) {
+            if (colourCount == 2) {
+                // THE RED SWEEP GIVES THE RESIDUAL AT THE RED POINTS OF THE SOLUTION LEFT BY THE PREVIOUS ITERATION. THE BLACK SWEEP OF THAT
+                // ITERATION GAVE THE RESIDUAL AT THE BLACK POINTS BEFORE THEY WERE RELAXED, WHICH THE RELAXATION SCALED BY (1 - SOR PARAMETER)
+                localMax = std::max(redMax, real(fabs(1.0 - inputParams.sorParam))*blackLast);
+            } else {
+                localMax = 0.0;
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, pData, rData) reduction(max:localMax)
+                for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                    blitz::TinyVector<real, 9> aVal;
+
+                    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                        getStencil(iX, iZ, aVal);
+
+                        real tempValue = -rData(iX, iY, iZ);
+                        for (int dX = -1; dX <= 1; dX++) {
+                            for (int dZ = -1; dZ <= 1; dZ++) {
+                                tempValue += aVal(3*(dX + 1) + dZ + 1)*pData(iX + dX, iY, iZ + dZ);
+                            }
+                        }
+
+                        localMax = std::max(localMax, real(fabs(tempValue)));
+                    }
                 }
             }
+
+            MPI_Iallreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD, &checkRequest);
+            checkPending = true;
         }
 
-        MPI_Allreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD);
-        if (globalMax < inputParams.tolerance) {
-            break;
+        blackLast = blackMax;
+    }
+
+    // THE PADS OF THE BLACK POINTS OF THE LAST ITERATION ARE RECEIVED BEFORE THE SOLUTION IS USED FURTHER
+    if (padsPending) {
+        finishPadUpdate(pData, 1);
+        imposeWallBC(pData);
+    }
+
+    // THE ITERATIONS LEAVE THE MEAN OF THE SOLUTION UNDETERMINED, AND IT IS PINNED TO ZERO
+    removeNullSpace(rData, pData);
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::coarsen() {
+    int iY = 0;
+    int xRatio, zRatio;
+
+    blitz::Array<mgReal, 3> &rFine = residualData(vLevel);
+    blitz::Array<mgReal, 3> &rCors = residualData(vLevel + 1);
+
+    // RATIO OF THE STRIDES OF THE COARSER AND FINER LEVELS ALONG EACH DIRECTION. IT IS 1 ALONG A DIRECTION WHICH IS NOT COARSENED
+    xRatio = strideValues(vLevel + 1, 0)/strideValues(vLevel, 0);
+    zRatio = strideValues(vLevel + 1, 2)/strideValues(vLevel, 2);
+
+    if (inputParams.restrictOp == 1) {
+        // FULL-WEIGHTING NEEDS THE RESIDUAL AT THE PADS (INCLUDING CORNERS) OF THE FINER LEVEL
+        imposeBC(rFine, 2);
+
+        vLevel += 1;
+
+        if (xRatio == 2 and zRatio == 2) {
+            // FULL-WEIGHTING - TENSOR PRODUCT OF THE 1D WEIGHTS (1/4, 1/2, 1/4) OVER THE 9 POINTS AROUND EACH COINCIDENT POINT
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, rFine, rCors)
+            for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    int i2 = 2*iX;
+                    int k2 = 2*iZ;
+
+                    rCors(iX, iY, iZ) = (4.0*rFine(i2, iY, k2) +
+                                         2.0*(rFine(i2 + 1, iY, k2) + rFine(i2 - 1, iY, k2) + rFine(i2, iY, k2 + 1) + rFine(i2, iY, k2 - 1)) +
+                                              rFine(i2 + 1, iY, k2 + 1) + rFine(i2 + 1, iY, k2 - 1) + rFine(i2 - 1, iY, k2 + 1) + rFine(i2 - 1, iY, k2 - 1))/16.0;
+                }
+            }
+
+        } else {
+            // SEMI-COARSENED FULL-WEIGHTING - THE 1D WEIGHTS ARE (1/4, 1/2, 1/4) ALONG A COARSENED DIRECTION, AND 1 ALONG THE OTHER
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, xRatio, zRatio, rFine, rCors)
+            for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    real rSum = 0.0;
+
+                    for (int dX = 1 - xRatio; dX <= xRatio - 1; dX++) {
+                        for (int dZ = 1 - zRatio; dZ <= zRatio - 1; dZ++) {
+                            rSum += (xRatio - abs(dX))*(zRatio - abs(dZ))*rFine(xRatio*iX + dX, iY, zRatio*iZ + dZ);
+                        }
+                    }
+
+                    rCors(iX, iY, iZ) = rSum/(xRatio*xRatio*zRatio*zRatio);
+                }
+            }
         }
 
-        MPI_Barrier(MPI_COMM_WORLD);
-        iterCount += 1;
-        if (iterCount > maxCount) {
-            if (mesh.rankData.rank == 0) std::cout << "ERROR: Jacobi iterations for solution at coarsest level not converging. Aborting" << std::endl;
+    } else {
+        vLevel += 1;
 
-            MPI_Finalize();
-            exit(0);
+        // DIRECT INJECTION - THE COINCIDENT POINTS OF THE FINER LEVEL ARE COPIED INTO THE CONTIGUOUS ARRAY OF THE COARSER LEVEL
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, xRatio, zRatio, rFine, rCors)
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                rCors(iX, iY, iZ) = rFine(xRatio*iX, iY, zRatio*iZ);
+            }
         }
     }
+
+    // THE CORRECTION COMPUTED AT THE COARSER LEVEL STARTS FROM A ZERO INITIAL GUESS
+    pressureData(vLevel) = 0.0;
 }
 
-void multigrid_d2::prolong() {
-    // Integer values of starting indices, ending indices, and index increments along each direction
+template <typename mgReal>
+void multigrid_d2<mgReal>::prolong() {
     int iY = 0;
-    int xSt, xEn, xIn;
-    int zSt, zEn, zIn;
+    int xRatio, zRatio;
 
     vLevel -= 1;
 
+    // RATIO OF THE STRIDES OF THE COARSER AND FINER LEVELS ALONG EACH DIRECTION. IT IS 1 ALONG A DIRECTION WHICH IS NOT COARSENED
+    xRatio = strideValues(vLevel + 1, 0)/strideValues(vLevel, 0);
+    zRatio = strideValues(vLevel + 1, 2)/strideValues(vLevel, 2);
+
+    blitz::Array<mgReal, 3> &pFine = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &pCors = pressureData(vLevel + 1);
+
     // NOTE: Currently interpolting along X first, and then Z.
     // Test and see if this order is better or the other order, with Z first, and then X is better
     // Depending on the order of variables in memory, one of these will give better performance
 
-    // Maybe the below values can be stored in some array instead of recomputing in each prolongation step
+    // COPY THE POINTS OF THE COARSER LEVEL ONTO THE COINCIDENT POINTS OF THE FINER LEVEL
+    for (int iX = xStr; iX <= xEnd(vLevel + 1); iX++) {
+        for (int iZ = zStr; iZ <= zEnd(vLevel + 1); iZ++) {
+            pFine(xRatio*iX, iY, zRatio*iZ) = pCors(iX, iY, iZ);
+        }
+    }
 
-    // INTERPOLATE VARIABLE DATA ALONG X-DIRECTION
-    xSt = stagCore.lbound(0) + strideValues(vLevel);
-    xEn = stagCore.ubound(0) - strideValues(vLevel);
-    xIn = strideValues(vLevel+1);
+    if (inputParams.coarseOperator == 1) {
+        // OPERATOR-DEPENDENT INTERPOLATION - EACH NON-COINCIDENT POINT SATISFIES THE HOMOGENEOUS EQUATION OF THE FINER LEVEL, WITH ITS
+        // STENCIL COLLAPSED ALONG THE DIRECTION IN WHICH ITS INDEX IS EVEN. THE POINTS WITH ONE ODD INDEX ARE INTERPOLATED FIRST,
+        // FOLLOWED BY THOSE WITH TWO ODD INDICES, SO THAT ALL THE NEIGHBOURS USED BY A POINT ARE ALREADY AVAILABLE
+        for (int oddCount = 1; oddCount <= 2; oddCount++) {
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(iY, xRatio, zRatio, pFine) firstprivate(oddCount)
+            for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    int oX = (xRatio == 2)? iX % 2: 0;
+                    int oZ = (zRatio == 2)? iZ % 2: 0;
+
+                    if (oX + oZ != oddCount) continue;
+
+                    real cSum = 0.0;
+                    real nSum = 0.0;
+                    blitz::TinyVector<real, 9> aVal;
+
+                    getStencil(iX, iZ, aVal);
+
+                    for (int dX = -1; dX <= 1; dX++) {
+                        for (int dZ = -1; dZ <= 1; dZ++) {
+                            if (oX*dX == 0 and oZ*dZ == 0) {
+                                cSum += aVal(3*(dX + 1) + dZ + 1);
+                            } else {
+                                nSum += aVal(3*(dX + 1) + dZ + 1)*pFine(iX + oX*dX, iY, iZ + oZ*dZ);
+                            }
+                        }
+                    }
+
+                    pFine(iX, iY, iZ) = -nSum/cSum;
+                }
+            }
+        }
 
-    zSt = stagCore.lbound(2);
-    zEn = stagCore.ubound(2);
-    zIn = strideValues(vLevel+1);
+        return;
+    }
 
-    for (int iX = xSt; iX <= xEn; iX += xIn) {
-        for (int iZ = zSt; iZ <= zEn; iZ += zIn) {
-            pressureData(iX, iY, iZ) = (pressureData(iX + strideValues(vLevel), iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))/2.0;
-            residualData(iX, iY, iZ) = (residualData(iX + strideValues(vLevel), iY, iZ) + residualData(iX - strideValues(vLevel), iY, iZ))/2.0;
+    // INTERPOLATE VARIABLE DATA ALONG X-DIRECTION, IF IT WAS COARSENED
+    if (xRatio == 2) {
+        for (int iX = xStr + 1; iX <= xEnd(vLevel) - 1; iX += 2) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ += zRatio) {
+                pFine(iX, iY, iZ) = (pFine(iX + 1, iY, iZ) + pFine(iX - 1, iY, iZ))/2.0;
+            }
         }
     }
 
-    // INTERPOLATE VARIABLE DATA ALONG Z-DIRECTION
-    xSt = stagCore.lbound(0);
-    xEn = stagCore.ubound(0);
-    xIn = strideValues(vLevel);
-
-    zSt = stagCore.lbound(2) + strideValues(vLevel);
-    zEn = stagCore.ubound(2) - strideValues(vLevel);
-    zIn = strideValues(vLevel+1);
-
-    for (int iX = xSt; iX <= xEn; iX += xIn) {
-        for (int iZ = zSt; iZ <= zEn; iZ += zIn) {
-            pressureData(iX, iY, iZ) = (pressureData(iX, iY, iZ + strideValues(vLevel)) + pressureData(iX, iY, iZ - strideValues(vLevel)))/2.0;
-            residualData(iX, iY, iZ) = (residualData(iX, iY, iZ + strideValues(vLevel)) + residualData(iX, iY, iZ - strideValues(vLevel)))/2.0;
+    // INTERPOLATE VARIABLE DATA ALONG Z-DIRECTION, IF IT WAS COARSENED
+    if (zRatio == 2) {
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iZ = zStr + 1; iZ <= zEnd(vLevel) - 1; iZ += 2) {
+                pFine(iX, iY, iZ) = (pFine(iX, iY, iZ + 1) + pFine(iX, iY, iZ - 1))/2.0;
+            }
         }
     }
 }
 
-void multigrid_d2::setLocalSizeIndex() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::setLocalSizeIndex() {
     localSizeIndex = blitz::TinyVector<int, 3>(mesh.sizeIndex(0) - int(log2(inputParams.npX)),
                                                mesh.sizeIndex(1),
                                                mesh.sizeIndex(2));
 }
 
-void multigrid_d2::setStagBounds() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::setStagBounds() {
     blitz::TinyVector<int, 3> loBound, upBound;
 
-    // LOWER BOUND AND UPPER BOUND OF STAGGERED CORE - USED TO CONSTRUCT THE CORE SLICE
-    loBound = 0, 0, 0;
-    upBound = mgSizeArray(localSizeIndex(0)) - 1, 0, mgSizeArray(localSizeIndex(2)) - 1;
-    stagCore = blitz::RectDomain<3>(loBound, upBound);
+    stagCore.resize(inputParams.vcDepth + 1);
+    stagFull.resize(inputParams.vcDepth + 1);
 
-    // LOWER BOUND AND UPPER BOUND OF STAGGERED FULL SUB-DOMAIN - USED TO CONSTRUCT THE FULL SUB-DOMAIN SLICE
-    loBound = -strideValues(inputParams.vcDepth), -1, -strideValues(inputParams.vcDepth);
-    upBound = stagCore.ubound() - loBound;
-    stagFull = blitz::RectDomain<3>(loBound, upBound);
+    for (int i=0; i<=inputParams.vcDepth; i++) {
+        // LOWER BOUND AND UPPER BOUND OF STAGGERED CORE - USED TO CONSTRUCT THE CORE SLICE
+        loBound = 0, 0, 0;
+        upBound = (mgSizeArray(localSizeIndex(0)) - 1)/strideValues(i, 0), 0, (mgSizeArray(localSizeIndex(2)) - 1)/strideValues(i, 2);
+        stagCore(i) = blitz::RectDomain<3>(loBound, upBound);
+
+        // LOWER BOUND AND UPPER BOUND OF STAGGERED FULL SUB-DOMAIN - USED TO CONSTRUCT THE FULL SUB-DOMAIN SLICE
+        // THE PADS ALONG X ARE haloDepth POINTS DEEP, WHILE ALONG Z, WHICH IS NEVER DECOMPOSED, THEY ARE ALWAYS 1 POINT DEEP
+        loBound = -inputParams.haloDepth, 0, -1;
+        upBound = stagCore(i).ubound() - loBound;
+        stagFull(i) = blitz::RectDomain<3>(loBound, upBound);
+    }
 }
 
-void multigrid_d2::setCoefficients() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::setCoefficients() {
     hx.resize(inputParams.vcDepth + 1);
     hz.resize(inputParams.vcDepth + 1);
 
@@ -282,194 +962,577 @@ void multigrid_d2::setCoefficients() {
     hzhx.resize(inputParams.vcDepth + 1);
 
     for(int i=0; i<=inputParams.vcDepth; i++) {
-        hx(i) = strideValues(i)*mesh.dXi;
-        hz(i) = strideValues(i)*mesh.dZt;
+        hx(i) = strideValues(i, 0)*mesh.dXi;
+        hz(i) = strideValues(i, 2)*mesh.dZt;
 
-        hx2(i) = pow(strideValues(i)*mesh.dXi, 2.0);
-        hz2(i) = pow(strideValues(i)*mesh.dZt, 2.0);
+        hx2(i) = pow(hx(i), 2.0);
+        hz2(i) = pow(hz(i), 2.0);
 
-        hzhx(i) = pow(strideValues(i), 4.0)*pow(mesh.dZt, 2.0)*pow(mesh.dXi, 2.0);
+        hzhx(i) = pow(hz(i), 2.0)*pow(hx(i), 2.0);
     }
 }
 
-void multigrid_d2::copyStaggrDerivs() {
-    xixx.resize(stagFull.ubound(0) - stagFull.lbound(0) + 1);
-    xixx.reindexSelf(stagFull.lbound(0));
+template <typename mgReal>
+void multigrid_d2<mgReal>::copyStaggrDerivs() {
+    xixx.resize(inputParams.vcDepth + 1, stagFull(0).ubound(0) - stagFull(0).lbound(0) + 1);
+    xixx.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(0)));
     xixx = 0.0;
-    xixx(blitz::Range(0, stagCore.ubound(0), 1)) = mesh.xixxStaggr(blitz::Range(0, stagCore.ubound(0), 1));
 
-    xix2.resize(stagFull.ubound(0) - stagFull.lbound(0) + 1);
-    xix2.reindexSelf(stagFull.lbound(0));
+    xix2.resize(inputParams.vcDepth + 1, stagFull(0).ubound(0) - stagFull(0).lbound(0) + 1);
+    xix2.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(0)));
     xix2 = 0.0;
-    xix2(blitz::Range(0, stagCore.ubound(0), 1)) = mesh.xix2Staggr(blitz::Range(0, stagCore.ubound(0), 1));
 
-    ztzz.resize(stagFull.ubound(2) - stagFull.lbound(2) + 1);
-    ztzz.reindexSelf(stagFull.lbound(2));
+    ztzz.resize(inputParams.vcDepth + 1, stagFull(0).ubound(2) - stagFull(0).lbound(2) + 1);
+    ztzz.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(2)));
     ztzz = 0.0;
-    ztzz(blitz::Range(0, stagCore.ubound(2), 1)) = mesh.ztzzStaggr(blitz::Range(0, stagCore.ubound(2), 1));
 
-    ztz2.resize(stagFull.ubound(2) - stagFull.lbound(2) + 1);
-    ztz2.reindexSelf(stagFull.lbound(2));
+    ztz2.resize(inputParams.vcDepth + 1, stagFull(0).ubound(2) - stagFull(0).lbound(2) + 1);
+    ztz2.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(2)));
     ztz2 = 0.0;
-    ztz2(blitz::Range(0, stagCore.ubound(2), 1)) = mesh.ztz2Staggr(blitz::Range(0, stagCore.ubound(2), 1));
+
+    // THE iTH POINT OF A LEVEL COINCIDES WITH THE (i x stride)TH POINT OF THE FINEST LEVEL
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        xixx(i, xMeshRange(i)) = mesh.xixxStaggr(blitz::Range(0, stagCore(0).ubound(0), strideValues(i, 0)));
+        xix2(i, xMeshRange(i)) = mesh.xix2Staggr(blitz::Range(0, stagCore(0).ubound(0), strideValues(i, 0)));
+
+        ztzz(i, zMeshRange(i)) = mesh.ztzzStaggr(blitz::Range(0, stagCore(0).ubound(2), strideValues(i, 2)));
+        ztz2(i, zMeshRange(i)) = mesh.ztz2Staggr(blitz::Range(0, stagCore(0).ubound(2), strideValues(i, 2)));
+    }
+
+    // THE METRICS DIVIDED BY THE GRID SPACINGS OF EACH LEVEL ARE THE COEFFICIENTS OF THE LAPLACIAN USED BY ITS KERNELS
+    xixxCoeff.resize(xixx.shape());         xixxCoeff.reindexSelf(xixx.lbound());
+    xix2Coeff.resize(xix2.shape());         xix2Coeff.reindexSelf(xix2.lbound());
+    ztzzCoeff.resize(ztzz.shape());         ztzzCoeff.reindexSelf(ztzz.lbound());
+    ztz2Coeff.resize(ztz2.shape());         ztz2Coeff.reindexSelf(ztz2.lbound());
+
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        for (int iX = xixx.lbound(1); iX <= xixx.ubound(1); iX++) {
+            xixxCoeff(i, iX) = xixx(i, iX)/(2.0*hx(i));
+            xix2Coeff(i, iX) = xix2(i, iX)/(hx(i)*hx(i));
+        }
+
+        for (int iZ = ztzz.lbound(1); iZ <= ztzz.ubound(1); iZ++) {
+            ztzzCoeff(i, iZ) = ztzz(i, iZ)/(2.0*hz(i));
+            ztz2Coeff(i, iZ) = ztz2(i, iZ)/(hz(i)*hz(i));
+        }
+    }
+
+    // AT THE LEVELS USING DEEP PADS, THE COEFFICIENTS ALONG X ARE ALSO NEEDED AT THE POINTS OF THE PADS
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        if (haloLevel(i)) {
+            shareCoefficients(xixxCoeff, i, xEnd(i), mesh.rankData.nearRanks(0), mesh.rankData.nearRanks(1));
+            shareCoefficients(xix2Coeff, i, xEnd(i), mesh.rankData.nearRanks(0), mesh.rankData.nearRanks(1));
+        }
+    }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::setKernels() {
+    int kernelIndex;
+
+    // THE METRICS ARE CONSTANT AND THE FIRST DERIVATIVE TERMS VANISH ALONG THE DIRECTIONS OF UNIFORM GRID
+    // EACH COMBINATION OF UNIFORM DIRECTIONS HAS ITS OWN SET OF KERNELS, WHICH ARE INSTANTIATED AT COMPILE TIME
+    kernelIndex = 2*(inputParams.xGrid == 0) + (inputParams.zGrid == 0);
+
+    switch (kernelIndex) {
+        case 0: selectKernels<false, false>();
+                break;
+        case 1: selectKernels<false, true>();
+                break;
+        case 2: selectKernels<true, false>();
+                break;
+        case 3: selectKernels<true, true>();
+                break;
+    }
 }
 
-void multigrid_d2::initMeshRanges() {
+template <typename mgReal>
+template <bool xUniform, bool zUniform>
+void multigrid_d2<mgReal>::selectKernels() {
+    residualKernel = &multigrid_d2<mgReal>::template residualSweep<xUniform, zUniform>;
+    pointKernel = &multigrid_d2<mgReal>::template pointSweep<xUniform, zUniform, false>;
+    checkKernel = &multigrid_d2<mgReal>::template pointSweep<xUniform, zUniform, true>;
+    planeKernel = &multigrid_d2<mgReal>::template planeSweep<xUniform, zUniform>;
+    lineKernel = &multigrid_d2<mgReal>::template lineSystem<xUniform, zUniform>;
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::initMeshRanges() {
     xMeshRange.resize(inputParams.vcDepth + 1);
     zMeshRange.resize(inputParams.vcDepth + 1);
 
-    // Range OBJECTS WITH STRIDE TO ACCESS DIFFERENT POINTS OF THE SAME ARRAY AT DIFFERENT MULTI-GRID LEVELS
+    // Range OBJECTS TO ACCESS THE CORE OF THE ARRAYS AT DIFFERENT MULTI-GRID LEVELS
     for(int i=0; i<=inputParams.vcDepth; i++) {
-        xMeshRange(i) = blitz::Range(stagCore.lbound(0), stagCore.ubound(0), strideValues(i));
-        zMeshRange(i) = blitz::Range(stagCore.lbound(2), stagCore.ubound(2), strideValues(i));
+        xMeshRange(i) = blitz::Range(stagCore(i).lbound(0), stagCore(i).ubound(0), 1);
+        zMeshRange(i) = blitz::Range(stagCore(i).lbound(2), stagCore(i).ubound(2), 1);
     }
 
     // SET THE LIMTS FOR ARRAY LOOPS IN solve AND smooth FUNCTIONS, AND A FEW OTHER PLACES
-    // WARNING: THESE VARIABLES HAVE SO FAR BEEN IMPLEMENTED ONLY IN solve, smooth AND vCycle.
-    // THE TEST FUNCTIONS HAVE NOT YET BEEN UPDATED WITH THESE
-    xStr = stagCore.lbound(0);
-    zStr = stagCore.lbound(2);
+    // THE LOWER LIMITS ARE SAME AT ALL LEVELS, WHILE THE UPPER LIMITS ARE DIFFERENT FOR EACH LEVEL
+    xStr = stagCore(0).lbound(0);
+    zStr = stagCore(0).lbound(2);
+
+    xEnd.resize(inputParams.vcDepth + 1);
+    zEnd.resize(inputParams.vcDepth + 1);
 
-    xEnd = stagCore.ubound(0);
-    zEnd = stagCore.ubound(2);
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        xEnd(i) = stagCore(i).ubound(0);
+        zEnd(i) = stagCore(i).ubound(2);
+    }
+
+    // THE DEEP PADS ARE USED BY THE FUSED SWEEPS OF THE RED-BLACK POINT SMOOTHER, AND ONLY AT THE LEVELS WHERE THEY LIE WITHIN THE
+    // CORE OF THE NEIGHBOURING SUB-DOMAINS. THE LEVELS USING THE GALERKIN OPERATOR ARE RELAXED IN 4 COLOURS AND DO NOT FUSE THEIR SWEEPS
+    haloLevel.resize(inputParams.vcDepth + 1);
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        haloLevel(i) = (inputParams.haloDepth > 1 and inputParams.smoothType == 0 and not (inputParams.coarseOperator == 1 and i > 0) and
+                        xEnd(i) > inputParams.haloDepth);
+    }
 }
 
-void multigrid_d2::createMGSubArrays() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::createMGSubArrays() {
     int count, length, stride;
+    int ptsCount, zParity;
+
+    blitz::Array<int, 1> blockIndx, blockSize;
 
     recvStatus.resize(2);
     recvRequest.resize(2);
 
+    sendStatus.resize(2);
+
     xMGArray.resize(inputParams.vcDepth + 1);
+    xMGRBArray.resize(inputParams.vcDepth + 1, 2);
+    xMGHalo.resize(inputParams.vcDepth + 1);
+
+    padSendBuffer.resize(inputParams.vcDepth + 1, 2);
+    padRecvBuffer.resize(inputParams.vcDepth + 1, 2);
+    padSendRequest.resize(inputParams.vcDepth + 1, 2, 2);
+    padRecvRequest.resize(inputParams.vcDepth + 1, 2, 2);
+
     mgSendLft.resize(inputParams.vcDepth + 1);        mgSendRgt.resize(inputParams.vcDepth + 1);
     mgRecvLft.resize(inputParams.vcDepth + 1);        mgRecvRgt.resize(inputParams.vcDepth + 1);
 
     for(int i=0; i<=inputParams.vcDepth; i++) {
         // CREATE X_MG_ARRAY DATATYPE
-        count = (stagCore.ubound(2) - stagCore.lbound(2))/strideValues(i) + 1;
-        length = 1;
-        stride = strideValues(i);
+        // THE POINTS ALONG Z-DIRECTION ARE CONTIGUOUS IN THE ARRAY OF EACH LEVEL
+        count = 1;
+        length = zEnd(i) + 1;
+        stride = 1;
 
-        MPI_Type_vector(count, length, stride, MPI_FP_REAL, &xMGArray(i));
+        MPI_Type_vector(count, length, stride, mgDataType, &xMGArray(i));
         MPI_Type_commit(&xMGArray(i));
 
-        mgSendLft(i) =  strideValues(i), 0, 0;
-        mgRecvLft(i) = -strideValues(i), 0, 0;
-        mgSendRgt(i) = stagCore.ubound(0) - strideValues(i), 0, 0;
-        mgRecvRgt(i) = stagCore.ubound(0) + strideValues(i), 0, 0;
+        // CREATE X_MG_RB_ARRAY DATATYPE - ONLY EVERY ALTERNATE POINT ALONG Z IS TRANSFERRED FOR EACH COLOUR
+        // SINCE THE SEND AND RECEIVE POSITIONS ALONG X ARE ODD, THE POINT AT iZ HAS THE COLOUR OF (1 + iZ)
+        // WITH THE ZEBRA LINE SMOOTHER, ALL THE POINTS ALONG Z HAVE THE COLOUR OF THEIR LINE, WHICH IS 1 AT THESE POSITIONS
+        zParity = (inputParams.smoothType == 0)? 1: 0;
+        blockIndx.resize(zEnd(i) + 1);
+        blockSize.resize(zEnd(i) + 1);
+        blockSize = 1;
+        for (int c=0; c<2; c++) {
+            ptsCount = 0;
+            for (int iZ = 0; iZ <= zEnd(i); iZ++) {
+                if ((1 + zParity*iZ) % 2 == c) {
+                    blockIndx(ptsCount) = iZ;
+                    ptsCount += 1;
+                }
+            }
+            MPI_Type_indexed(ptsCount, blockSize.data(), blockIndx.data(), mgDataType, &xMGRBArray(i, c));
+            MPI_Type_commit(&xMGRBArray(i, c));
+        }
+
+        // THE PADS OF ONE COLOUR TRANSFERRED BY beginPadUpdate ARE PACKED INTO CONTIGUOUS BUFFERS, WHICH ARE SHARED BY THE TWO COLOURS.
+        // THE PERSISTENT REQUESTS ARE CREATED ONCE FOR EACH COLOUR, SINCE THE BLACK POINTS OF THE SINGLE LINE ALONG Z ARE ONE MORE THAN THE RED
+        padSendBuffer(i, 0).resize(faceOffset(i, 1, 1));        padRecvBuffer(i, 0).resize(faceOffset(i, 1, 1));
+        padSendBuffer(i, 1).resize(faceOffset(i, 1, 1));        padRecvBuffer(i, 1).resize(faceOffset(i, 1, 1));
+
+        for (int c=0; c<2; c++) {
+            MPI_Recv_init(padRecvBuffer(i, 0).data(), faceOffset(i, 1, c), mgDataType, mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &padRecvRequest(i, c, 0));
+            MPI_Recv_init(padRecvBuffer(i, 1).data(), faceOffset(i, 1, c), mgDataType, mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &padRecvRequest(i, c, 1));
+
+            MPI_Send_init(padSendBuffer(i, 0).data(), faceOffset(i, 1, c), mgDataType, mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD, &padSendRequest(i, c, 0));
+            MPI_Send_init(padSendBuffer(i, 1).data(), faceOffset(i, 1, c), mgDataType, mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD, &padSendRequest(i, c, 1));
+        }
+
+        // CREATE X_MG_HALO DATATYPE - AT THE LEVELS USING DEEP PADS, haloDepth LINES ALONG Z ARE TRANSFERRED AT ONCE
+        xMGHalo(i) = MPI_DATATYPE_NULL;
+        if (haloLevel(i)) {
+            count = inputParams.haloDepth;
+            length = zEnd(i) + 1;
+            stride = stagFull(i).ubound(2) - stagFull(i).lbound(2) + 1;
+
+            MPI_Type_vector(count, length, stride, mgDataType, &xMGHalo(i));
+            MPI_Type_commit(&xMGHalo(i));
+        }
+
+        mgSendLft(i) =  1, 0, 0;
+        mgRecvLft(i) = -1, 0, 0;
+        mgSendRgt(i) = xEnd(i) - 1, 0, 0;
+        mgRecvRgt(i) = xEnd(i) + 1, 0, 0;
+    }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::getStencil(const int iX, const int iZ, blitz::TinyVector<real, 9> &aVal) {
+    if (inputParams.coarseOperator == 1 and vLevel > 0) {
+        for (int sIndx = 0; sIndx < 9; sIndx++) {
+            aVal(sIndx) = stencilData(vLevel)(iX, 0, iZ, sIndx);
+        }
+
+    } else {
+        // THE 5-POINT STENCIL OF THE LAPLACIAN DISCRETIZED WITH THE GRID METRICS, PLACED IN THE 9-POINT LAYOUT
+        aVal = 0.0;
+
+        aVal(1) = xix2(vLevel, iX)/(hx(vLevel)*hx(vLevel)) - xixx(vLevel, iX)/(2.0*hx(vLevel));
+        aVal(7) = xix2(vLevel, iX)/(hx(vLevel)*hx(vLevel)) + xixx(vLevel, iX)/(2.0*hx(vLevel));
 
+        aVal(3) = ztz2(vLevel, iZ)/(hz(vLevel)*hz(vLevel)) - ztzz(vLevel, iZ)/(2.0*hz(vLevel));
+        aVal(5) = ztz2(vLevel, iZ)/(hz(vLevel)*hz(vLevel)) + ztzz(vLevel, iZ)/(2.0*hz(vLevel));
+
+        aVal(4) = -2.0*xix2(vLevel, iX)/(hx(vLevel)*hx(vLevel)) - 2.0*ztz2(vLevel, iZ)/(hz(vLevel)*hz(vLevel));
     }
 }
 
-void multigrid_d2::imposeBC() {
-    updatePads();
+template <typename mgReal>
+void multigrid_d2<mgReal>::createGalerkinOperators() {
+    int iY = 0;
+    int cLevel;
+    int gNx, gNz;
+    int xColours, zColours;
+
+    blitz::Array<int, 1> xMatch, zMatch;
+
+    stencilData.resize(inputParams.vcDepth + 1);
+
+    for (int i=0; i<inputParams.vcDepth; i++) {
+        cLevel = i + 1;
+
+        stencilData(cLevel).resize(xEnd(cLevel) + 1, 1, zEnd(cLevel) + 1, 9);
+        stencilData(cLevel) = 0.0;
+
+        xMatch.resize(xEnd(cLevel) + 1);
+        zMatch.resize(zEnd(cLevel) + 1);
+
+        // NUMBER OF INTERVALS ALONG EACH DIRECTION OF THE GLOBAL GRID AT THE COARSER LEVEL
+        gNx = mesh.rankData.npX*xEnd(cLevel);
+        gNz = zEnd(cLevel);
 
+        xColours = inputParams.xPer? 4: 3;
+        zColours = inputParams.zPer? 4: 3;
+
+        // THE COARSE POINTS ARE PROBED IN GROUPS THAT ARE FAR ENOUGH APART FOR THEIR STENCILS TO NOT OVERLAP.
+        // FOR EACH GROUP, THE PROBE IS PROLONGED, THE OPERATOR OF THE FINER LEVEL IS APPLIED TO IT, AND THE RESULT IS RESTRICTED.
+        // THE RESTRICTED VALUE AT EACH COARSE POINT IS THEN THE ENTRY OF ITS STENCIL CORRESPONDING TO THE NEIGHBOURING PROBE
+        for (int xC = 0; xC < xColours; xC++) {
+            setProbeOffsets(xMatch, mesh.rankData.xRank*xEnd(cLevel), gNx, inputParams.xPer, xC);
+
+            for (int zC = 0; zC < zColours; zC++) {
+                setProbeOffsets(zMatch, 0, gNz, inputParams.zPer, zC);
+
+                vLevel = cLevel;
+
+                pressureData(cLevel) = 0.0;
+                for (int iX = xStr; iX <= xEnd(cLevel); iX++) {
+                    for (int iZ = zStr; iZ <= zEnd(cLevel); iZ++) {
+                        if (xMatch(iX) == 0 and zMatch(iZ) == 0) pressureData(cLevel)(iX, iY, iZ) = 1.0;
+                    }
+                }
+
+                prolong();
+
+                // THE RHS USED HERE IS ZERO, SO THAT THE RESIDUAL IS THE NEGATIVE OF THE OPERATOR APPLIED TO THE PROLONGED PROBE
+                imposeBC(pressureData(vLevel), 2);
+                computeResidual(smoothedPres(vLevel));
+
+                coarsen();
+
+                for (int iX = xStr; iX <= xEnd(cLevel); iX++) {
+                    for (int iZ = zStr; iZ <= zEnd(cLevel); iZ++) {
+                        if (xMatch(iX) < 2 and zMatch(iZ) < 2) {
+                            stencilData(cLevel)(iX, iY, iZ, 3*(xMatch(iX) + 1) + zMatch(iZ) + 1) = -residualData(cLevel)(iX, iY, iZ);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // RESET THE ARRAYS USED FOR PROBING
+    vLevel = 0;
+    for (int i=0; i<=inputParams.vcDepth; i++) {
+        pressureData(i) = 0.0;
+        residualData(i) = 0.0;
+    }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::createCoarseSystem() {
+    int cLevel, entryCount, pointCount;
+    int gNx, gNz;
+    int rowIndex;
+
+    blitz::TinyVector<real, 9> aVal;
+
+    blitz::Array<int, 1> xGlobal, zGlobal;
+    blitz::Array<int, 1> rowIndx, colIndx;
+    blitz::Array<int, 1> ownedIndx, coreIndx;
+    blitz::Array<real, 1> matVals;
+
+    cLevel = inputParams.vcDepth;
+
+    blitz::RectDomain<3> uniqCore = ownedCore(cLevel);
+
+    // NUMBER OF UNKNOWNS ALONG EACH DIRECTION OF THE GLOBAL GRID AT THE COARSEST LEVEL
+    gNx = mesh.rankData.npX*xEnd(cLevel) + (inputParams.xPer? 0: 1);
+    gNz = zEnd(cLevel) + (inputParams.zPer? 0: 1);
+
+    xGlobal.resize(blitz::Range(-1, xEnd(cLevel) + 1));
+    zGlobal.resize(blitz::Range(-1, zEnd(cLevel) + 1));
+
+    setGlobalIndex(xGlobal, mesh.rankData.xRank*xEnd(cLevel), gNx, inputParams.xPer);
+    setGlobalIndex(zGlobal, 0, gNz, inputParams.zPer);
+
+    pointCount = blitz::product(uniqCore.ubound() - uniqCore.lbound() + 1);
+    ownedIndx.resize(pointCount);
+    rowIndx.resize(9*pointCount);
+    colIndx.resize(9*pointCount);
+    matVals.resize(9*pointCount);
+
+    // THE ENTRIES OF EACH ROW ARE THE COEFFICIENTS OF THE STENCIL USED IN computeResidual, WHICH IS EITHER THE 5-POINT LAPLACIAN
+    // OR THE 9-POINT GALERKIN OPERATOR. ONLY THE NON-ZERO ENTRIES OF THE STENCIL ARE STORED
+    // WHEN A NEIGHBOURING POINT IS MAPPED ONTO ANOTHER POINT (OR ONTO THE POINT ITSELF) ACROSS A BOUNDARY, THE ENTRIES ARE ADDED UP DURING ASSEMBLY
+    vLevel = cLevel;
+
+    entryCount = 0;
+    pointCount = 0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+            rowIndex = xGlobal(iX)*gNz + zGlobal(iZ);
+            ownedIndx(pointCount) = rowIndex;
+            pointCount += 1;
+
+            getStencil(iX, iZ, aVal);
+
+            for (int dX = -1; dX <= 1; dX++) {
+                for (int dZ = -1; dZ <= 1; dZ++) {
+                    if (aVal(3*(dX + 1) + dZ + 1) == 0.0) continue;
+
+                    rowIndx(entryCount) = rowIndex;
+                    colIndx(entryCount) = xGlobal(iX + dX)*gNz + zGlobal(iZ + dZ);
+                    matVals(entryCount) = aVal(3*(dX + 1) + dZ + 1);
+                    entryCount += 1;
+                }
+            }
+        }
+    }
+
+    vLevel = 0;
+
+    rowIndx.resizeAndPreserve(entryCount);
+    colIndx.resizeAndPreserve(entryCount);
+    matVals.resizeAndPreserve(entryCount);
+
+    // GLOBAL INDICES OF ALL THE CORE POINTS, IN THE ORDER IN WHICH directSolve COPIES THE SOLUTION INTO THEM
+    coreIndx.resize((xEnd(cLevel) + 1)*(zEnd(cLevel) + 1));
+
+    pointCount = 0;
+    for (int iX = xStr; iX <= xEnd(cLevel); iX++) {
+        for (int iZ = zStr; iZ <= zEnd(cLevel); iZ++) {
+            coreIndx(pointCount) = xGlobal(iX)*gNz + zGlobal(iZ);
+            pointCount += 1;
+        }
+    }
+
+    factorCoarseSystem(rowIndx, colIndx, matVals, ownedIndx, coreIndx);
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::imposeBC(blitz::Array<mgReal, 3> &data, const int colour) {
+    updatePads(data, colour);
+
+    imposeWallBC(data);
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::imposeWallBC(blitz::Array<mgReal, 3> &data) {
     if (not inputParams.xPer) {
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT LEFT WALL
+        // NEUMANN BOUNDARY CONDITION AT LEFT WALL
         if (mesh.rankData.xRank == 0) {
-            pressureData(-strideValues(vLevel), 0, zMeshRange(vLevel)) = pressureData(strideValues(vLevel), 0, zMeshRange(vLevel));
+            data(-1, 0, zMeshRange(vLevel)) = data(1, 0, zMeshRange(vLevel));
         }
 
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT RIGHT WALL
+        // NEUMANN BOUNDARY CONDITION AT RIGHT WALL
         if (mesh.rankData.xRank == mesh.rankData.npX - 1) {
-            pressureData(stagCore.ubound(0) + strideValues(vLevel), 0, zMeshRange(vLevel)) = pressureData(stagCore.ubound(0) - strideValues(vLevel), 0, zMeshRange(vLevel));
+            data(xEnd(vLevel) + 1, 0, zMeshRange(vLevel)) = data(xEnd(vLevel) - 1, 0, zMeshRange(vLevel));
         }
     } // PERIODIC BOUNDARY CONDITIONS ARE AUTOMATICALLY IMPOSED BY PERIODIC DATA TRANSFER ACROSS PROCESSORS THROUGH updatePads()
 
+    // THE BOUNDARY CONDITIONS ALONG Z-DIRECTION ARE IMPOSED OVER THE X PADS TOO, SO THAT THE CORNERS ARE ALSO SET
     if (inputParams.zPer) {
-        // PERIODIC BOUNDARY CONDITION ON PRESSURE AT BOTTOM WALL
-        pressureData(xMeshRange(vLevel), 0, -strideValues(vLevel)) = pressureData(xMeshRange(vLevel), 0, stagCore.ubound(2) - strideValues(vLevel));
+        // PERIODIC BOUNDARY CONDITION AT BOTTOM WALL
+        data(blitz::Range::all(), 0, -1) = data(blitz::Range::all(), 0, zEnd(vLevel) - 1);
 
-        // PERIODIC BOUNDARY CONDITION ON PRESSURE AT TOP WALL
-        pressureData(xMeshRange(vLevel), 0, stagCore.ubound(2) + strideValues(vLevel)) = pressureData(xMeshRange(vLevel), 0, strideValues(vLevel));
+        // PERIODIC BOUNDARY CONDITION AT TOP WALL
+        data(blitz::Range::all(), 0, zEnd(vLevel) + 1) = data(blitz::Range::all(), 0, 1);
 
     } else {
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT BOTTOM WALL
-        pressureData(xMeshRange(vLevel), 0, -strideValues(vLevel)) = pressureData(xMeshRange(vLevel), 0, strideValues(vLevel));
+        // NEUMANN BOUNDARY CONDITION AT BOTTOM WALL
+        data(blitz::Range::all(), 0, -1) = data(blitz::Range::all(), 0, 1);
 
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT TOP WALL
-        pressureData(xMeshRange(vLevel), 0, stagCore.ubound(2) + strideValues(vLevel)) = pressureData(xMeshRange(vLevel), 0, stagCore.ubound(2) - strideValues(vLevel));
+        // NEUMANN BOUNDARY CONDITION AT TOP WALL
+        data(blitz::Range::all(), 0, zEnd(vLevel) + 1) = data(blitz::Range::all(), 0, zEnd(vLevel) - 1);
     }
 }
 
-void multigrid_d2::updatePads() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::imposePlaneBC(blitz::Array<mgReal, 3> &data, const int iX) {
+    // IN 2D, THE PLANE OF CONSTANT X IS A SINGLE LINE ALONG Z, WITHOUT ANY PADS ALONG Y
+    data(iX, 0, -1) = inputParams.zPer? data(iX, 0, zEnd(vLevel) - 1): data(iX, 0, 1);
+    data(iX, 0, zEnd(vLevel) + 1) = inputParams.zPer? data(iX, 0, 1): data(iX, 0, zEnd(vLevel) - 1);
+
+    // THE LINES NEXT TO THE WALLS ALONG X ARE COPIED, ALONG WITH THEIR PADS, INTO THE PAD LINES ACROSS THE WALLS
+    if (not inputParams.xPer) {
+        // NEUMANN BOUNDARY CONDITION AT LEFT WALL
+        if (mesh.rankData.xRank == 0 and iX == 1) {
+            for (int iZ = -1; iZ <= zEnd(vLevel) + 1; iZ++) data(-1, 0, iZ) = data(1, 0, iZ);
+        }
+
+        // NEUMANN BOUNDARY CONDITION AT RIGHT WALL
+        if (mesh.rankData.xRank == mesh.rankData.npX - 1 and iX == xEnd(vLevel) - 1) {
+            for (int iZ = -1; iZ <= zEnd(vLevel) + 1; iZ++) data(xEnd(vLevel) + 1, 0, iZ) = data(xEnd(vLevel) - 1, 0, iZ);
+        }
+    }
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::updatePads(blitz::Array<mgReal, 3> &data, const int colour) {
+    MPI_Datatype xFace;
+
+    // THE DEEP PADS ARE TRANSFERRED FROM DIFFERENT POSITIONS, AND WITH THEIR OWN DATATYPE
+    if (colour == 3) {
+        updateHalos(data);
+        return;
+    }
+
+    // CHOOSE BETWEEN THE DATATYPE HOLDING ALL THE POINTS OF THE FACE AND THAT HOLDING THE POINTS OF A SINGLE COLOUR
+    xFace = (colour == 2)? xMGArray(vLevel): xMGRBArray(vLevel, colour);
+
     recvRequest = MPI_REQUEST_NULL;
 
     // TRANSFER DATA FROM NEIGHBOURING CELL TO IMPOSE SUB-DOMAIN BOUNDARY CONDITIONS
-    MPI_Irecv(&pressureData(mgRecvLft(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
-    MPI_Irecv(&pressureData(mgRecvRgt(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &recvRequest(1));
+    MPI_Irecv(&data(mgRecvLft(vLevel)), 1, xFace, mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
+    MPI_Irecv(&data(mgRecvRgt(vLevel)), 1, xFace, mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &recvRequest(1));
+
+    MPI_Send(&data(mgSendLft(vLevel)), 1, xFace, mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD);
+    MPI_Send(&data(mgSendRgt(vLevel)), 1, xFace, mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD);
 
-    MPI_Send(&pressureData(mgSendLft(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD);
-    MPI_Send(&pressureData(mgSendRgt(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD);
+    MPI_Waitall(2, recvRequest.dataFirst(), recvStatus.dataFirst());
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::updateHalos(blitz::Array<mgReal, 3> &data) {
+    int hDepth = inputParams.haloDepth;
+
+    recvRequest = MPI_REQUEST_NULL;
+
+    // THE LINES 1 TO hDepth AND N - hDepth TO N - 1 ARE SENT TO THE NEIGHBOURS
+    MPI_Irecv(&data(-hDepth, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
+    MPI_Irecv(&data(xEnd(vLevel) + 1, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &recvRequest(1));
+
+    MPI_Send(&data(1, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD);
+    MPI_Send(&data(xEnd(vLevel) - hDepth, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD);
 
     MPI_Waitall(2, recvRequest.dataFirst(), recvStatus.dataFirst());
 }
 
-real multigrid_d2::testProlong() {
+template <typename mgReal>
+void multigrid_d2<mgReal>::beginPadUpdate(blitz::Array<mgReal, 3> &data, const int colour) {
+    MPI_Startall(2, &padRecvRequest(vLevel, colour, 0));
+
+    // IN 2D, EACH FACE IS A SINGLE LINE ALONG Z, AND ONLY THE FACES SHARED WITH THE NEIGHBOURING SUB-DOMAINS ARE PACKED
+    if (mesh.rankData.nearRanks(0) != MPI_PROC_NULL) packFace(&data(1, 0, 0), 0, 1, colour, padSendBuffer(vLevel, 0).data());
+    if (mesh.rankData.nearRanks(1) != MPI_PROC_NULL) packFace(&data(xEnd(vLevel) - 1, 0, 0), 0, 1, colour, padSendBuffer(vLevel, 1).data());
+
+    MPI_Startall(2, &padSendRequest(vLevel, colour, 0));
+}
+
+template <typename mgReal>
+void multigrid_d2<mgReal>::finishPadUpdate(blitz::Array<mgReal, 3> &data, const int colour) {
+    MPI_Waitall(2, &padRecvRequest(vLevel, colour, 0), recvStatus.dataFirst());
+
+    // THE PADS FACING THE WALLS ARE NOT RECEIVED, AND ARE LEFT UNCHANGED
+    if (mesh.rankData.nearRanks(0) != MPI_PROC_NULL) unpackFace(padRecvBuffer(vLevel, 0).data(), 0, 1, colour, &data(-1, 0, 0));
+    if (mesh.rankData.nearRanks(1) != MPI_PROC_NULL) unpackFace(padRecvBuffer(vLevel, 1).data(), 0, 1, colour, &data(xEnd(vLevel) + 1, 0, 0));
+
+    // THE SEND BUFFERS ARE REUSED BY THE NEXT TRANSFER, AND THE SENDS MUST BE COMPLETE BEFORE THEY ARE PACKED AGAIN
+    MPI_Waitall(2, &padSendRequest(vLevel, colour, 0), sendStatus.dataFirst());
+}
+
+template <typename mgReal>
+real multigrid_d2<mgReal>::testProlong() {
     int iY = 0;
     vLevel = 0;
 
     // Fill the residualData array with correct values expected after prolongation
-    residualData = 0.0;
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-            residualData(iX, iY, iZ) = (mesh.rankData.rank + 1)*100 + iX*10 + iZ;
+    residualData(vLevel) = 0.0;
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+            residualData(vLevel)(iX, iY, iZ) = (mesh.rankData.rank + 1)*100 + iX*10 + iZ;
         }
     }
 
-    // After going one level down the V-Cycle, populate the pressureData array with values at the corresponding stride
+    // After going one level down the V-Cycle, populate the pressureData array with values at the corresponding points
+    pressureData(vLevel) = 0.0;
     vLevel += 1;
-    pressureData = 0.0;
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-            pressureData(iX, iY, iZ) = (mesh.rankData.rank + 1)*100 + iX*10 + iZ;
+    pressureData(vLevel) = 0.0;
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+            pressureData(vLevel)(iX, iY, iZ) = (mesh.rankData.rank + 1)*100 + strideValues(vLevel, 0)*iX*10 + strideValues(vLevel, 2)*iZ;
         }
     }
 
     // Perform prolongation
     prolong();
 
-    pressureData -= residualData;
+    pressureData(vLevel) -= residualData(vLevel);
 
-    return blitz::max(fabs(pressureData));
+    return blitz::max(fabs(pressureData(vLevel)));
 }
 
-real multigrid_d2::testTransfer() {
+template <typename mgReal>
+real multigrid_d2<mgReal>::testTransfer() {
     real maxVal = 0.0;
 
     int iY = 0;
-    vLevel = 0;
-
-    pressureData = 0.0;
-    residualData = 0.0;
 
     MPI_Barrier(MPI_COMM_WORLD);
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += 1) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += 1) {
-            pressureData(iX, iY, iZ) = (mesh.rankData.rank + 1)*100 + iX*10 + iZ;
-            residualData(iX, iY, iZ) = pressureData(iX, iY, iZ);
+    for (vLevel = 0; vLevel <= inputParams.vcDepth; vLevel++) {
+        pressureData(vLevel) = 0.0;
+        residualData(vLevel) = 0.0;
+
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                pressureData(vLevel)(iX, iY, iZ) = (mesh.rankData.rank + 1)*100 + iX*10 + iZ;
+                residualData(vLevel)(iX, iY, iZ) = pressureData(vLevel)(iX, iY, iZ);
+            }
         }
-    }
 
-    // EXPECTED VALUES IN THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
-    for (int iX = 0; iX <= inputParams.vcDepth; iX++) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(iX)) {
-            residualData(-strideValues(iX), iY, iZ) = (mesh.rankData.nearRanks(0) + 1)*100 + (stagCore.ubound(0) - strideValues(iX))*10 + iZ;
-            residualData(stagCore.ubound(0) + strideValues(iX), iY, iZ) = (mesh.rankData.nearRanks(1) + 1)*100 + strideValues(iX)*10 + iZ;
+        // EXPECTED VALUES IN THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+            residualData(vLevel)(-1, iY, iZ) = (mesh.rankData.nearRanks(0) + 1)*100 + (xEnd(vLevel) - 1)*10 + iZ;
+            residualData(vLevel)(xEnd(vLevel) + 1, iY, iZ) = (mesh.rankData.nearRanks(1) + 1)*100 + 10 + iZ;
         }
-    }
 
-    for (int i=0; i<=inputParams.vcDepth; i++) {
-        updatePads();
-        vLevel += 1;
-    }
+        updatePads(pressureData(vLevel), 2);
 
-    pressureData -= residualData;
+        pressureData(vLevel) -= residualData(vLevel);
 
-    for (int iX = pressureData.lbound(0); iX <= pressureData.ubound(0); iX += 1) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += 1) {
-            if (abs(pressureData(iX, iY, iZ)) > maxVal) {
-                maxVal = abs(pressureData(iX, iY, iZ));
+        for (int iX = stagFull(vLevel).lbound(0); iX <= stagFull(vLevel).ubound(0); iX++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                if (abs(pressureData(vLevel)(iX, iY, iZ)) > maxVal) {
+                    maxVal = abs(pressureData(vLevel)(iX, iY, iZ));
+                }
             }
         }
     }
@@ -477,82 +1540,101 @@ real multigrid_d2::testTransfer() {
     return maxVal;
 }
 
-real multigrid_d2::testPeriodic() {
+template <typename mgReal>
+real multigrid_d2<mgReal>::testPeriodic() {
     int iY = 0;
-    real xCoord = 0.0;
-    real zCoord = 0.0;
+    int xSt, zSt;
+    real maxVal = 0.0;
 
-    vLevel = 0;
+    blitz::Array<real, 1> xCoord, zCoord;
 
-    pressureData = 0.0;
-    residualData = 0.0;
+    for (vLevel = 0; vLevel <= inputParams.vcDepth; vLevel++) {
+        // INDICES OF THE FINEST GRID AT WHICH THE POINTS OF THE CURRENT LEVEL LIE ARE OBTAINED BY MULTIPLYING WITH THE STRIDE
+        xSt = strideValues(vLevel, 0);
+        zSt = strideValues(vLevel, 2);
 
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-            pressureData(iX, iY, iZ) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                       cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
-            residualData(iX, iY, iZ) = pressureData(iX, iY, iZ);
-        }
-    }
+        // COORDINATES OF THE POINTS OF THE CURRENT LEVEL, WITH THE PAD POINTS EXTRAPOLATED FROM THE CORE
+        xCoord.resize(blitz::Range(-1, xEnd(vLevel) + 1));
+        zCoord.resize(blitz::Range(-1, zEnd(vLevel) + 1));
 
-    // EXPECTED VALUES IN THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
-    for (int iX = 0; iX <= inputParams.vcDepth; iX++) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(iX)) {
-            xCoord = mesh.xStaggr(stagCore.lbound(0)) - (mesh.xStaggr(stagCore.lbound(0) + strideValues(iX)) - mesh.xStaggr(stagCore.lbound(0)));
-            residualData(stagCore.lbound(0) - strideValues(iX), iY, iZ) = sin(2.0*M_PI*xCoord/mesh.xLen)*
-                                                                          cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) xCoord(iX) = mesh.xStaggr(iX*xSt);
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) zCoord(iZ) = mesh.zStaggr(iZ*zSt);
 
-            xCoord = mesh.xStaggr(stagCore.ubound(0)) + (mesh.xStaggr(stagCore.ubound(0)) - mesh.xStaggr(stagCore.ubound(0) - strideValues(iX)));
-            residualData(stagCore.ubound(0) + strideValues(iX), iY, iZ) = sin(2.0*M_PI*xCoord/mesh.xLen)*
-                                                                          cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
-        }
-    }
+        xCoord(-1) = 2.0*xCoord(0) - xCoord(1);
+        zCoord(-1) = 2.0*zCoord(0) - zCoord(1);
+
+        xCoord(xEnd(vLevel) + 1) = 2.0*xCoord(xEnd(vLevel)) - xCoord(xEnd(vLevel) - 1);
+        zCoord(zEnd(vLevel) + 1) = 2.0*zCoord(zEnd(vLevel)) - zCoord(zEnd(vLevel) - 1);
 
-    for (int iZ = 0; iZ <= inputParams.vcDepth; iZ++) {
-        for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(iZ)) {
-            zCoord = mesh.zStaggr(stagCore.lbound(2)) - (mesh.zStaggr(stagCore.lbound(2) + strideValues(iZ)) - mesh.zStaggr(stagCore.lbound(2)));
-            residualData(iX, iY, stagCore.lbound(2) - strideValues(iZ)) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                                          cos(2.0*M_PI*zCoord/mesh.zLen);
+        pressureData(vLevel) = 0.0;
+        residualData(vLevel) = 0.0;
 
-            zCoord = mesh.zStaggr(stagCore.ubound(2)) + (mesh.zStaggr(stagCore.ubound(2)) - mesh.zStaggr(stagCore.ubound(2) - strideValues(iZ)));
-            residualData(iX, iY, stagCore.ubound(2) + strideValues(iZ)) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                                          cos(2.0*M_PI*zCoord/mesh.zLen);
+        // EXPECTED VALUES IN THE CORE AS WELL AS THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
+        for (int iX = -1; iX <= xEnd(vLevel) + 1; iX++) {
+            for (int iZ = -1; iZ <= zEnd(vLevel) + 1; iZ++) {
+                residualData(vLevel)(iX, iY, iZ) = sin(2.0*M_PI*xCoord(iX)/mesh.xLen)*
+                                                   cos(2.0*M_PI*zCoord(iZ)/mesh.zLen);
+            }
         }
-    }
 
-    for (int i=0; i<=inputParams.vcDepth; i++) {
-        imposeBC();
-        vLevel += 1;
-    }
+        pressureData(vLevel)(stagCore(vLevel)) = residualData(vLevel)(stagCore(vLevel));
+
+        imposeBC(pressureData(vLevel), 2);
 
-    pressureData -= residualData;
+        pressureData(vLevel) -= residualData(vLevel);
 
-    return blitz::max(fabs(pressureData));
+        maxVal = std::max(maxVal, real(blitz::max(fabs(pressureData(vLevel)))));
+    }
+
+    return maxVal;
 }
 
-real multigrid_d2::testSolve() {
+template <typename mgReal>
+real multigrid_d2<mgReal>::testSolve() {
     int iY = 0;
 
     vLevel = 0;
 
-    pressureData = 0.0;
-    residualData = 0.0;
-    smoothedPres = 0.0;
+    pressureData(vLevel) = 0.0;
+    residualData(vLevel) = 0.0;
+    smoothedPres(vLevel) = 0.0;
 
     // WARNING: THE EXACT SOLUTION USED HERE ASSUMES xLen = yLen = zLen = 1.0
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-            smoothedPres(iX, iY, iZ) = sin(1.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+            smoothedPres(vLevel)(iX, iY, iZ) = sin(1.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
                                        cos(4.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
-            residualData(iX, iY, iZ) = -17.0*M_PI*M_PI*sin(1.0*M_PI*mesh.xStaggr(iX))*
-                                                       cos(4.0*M_PI*mesh.zStaggr(iZ));
+            residualData(vLevel)(iX, iY, iZ) = -17.0*M_PI*M_PI*sin(1.0*M_PI*mesh.xStaggr(iX))*
+                                                               cos(4.0*M_PI*mesh.zStaggr(iZ));
         }
     }
 
     // SOLVE WITH EXACT SOLUTION AS BC TO VERIFY !!
     solve();
 
-    pressureData -= smoothedPres;
+    pressureData(vLevel) -= smoothedPres(vLevel);
+
+    return blitz::max(fabs(pressureData(vLevel)));
+}
+
+template <typename mgReal>
+multigrid_d2<mgReal>::~multigrid_d2() {
+    // THE PERSISTENT REQUESTS AND THE DATATYPES CREATED BY createMGSubArrays ARE RELEASED FOR EVERY LEVEL AND COLOUR
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        for (int c=0; c<2; c++) {
+            for (int f=0; f<2; f++) {
+                MPI_Request_free(&padSendRequest(i, c, f));
+                MPI_Request_free(&padRecvRequest(i, c, f));
+            }
+
+            MPI_Type_free(&xMGRBArray(i, c));
+        }
+
+        MPI_Type_free(&xMGArray(i));
 
-    return blitz::max(fabs(pressureData));
+        if (haloLevel(i)) MPI_Type_free(&xMGHalo(i));
+    }
 }
+
+template class multigrid_d2<float>;
+template class multigrid_d2<double>;
@@ -7,22 +7,28 @@
  *          The constructor of the derived multigrid_d3 class frst calls the base poisson class with the arguments passed to it.
  *          It then calls a series of functions in sequence to initialize all the necessary parameters and data structures to
  *          store and manipulate the multi-grid data.
- *          Since the multi-grid solver operates on the staggered grid, it first computes the limits of the full and core
- *          staggered grid, as the grid class does the same for the collocated grid.
+ *          Since the multi-grid solver operates on the staggered grid, it first computes the strides of each level along every
+ *          direction, followed by the limits of the full and core staggered grid, as the grid class does the same for the collocated grid.
  *
  *          It then initializes all the Range objects to obtain the correct slices of the full grid at various
  *          levels of the V-cycle.
- *          It also copies the staggered grid derivatives to local arrays with wide pads, and finally generates the MPI datatypes
- *          for data transfer between sub-domain boundaries.
+ *          It also copies the staggered grid derivatives at the points of every level to local arrays, allocates the arrays
+ *          for each level of the V-cycle, and generates the MPI datatypes for data transfer between sub-domain boundaries.
+ *          If the Galerkin coarse grid operator is used, the stencils of all the coarser levels are then computed.
+ *          Finally, if the direct solver is used at the coarsest level, the matrix of the coarsest level is assembled and factored.
  *
  * \param   mesh is a const reference to the global data contained in the grid class
  * \param   solParam is a const reference to the user-set parameters contained in the parser class
  ********************************************************************************************************************************************
  */
-multigrid_d3::multigrid_d3(const grid &mesh, const parser &solParam): poisson(mesh, solParam) {
+template <typename mgReal>
+multigrid_d3<mgReal>::multigrid_d3(const grid &mesh, const parser &solParam): poisson<mgReal>(mesh, solParam) {
     // GET THE localSizeIndex AS IT WILL BE USED TO SET THE FULL AND CORE LIMITS OF THE STAGGERED POINTS
     setLocalSizeIndex();
 
+    // SET THE STRIDES OF ALL THE LEVELS ALONG EACH DIRECTION, WHICH DEPEND ON THE localSizeIndex AND THE COARSENING TYPE
+    setStrides();
+
     // SET THE FULL AND CORE LIMTS USING THE localSizeIndex VARIABLE SET ABOVE
     setStagBounds();
 
@@ -35,349 +41,1082 @@ multigrid_d3::multigrid_d3(const grid &mesh, const parser &solParam): poisson(me
     // COPY THE STAGGERED GRID DERIVATIVES TO LOCAL ARRAYS
     copyStaggrDerivs();
 
+    // CHOOSE THE KERNELS OF THE LAPLACIAN SPECIALISED FOR THE DIRECTIONS ALONG WHICH THE GRID IS UNIFORM
+    setKernels();
+
     // RESIZE AND INITIALIZE NECESSARY ARRAYS
     initializeArrays();
 
     // CREATE THE MPI SUB-ARRAYS NECESSARY TO TRANSFER DATA ACROSS SUB-DOMAINS AT ALL MESH LEVELS
     createMGSubArrays();
+
+    // COMPUTE THE GALERKIN OPERATORS OF THE COARSER LEVELS ONCE, IF THEY ARE USED INSTEAD OF THE REDISCRETIZED LAPLACIAN
+    if (inputParams.coarseOperator == 1) createGalerkinOperators();
+
+    // ASSEMBLE AND FACTOR THE MATRIX OF THE COARSEST LEVEL ONCE, IF IT IS TO BE SOLVED BY THE DIRECT SOLVER
+    if (directCoarse) createCoarseSystem();
 }
 
-void multigrid_d3::mgSolve(plainsf &inFn, const plainsf &rhs) {
-    pressureData = 0.0;
-    residualData = 0.0;
-    inputRHSData = 0.0;
+template <typename mgReal>
+void multigrid_d3<mgReal>::mgSolve(plainsf<real> &inFn, const plainsf<real> &rhs) {
+    real targetNorm;
+
+    // WITH MIXED PRECISION, THE CYCLES COMPUTE CORRECTIONS TO THE SOLUTION, WHICH IS HELD IN THE PRECISION OF THE FIELDS
+    if (mixedPrecision) {
+        mixedSolve(inFn, rhs);
+        return;
+    }
+
+    vLevel = 0;
 
+    // ONLY THE ARRAYS AT THE FINEST LEVEL NEED TO BE SET HERE. THE ARRAYS AT COARSER LEVELS ARE ALWAYS WRITTEN BEFORE THEY ARE READ
     // TRANSFER DATA FROM THE INPUT SCALAR FIELD INTO THE DATA-STRUCTURES USED BY poisson
-    inputRHSData(stagCore) = rhs.F(stagCore);
+    inputRHSData(0)(stagCore(0)) = rhs.F(stagCore(0));
+
+    if (inputParams.initGuess == 2) {
+        // THE INPUT LHS, INCLUDING ITS PADS, IS USED AS THE INITIAL GUESS, AND THE PADS ARE MADE CONSISTENT WITH THE BOUNDARY CONDITIONS
+        pressureData(0)(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound())) = inFn.F;
+        imposeBC(pressureData(0), 2);
+    } else {
+        pressureData(0) = 0.0;
+    }
+
+    // THE RHS IS MADE COMPATIBLE WITH THE SINGULAR OPERATOR, AND THE MEAN OF THE INITIAL GUESS IS REMOVED
+    removeNullSpace(inputRHSData(0), pressureData(0));
+
+    // THE RELATIVE TOLERANCE IS MEASURED AGAINST THE NORM OF THE RHS, WHICH IS THE RESIDUAL NORM OF A ZERO INITIAL GUESS
+    targetNorm = std::max(inputParams.absTol, inputParams.relTol*computeNorm(inputRHSData(0)));
+
+    computeResidual(inputRHSData(0));
+    residualNorm = computeNorm(residualData(0));
+
+    cyclesUsed = 0;
 
-    // PERFORM V-CYCLES AS MANY TIMES AS REQUIRED
-    for (int i=0; i<inputParams.vcCount; i++) {
-        smoothedPres = 0.0;
-        iteratorTemp = 0.0;
+    // WITH FULL MULTI-GRID, THE SOLUTION IS FIRST BUILT UP FROM THE COARSEST LEVEL, AND THIS PASS IS COUNTED AS ONE CYCLE
+    if (inputParams.initGuess == 1 and residualNorm > targetNorm) {
+        fmgCycle();
 
+        cyclesUsed += 1;
+
+        computeResidual(inputRHSData(0));
+        residualNorm = computeNorm(residualData(0));
+    }
+
+    // PERFORM MULTI-GRID CYCLES UNTIL THE RESIDUAL IS SMALL ENOUGH, OR TILL THE MAXIMUM NUMBER OF CYCLES ARE DONE
+    while (residualNorm > targetNorm and cyclesUsed < inputParams.vcCount) {
         vCycle();
+
+        cyclesUsed += 1;
+
+        computeResidual(inputRHSData(0));
+        residualNorm = computeNorm(residualData(0));
     }
 
+    // THE SOLUTION IS RETURNED WITH ZERO MEAN
+    removeNullSpace(inputRHSData(0), pressureData(0));
+
     // RETURN CALCULATED PRESSURE DATA
-    inFn.F = pressureData(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
+    inFn.F = pressureData(0)(blitz::RectDomain<3>(inFn.F.lbound(), inFn.F.ubound()));
 }
 
-void multigrid_d3::vCycle() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::fmgCycle() {
     vLevel = 0;
 
+    // TRANSFER THE RHS TO ALL THE COARSER LEVELS USING THE SAME RESTRICTION OPERATOR AS USED FOR THE RESIDUAL
+    residualData(0) = inputRHSData(0);
+    for (int i=0; i<inputParams.vcDepth; i++) {
+        coarsen();
+        removeNullSpace(residualData(vLevel), pressureData(vLevel));
+        inputRHSData(vLevel) = residualData(vLevel);
+    }
+
+    // SOLVE AT COARSEST MESH RESOLUTION
+    solve();
+
+    // THE SOLUTION AT EACH LEVEL IS INTERPOLATED TO THE NEXT FINER LEVEL AS ITS INITIAL GUESS, AND IMPROVED WITH ONE CYCLE AT THAT LEVEL
+    for (int i=0; i<inputParams.vcDepth; i++) {
+        prolong();
+        vCycle();
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::vCycle() {
+    // THE CYCLE STARTS FROM THE CURRENT LEVEL, WHICH IS THE FINEST LEVEL EXCEPT DURING FULL MULTI-GRID
+    fineLevel = vLevel;
+
     // PRE-SMOOTHING - SMOOTH FUNCTION OPERATES WITH residualData AS RHS AND pressureData AS LHS.
     // HENCE FOR PRE-SMOOTHING AND POST-SMOOTHING, inputRHSData HAS TO BE WRITTEN INTO residualData TEMPORARILY.
     // ALL SUBSEQUENT SMOOTHING CALLS AUTOMATICALLY OPERATE WITH THE residualData ARRAY.
-    swap(inputRHSData, residualData);
+    swap(inputRHSData(fineLevel), residualData(fineLevel));
     smooth(inputParams.preSmooth);
-    swap(residualData, inputRHSData);
+    swap(residualData(fineLevel), inputRHSData(fineLevel));
     // After above 3 lines, pressureData has the pre-smoothed values of pressure, inputRHSData has original RHS data, and residualData = 0.0
 
+    // CORRECT THE PRE-SMOOTHED PRESSURE FIELD USING THE COARSER LEVELS, VISITING THEM AS PER THE CYCLE TYPE
+    levelCycle(inputParams.cycleType);
+
+    // POST-SMOOTHING
+    swap(inputRHSData(fineLevel), residualData(fineLevel));
+    smooth(inputParams.postSmooth);
+    swap(residualData(fineLevel), inputRHSData(fineLevel));
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::levelCycle(const int cycleType) {
+    int visitCount, subCycleType;
+
+    // THE V-CYCLE VISITS THE COARSER LEVELS ONCE, WHILE THE W AND F-CYCLES VISIT THEM TWICE
+    visitCount = (cycleType == 0)? 1: 2;
+
+    for (int n=0; n<visitCount; n++) {
+        // AT THE FINEST LEVEL OF THE CYCLE, AND AT ALL LEVELS AFTER THE FIRST VISIT, pressureData IS NON-ZERO.
+        // ITS RESIDUAL IS THEN TRANSFERRED TO THE COARSER LEVELS, AND ITS VALUE IS SHIFTED INTO smoothedPres TILL THE CORRECTION IS COMPUTED
+        if (vLevel == fineLevel or n > 0) {
+            if (vLevel == fineLevel) {
+                computeResidual(inputRHSData(vLevel));
+            } else {
+                computeResidual(residualData(vLevel));
+            }
+            swap(smoothedPres(vLevel), pressureData(vLevel));
+        }
+
+        coarsen();
+
+        // THE RESTRICTED RESIDUAL IS MADE COMPATIBLE WITH THE SINGULAR OPERATOR OF THE COARSER LEVEL
+        removeNullSpace(residualData(vLevel), pressureData(vLevel));
+
+        if (vLevel == inputParams.vcDepth) {
+            // SOLVE AT COARSEST MESH RESOLUTION
+            solve();
+        } else {
+            // THE F-CYCLE FOLLOWS ITS FIRST VISIT WITH A V-CYCLE, WHILE THE W-CYCLE RECURSES WITH A W-CYCLE BOTH TIMES
+            subCycleType = (n > 0 and cycleType == 2)? 0: cycleType;
+
+            levelCycle(subCycleType);
+        }
+
+        prolong();
+        smooth(inputParams.interSmooth[inputParams.vcDepth - vLevel - 1]);
+
+        if (vLevel == fineLevel or n > 0) {
+            pressureData(vLevel) += smoothedPres(vLevel);
+        }
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::computeResidual(const blitz::Array<mgReal, 3> &rhsData) {
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    if (inputParams.coarseOperator == 1 and vLevel > 0) {
+        blitz::Array<mgReal, 4> &aData = stencilData(vLevel);
+
+        // APPLY THE 27-POINT STENCIL OF THE GALERKIN OPERATOR TO THE PRESSURE FIELD AND SUBTRACT IT FROM THE RHS
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(pData, rData, rhsData, aData)
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    int sIndx = 0;
+                    real aSum = 0.0;
+
+                    for (int dX = -1; dX <= 1; dX++) {
+                        for (int dY = -1; dY <= 1; dY++) {
+                            for (int dZ = -1; dZ <= 1; dZ++) {
+                                aSum += aData(iX, iY, iZ, sIndx)*pData(iX + dX, iY + dY, iZ + dZ);
+                                sIndx += 1;
+                            }
+                        }
+                    }
+
+                    rData(iX, iY, iZ) = rhsData(iX, iY, iZ) - aSum;
+                }
+            }
+        }
+
+        return;
+    }
+
     // Compute Laplacian of the pressure field and subtract it from the RHS of Poisson equation to obtain the residual
+    (this->*residualKernel)(rhsData);
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::computeFineResidual() {
+    // THE FINEST LEVEL HAS UNIT STRIDE, AND ITS POINTS ARE THE STAGGERED POINTS OF THE grid CLASS
 #pragma omp parallel for num_threads(inputParams.nThreads) default(none)
-    for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-        for (int iY = yStr; iY <= yEnd; iY += strideValues(vLevel)) {
-            for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                residualData(iX, iY, iZ) =  inputRHSData(iX, iY, iZ) -
-                                           (xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))/(hx(vLevel)*hx(vLevel)) +
-                                            xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))/(2.0*hx(vLevel)) +
-                                            ety2(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX, iY - strideValues(vLevel), iZ))/(hy(vLevel)*hy(vLevel)) +
-                                            etyy(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) - pressureData(iX, iY - strideValues(vLevel), iZ))/(2.0*hy(vLevel)) +
-                                            ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX, iY, iZ - strideValues(vLevel)))/(hz(vLevel)*hz(vLevel)) +
-                                            ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))/(2.0*hz(vLevel)));
+    for (int iX = xStr; iX <= xEnd(0); iX++) {
+        for (int iY = yStr; iY <= yEnd(0); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(0); iZ++) {
+                fineResidual(iX, iY, iZ) =  fineRHS(iX, iY, iZ) -
+                                           (mesh.xix2Staggr(iX) * (fineSolution(iX + 1, iY, iZ) - 2.0*fineSolution(iX, iY, iZ) + fineSolution(iX - 1, iY, iZ))/(mesh.dXi*mesh.dXi) +
+                                            mesh.xixxStaggr(iX) * (fineSolution(iX + 1, iY, iZ) - fineSolution(iX - 1, iY, iZ))/(2.0*mesh.dXi) +
+                                            mesh.ety2Staggr(iY) * (fineSolution(iX, iY + 1, iZ) - 2.0*fineSolution(iX, iY, iZ) + fineSolution(iX, iY - 1, iZ))/(mesh.dEt*mesh.dEt) +
+                                            mesh.etyyStaggr(iY) * (fineSolution(iX, iY + 1, iZ) - fineSolution(iX, iY - 1, iZ))/(2.0*mesh.dEt) +
+                                            mesh.ztz2Staggr(iZ) * (fineSolution(iX, iY, iZ + 1) - 2.0*fineSolution(iX, iY, iZ) + fineSolution(iX, iY, iZ - 1))/(mesh.dZt*mesh.dZt) +
+                                            mesh.ztzzStaggr(iZ) * (fineSolution(iX, iY, iZ + 1) - fineSolution(iX, iY, iZ - 1))/(2.0*mesh.dZt));
             }
         }
     }
+}
 
-    // Shift pressureData into smoothedPres
-    swap(smoothedPres, pressureData);
-    // Now pressureData = 0.0 (since smoothedPres was 0.0), and smoothedPres has the pre-smoothed values of pressure
+template <typename mgReal>
+template <bool xUniform, bool yUniform, bool zUniform>
+void multigrid_d3<mgReal>::residualSweep(const blitz::Array<mgReal, 3> &rhsData) {
+    mgReal xCoeff, yCoeff, zCoeff;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    xCoeff = xix2Coeff(vLevel, 0);
+    yCoeff = ety2Coeff(vLevel, 0);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    // THE POINTS ALONG Z ARE CONTIGUOUS, AND EACH LINE IS SWEPT THROUGH RAW POINTERS SO THAT THE INNERMOST LOOP IS VECTORIZED
+    // THE COEFFICIENTS AND TEMPORARIES ARE OF THE SAME PRECISION AS THE ARRAYS, SO THAT SINGLE PRECISION LEVELS USE THE FULL VECTOR WIDTH
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(pData, rData, rhsData) firstprivate(xCoeff, yCoeff, zCoeff)
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        mgReal x2Coeff = xUniform? xCoeff: xix2Coeff(vLevel, iX);
+        mgReal x1Coeff = xUniform? 0.0: xixxCoeff(vLevel, iX);
+
+        for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+            mgReal y2Coeff = yUniform? yCoeff: ety2Coeff(vLevel, iY);
+            mgReal y1Coeff = yUniform? 0.0: etyyCoeff(vLevel, iY);
+
+            const mgReal *pLine = &pData(iX, iY, 0);
+            const mgReal *xLft = &pData(iX - 1, iY, 0), *xRgt = &pData(iX + 1, iY, 0);
+            const mgReal *yFrn = &pData(iX, iY - 1, 0), *yBak = &pData(iX, iY + 1, 0);
+            const mgReal *z2Line = &ztz2Coeff(vLevel, 0), *z1Line = &ztzzCoeff(vLevel, 0);
+            const mgReal *fLine = &rhsData(iX, iY, 0);
+            mgReal *rLine = &rData(iX, iY, 0);
+
+#pragma omp simd
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                mgReal lapVal = x2Coeff * (xRgt[iZ] - 2*pLine[iZ] + xLft[iZ]) +
+                                y2Coeff * (yBak[iZ] - 2*pLine[iZ] + yFrn[iZ]) +
+                                (zUniform? zCoeff: z2Line[iZ]) * (pLine[iZ + 1] - 2*pLine[iZ] + pLine[iZ - 1]);
+
+                if (not xUniform) lapVal += x1Coeff * (xRgt[iZ] - xLft[iZ]);
+                if (not yUniform) lapVal += y1Coeff * (yBak[iZ] - yFrn[iZ]);
+                if (not zUniform) lapVal += z1Line[iZ] * (pLine[iZ + 1] - pLine[iZ - 1]);
+
+                rLine[iZ] = fLine[iZ] - lapVal;
+            }
+        }
+    }
+}
 
-    // RESTRICTION OPERATIONS
-    for (int i=0; i<inputParams.vcDepth; i++) {
-        // Direct-injection restriction simply increases the stride for accessing the memory by a factor of 2
-        // This is done by simply increasing the vLevel, which correspondingly reads the correct stride from strideValues array
-        vLevel += 1;
+template <typename mgReal>
+template <bool xUniform, bool yUniform, bool zUniform, bool findError>
+real multigrid_d3<mgReal>::pointSweep(const int colour, const int sweepRegion) {
+    int faceGap;
+    mgReal sorParam;
+    mgReal sweepMax;
+    mgReal xCoeff, yCoeff, zCoeff;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    sorParam = inputParams.sorParam;
+
+    xCoeff = xix2Coeff(vLevel, 0);
+    yCoeff = ety2Coeff(vLevel, 0);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    // THE STARTING INDEX ALONG Z IS CHOSEN SUCH THAT (iX + iY + iZ) HAS THE SAME PARITY AS colour
+    // SINCE THE POINTS OF ONE COLOUR DEPEND ONLY ON THOSE OF THE OTHER COLOUR, THE UPDATES ALONG A LINE ARE INDEPENDENT AND ARE VECTORIZED
+    // THE INVERSE OF THE DIAGONAL IS COMPUTED ONCE PER LINE WHEN THE GRID IS UNIFORM ALONG Z, AND AT EACH POINT OTHERWISE
+    // sweepRegion SELECTS THE LINES ALONG Z TO BE RELAXED - 0 FOR ALL THE LINES, 1 FOR THE LINES AWAY FROM THE FACES OF THE SUB-DOMAIN
+    // ALONG X AND Y, WHICH DO NOT USE THE PADS RECEIVED FROM THE NEIGHBOURING SUB-DOMAINS, AND 2 FOR THE LINES ON THESE FACES
+    // WHEN findError IS SET, THE MAXIMUM ABSOLUTE RESIDUAL AT THE RELAXED POINTS, JUST BEFORE THEY ARE RELAXED, IS RETURNED FOR THE
+    // CONVERGENCE CHECK OF solve. OTHERWISE IT IS NOT COMPUTED, AND THE SMOOTHER RETURNS 0
+    faceGap = (sweepRegion == 1)? 1: 0;
+    sweepMax = 0.0;
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(pData, rData) firstprivate(colour, sweepRegion, faceGap, sorParam, xCoeff, yCoeff, zCoeff) reduction(max:sweepMax)
+    for (int iX = xStr + faceGap; iX <= xEnd(vLevel) - faceGap; iX++) {
+        mgReal x2Coeff = xUniform? xCoeff: xix2Coeff(vLevel, iX);
+        mgReal x1Coeff = xUniform? 0.0: xixxCoeff(vLevel, iX);
+
+        // BETWEEN THE FACES ALONG X, ONLY THE FIRST AND LAST LINES ALONG Y LIE ON THE FACES OF THE SUB-DOMAIN
+        int yStep = (sweepRegion == 2 and iX > xStr and iX < xEnd(vLevel))? std::max(yEnd(vLevel) - yStr, 1): 1;
+
+        for (int iY = yStr + faceGap; iY <= yEnd(vLevel) - faceGap; iY += yStep) {
+            mgReal y2Coeff = yUniform? yCoeff: ety2Coeff(vLevel, iY);
+            mgReal y1Coeff = yUniform? 0.0: etyyCoeff(vLevel, iY);
+
+            mgReal lineCntr = 2*(x2Coeff + y2Coeff + zCoeff);
+            mgReal lineDiag = 1/lineCntr;
+
+            mgReal *pLine = &pData(iX, iY, 0);
+            const mgReal *xLft = &pData(iX - 1, iY, 0), *xRgt = &pData(iX + 1, iY, 0);
+            const mgReal *yFrn = &pData(iX, iY - 1, 0), *yBak = &pData(iX, iY + 1, 0);
+            const mgReal *z2Line = &ztz2Coeff(vLevel, 0), *z1Line = &ztzzCoeff(vLevel, 0);
+            const mgReal *rLine = &rData(iX, iY, 0);
+
+#pragma omp simd reduction(max:sweepMax)
+            for (int iZ = zStr + (iX + iY + colour) % 2; iZ <= zEnd(vLevel); iZ += 2) {
+                mgReal z2Coeff = zUniform? zCoeff: z2Line[iZ];
+                mgReal pCntr = zUniform? lineCntr: 2*(x2Coeff + y2Coeff + z2Coeff);
+
+                mgReal pSum = x2Coeff * (xRgt[iZ] + xLft[iZ]) +
+                              y2Coeff * (yBak[iZ] + yFrn[iZ]) +
+                              z2Coeff * (pLine[iZ + 1] + pLine[iZ - 1]) - rLine[iZ];
+
+                if (not xUniform) pSum += x1Coeff * (xRgt[iZ] - xLft[iZ]);
+                if (not yUniform) pSum += y1Coeff * (yBak[iZ] - yFrn[iZ]);
+                if (not zUniform) pSum += z1Line[iZ] * (pLine[iZ + 1] - pLine[iZ - 1]);
+
+                if (findError) sweepMax = std::max(sweepMax, mgReal(fabs(pSum - pCntr * pLine[iZ])));
+
+                pLine[iZ] = (1 - sorParam) * pLine[iZ] + sorParam * pSum * (zUniform? lineDiag: 1/pCntr);
+            }
+        }
     }
 
-    // SOLVE AT COARSEST MESH RESOLUTION
-    solve();
+    return sweepMax;
+}
 
-    // PROLONGATION OPERATIONS BACK TO FINE MESH
-    for (int i=0; i<inputParams.vcDepth; i++) {
-        prolong();
-        smooth(inputParams.interSmooth[i]);
+template <typename mgReal>
+template <bool xUniform, bool yUniform, bool zUniform>
+void multigrid_d3<mgReal>::planeSweep(const int iX, const int colour, const int padCount) {
+    int yLow, yTop;
+    mgReal sorParam;
+    mgReal x2Coeff, x1Coeff, zCoeff;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    sorParam = inputParams.sorParam;
+
+    x2Coeff = xix2Coeff(vLevel, xUniform? 0: iX);
+    x1Coeff = xUniform? 0.0: xixxCoeff(vLevel, iX);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    // padCount LAYERS OF THE PADS SHARED WITH THE NEIGHBOURING SUB-DOMAINS ALONG Y ARE RELAXED ALONG WITH THE CORE
+    yLow = (not inputParams.yPer and mesh.rankData.yRank == 0)? yStr: yStr - padCount;
+    yTop = (not inputParams.yPer and mesh.rankData.yRank == mesh.rankData.npY - 1)? yEnd(vLevel): yEnd(vLevel) + padCount;
+
+    // THE LINES OF THE PLANE ARE SHARED AMONG THE THREADS OF THE ENCLOSING PARALLEL REGION IN blockSweep
+    // EACH LINE IS RELAXED EXACTLY AS IN pointSweep, WITH THE PARITY TAKEN FROM THE ABSOLUTE VALUE SINCE THE INDICES OF THE PADS ARE NEGATIVE
+#pragma omp for
+    for (int iY = yLow; iY <= yTop; iY++) {
+        mgReal y2Coeff = ety2Coeff(vLevel, yUniform? 0: iY);
+        mgReal y1Coeff = yUniform? 0.0: etyyCoeff(vLevel, iY);
+
+        mgReal lineDiag = 1/(2*(x2Coeff + y2Coeff + zCoeff));
+
+        mgReal *pLine = &pData(iX, iY, 0);
+        const mgReal *xLft = &pData(iX - 1, iY, 0), *xRgt = &pData(iX + 1, iY, 0);
+        const mgReal *yFrn = &pData(iX, iY - 1, 0), *yBak = &pData(iX, iY + 1, 0);
+        const mgReal *z2Line = &ztz2Coeff(vLevel, 0), *z1Line = &ztzzCoeff(vLevel, 0);
+        const mgReal *rLine = &rData(iX, iY, 0);
+
+#pragma omp simd
+        for (int iZ = zStr + std::abs(iX + iY + colour) % 2; iZ <= zEnd(vLevel); iZ += 2) {
+            mgReal z2Coeff = zUniform? zCoeff: z2Line[iZ];
+
+            mgReal pSum = x2Coeff * (xRgt[iZ] + xLft[iZ]) +
+                          y2Coeff * (yBak[iZ] + yFrn[iZ]) +
+                          z2Coeff * (pLine[iZ + 1] + pLine[iZ - 1]) - rLine[iZ];
+
+            if (not xUniform) pSum += x1Coeff * (xRgt[iZ] - xLft[iZ]);
+            if (not yUniform) pSum += y1Coeff * (yBak[iZ] - yFrn[iZ]);
+            if (not zUniform) pSum += z1Line[iZ] * (pLine[iZ + 1] - pLine[iZ - 1]);
+
+            pLine[iZ] = (1 - sorParam) * pLine[iZ] + sorParam * pSum * (zUniform? lineDiag: 1/(2*(x2Coeff + y2Coeff + z2Coeff)));
+        }
     }
+}
 
-    pressureData += smoothedPres;
+template <typename mgReal>
+template <bool xUniform, bool yUniform, bool zUniform>
+void multigrid_d3<mgReal>::lineSystem(const int iX, const int iY,
+                                      blitz::Array<real, 1> &lowDiag, blitz::Array<real, 1> &diagVal, blitz::Array<real, 1> &uppDiag,
+                                      blitz::Array<real, 1> &lineVal) {
+    real xCoeff, yCoeff, zCoeff;
 
-    // POST-SMOOTHING
-    swap(inputRHSData, residualData);
-    smooth(inputParams.postSmooth);
-    swap(residualData, inputRHSData);
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    // THE COEFFICIENTS ALONG X AND Y ARE CONSTANT ALONG THE LINE, AND ALONG Z THEY ARE CONSTANT ONLY IF THE GRID IS UNIFORM ALONG Z
+    xCoeff = xix2Coeff(vLevel, iX);
+    yCoeff = ety2Coeff(vLevel, iY);
+    zCoeff = ztz2Coeff(vLevel, 0);
+
+    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+        if (zUniform) {
+            lowDiag(iZ) = zCoeff;
+            uppDiag(iZ) = zCoeff;
+
+            diagVal(iZ) = -2.0*(xCoeff + yCoeff + zCoeff);
+        } else {
+            lowDiag(iZ) = ztz2Coeff(vLevel, iZ) - ztzzCoeff(vLevel, iZ);
+            uppDiag(iZ) = ztz2Coeff(vLevel, iZ) + ztzzCoeff(vLevel, iZ);
+
+            diagVal(iZ) = -2.0*(xCoeff + yCoeff + ztz2Coeff(vLevel, iZ));
+        }
+
+        lineVal(iZ) = rData(iX, iY, iZ) -
+                     (xCoeff * (pData(iX + 1, iY, iZ) + pData(iX - 1, iY, iZ)) +
+                      yCoeff * (pData(iX, iY + 1, iZ) + pData(iX, iY - 1, iZ)));
+
+        if (not xUniform) lineVal(iZ) -= xixxCoeff(vLevel, iX) * (pData(iX + 1, iY, iZ) - pData(iX - 1, iY, iZ));
+        if (not yUniform) lineVal(iZ) -= etyyCoeff(vLevel, iY) * (pData(iX, iY + 1, iZ) - pData(iX, iY - 1, iZ));
+    }
 }
 
-void multigrid_d3::smooth(const int smoothCount) {
+template <typename mgReal>
+void multigrid_d3<mgReal>::smooth(const int smoothCount) {
 #ifdef TIME_RUN
     struct timeval begin, end;
 #endif
 
-    iteratorTemp = 0.0;
+    int colourCount, sweepCount;
+    bool splitSweep, padsPending;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
 
-    for(int n=0; n<smoothCount; n++) {
 #ifdef TIME_RUN
-        gettimeofday(&begin, NULL);
+    gettimeofday(&begin, NULL);
 #endif
 
-        // IMPOSE BOUNDARY CONDITION
-        imposeBC();
+    // IMPOSE BOUNDARY CONDITION ON ALL THE POINTS BEFORE THE FIRST SWEEP
+    // AT THE LEVELS USING DEEP PADS, THE RHS IS ALSO NEEDED AT THE POINTS OF THE PADS, WHICH ARE RELAXED ALONG WITH THE CORE
+    imposeBC(pData, haloLevel(vLevel)? 3: 2);
+    if (haloLevel(vLevel)) updatePads(residualData(vLevel), 3);
 
 #ifdef TIME_RUN
-        gettimeofday(&end, NULL);
-        smothTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+    gettimeofday(&end, NULL);
+    smothTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+#endif
 
-        gettimeofday(&begin, NULL);
+    // THE 27-POINT STENCIL OF THE GALERKIN OPERATOR ALSO COUPLES THE DIAGONAL NEIGHBOURS, WHICH HAVE THE SAME RED-BLACK COLOUR.
+    // HENCE AT THE LEVELS USING IT, THE POINTS ARE RELAXED IN 8 COLOURS (AND THE LINES IN 4 COLOURS), UPDATING ALL THE PADS AFTER EACH COLOUR
+    colourCount = 2;
+    if (inputParams.coarseOperator == 1 and vLevel > 0) colourCount = (inputParams.smoothType == 0)? 8: 4;
+
+    // WITH THE RED-BLACK POINT SMOOTHER, THE PADS OF EACH COLOUR ARE TRANSFERRED WHILE THE INTERIOR POINTS OF THE NEXT COLOUR ARE RELAXED
+    splitSweep = (inputParams.smoothType == 0 and colourCount == 2);
+    padsPending = false;
+
+    for(int n=0; n<smoothCount; n += sweepCount) {
+        // WITH THE RED-BLACK POINT SMOOTHER, UP TO sweepBlock CONSECUTIVE SWEEPS ARE FUSED INTO A SINGLE PASS OVER THE LEVEL
+        sweepCount = 1;
+        if (inputParams.smoothType == 0 and colourCount == 2) sweepCount = std::min(inputParams.sweepBlock, smoothCount - n);
+
+        if (sweepCount > 1) {
+#ifdef TIME_RUN
+            gettimeofday(&begin, NULL);
 #endif
 
-#pragma omp parallel for num_threads(inputParams.nThreads) default(none)
-        for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-            for (int iY = yStr; iY <= yEnd; iY += strideValues(vLevel)) {
-                for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                    iteratorTemp(iX, iY, iZ) = (hyhz(vLevel) * xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))*2.0 +
-                                                hyhz(vLevel) * xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))*hx(vLevel) +
-                                                hzhx(vLevel) * ety2(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) + pressureData(iX, iY - strideValues(vLevel), iZ))*2.0 +
-                                                hzhx(vLevel) * etyy(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) - pressureData(iX, iY - strideValues(vLevel), iZ))*hy(vLevel) +
-                                                hxhy(vLevel) * ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) + pressureData(iX, iY, iZ - strideValues(vLevel)))*2.0 +
-                                                hxhy(vLevel) * ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))*hz(vLevel) -
-                                        2.0 * hxhyhz(vLevel) * residualData(iX, iY, iZ))/
-                                        (4.0 * (hyhz(vLevel)*xix2(iX) + hzhx(vLevel)*ety2(iY) + hxhy(vLevel)*ztz2(iZ)));
-                }
-            }
-        }
+            blockSweep(sweepCount);
 
-        swap(iteratorTemp, pressureData);
+#ifdef TIME_RUN
+            gettimeofday(&end, NULL);
+            smothTimeComp += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+
+            gettimeofday(&begin, NULL);
+#endif
+
+            // THE PADS RECEIVED FROM THE NEIGHBOURING SUB-DOMAINS ARE UPDATED ONLY AFTER ALL THE SWEEPS OF THE BLOCK
+            imposeBC(pData, haloLevel(vLevel)? 3: 2);
 
 #ifdef TIME_RUN
-        gettimeofday(&end, NULL);
-        smothTimeComp += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+            gettimeofday(&end, NULL);
+            smothTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
 #endif
-    }
 
+        } else {
+            // RELAX THE RED POINTS (OR LINES) FIRST, AND THEN THE BLACK POINTS (OR LINES) USING THE UPDATED RED ONES
+            for (int colour=0; colour<colourCount; colour++) {
 #ifdef TIME_RUN
-    gettimeofday(&begin, NULL);
+                gettimeofday(&begin, NULL);
 #endif
 
-    imposeBC();
+                if (splitSweep) {
+                    // THE POINTS ON THE FACES OF THE SUB-DOMAIN ARE RELAXED ONLY AFTER THE PADS OF THE OTHER COLOUR HAVE ARRIVED
+                    (this->*pointKernel)(colour, 1);
+                    if (padsPending) {
+                        finishPadUpdate(pData, 1 - colour);
+                        imposeWallBC(pData);
+                    }
+                    (this->*pointKernel)(colour, 2);
+
+                } else if (inputParams.smoothType == 0) {
+                    gsSweep(colour);
+                } else {
+                    lineSweep(colour, false);
+                }
 
 #ifdef TIME_RUN
-    gettimeofday(&end, NULL);
-    smothTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+                gettimeofday(&end, NULL);
+                smothTimeComp += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+
+                gettimeofday(&begin, NULL);
 #endif
+
+                // IMPOSE BOUNDARY CONDITION ON THE POINTS OF THE COLOUR THAT WAS JUST RELAXED
+                // WHEN THE SWEEP IS SPLIT, ONLY THE PADS ALONG Z, WHICH ARE NEEDED BY THE INTERIOR POINTS, ARE SET BEFORE THE NEXT COLOUR
+                if (splitSweep) {
+                    beginPadUpdate(pData, colour);
+                    padsPending = true;
+
+                    pData(xMeshRange(vLevel), yMeshRange(vLevel), -1) = pData(xMeshRange(vLevel), yMeshRange(vLevel), inputParams.zPer? zEnd(vLevel) - 1: 1);
+                    pData(xMeshRange(vLevel), yMeshRange(vLevel), zEnd(vLevel) + 1) = pData(xMeshRange(vLevel), yMeshRange(vLevel), inputParams.zPer? 1: zEnd(vLevel) - 1);
+                } else {
+                    imposeBC(pData, (colourCount == 2)? colour: 2);
+                }
+
+#ifdef TIME_RUN
+                gettimeofday(&end, NULL);
+                smothTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+#endif
+            }
+        }
+    }
+
+    // THE TRANSFER STARTED AFTER THE LAST COLOUR IS COMPLETED BEFORE THE PADS ARE USED OUTSIDE THE SMOOTHER
+    if (padsPending) {
+        finishPadUpdate(pData, 1);
+        imposeWallBC(pData);
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::blockSweep(const int sweepCount) {
+    int stepCount, padDepth;
+    bool lftWall, rgtWall;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+
+    // AT THE LEVELS USING DEEP PADS, THE FIRST HALF-SWEEP ALSO RELAXES (2 x sweepCount - 1) LAYERS OF THE PADS SHARED WITH THE
+    // NEIGHBOURING SUB-DOMAINS, AND EACH SUBSEQUENT HALF-SWEEP RELAXES ONE LAYER LESS. THE PADS FACING THE WALLS ARE NEVER RELAXED
+    padDepth = haloLevel(vLevel)? 2*sweepCount - 1: 0;
+
+    lftWall = (not inputParams.xPer and mesh.rankData.xRank == 0);
+    rgtWall = (not inputParams.xPer and mesh.rankData.xRank == mesh.rankData.npX - 1);
+
+    // AT STEP wStep OF THE WAVEFRONT, THE HALF-SWEEP hSweep RELAXES THE PLANE iX = xStr - padDepth + wStep - hSweep, WITH THE RED AND
+    // BLACK HALF-SWEEPS ALTERNATING. SINCE THE HALF-SWEEPS OF A STEP ARE PERFORMED IN INCREASING ORDER, EACH PLANE IS RELAXED ONLY AFTER
+    // ITS NEIGHBOURING PLANES HAVE BEEN RELAXED BY THE PREVIOUS HALF-SWEEP, AND BEFORE THEY ARE RELAXED BY THE NEXT ONE
+    stepCount = xEnd(vLevel) - xStr + 2*padDepth + 2*sweepCount;
+
+    // THE THREADS SHARE THE LINES OF EACH PLANE, AND WAIT FOR ONE ANOTHER BEFORE MOVING TO THE NEXT PLANE
+#pragma omp parallel num_threads(inputParams.nThreads) default(none) shared(pData) firstprivate(sweepCount, stepCount, padDepth, lftWall, rgtWall)
+    {
+        for (int wStep = 0; wStep < stepCount; wStep++) {
+            for (int hSweep = 0; hSweep < 2*sweepCount; hSweep++) {
+                int padCount = std::max(padDepth - hSweep, 0);
+
+                int iX = xStr - padDepth + wStep - hSweep;
+                if (iX < xStr - (lftWall? 0: padCount) or iX > xEnd(vLevel) + (rgtWall? 0: padCount)) continue;
+
+                (this->*planeKernel)(iX, hSweep % 2, padCount);
+
+#pragma omp single
+                imposePlaneBC(pData, iX);
+            }
+        }
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::gsSweep(const int colour) {
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    if (inputParams.coarseOperator == 1 and vLevel > 0) {
+        blitz::Array<mgReal, 4> &aData = stencilData(vLevel);
+
+        // THE 8 COLOURS OF THE GALERKIN OPERATOR ARE GIVEN BY THE PARITIES OF iX, iY AND iZ. THE CENTRAL ENTRY OF THE STENCIL IS AT INDEX 13
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(pData, rData, aData) firstprivate(colour)
+        for (int iX = xStr + colour/4; iX <= xEnd(vLevel); iX += 2) {
+            for (int iY = yStr + (colour/2) % 2; iY <= yEnd(vLevel); iY += 2) {
+                for (int iZ = zStr + colour % 2; iZ <= zEnd(vLevel); iZ += 2) {
+                    int sIndx = 0;
+                    real aSum = rData(iX, iY, iZ);
+
+                    for (int dX = -1; dX <= 1; dX++) {
+                        for (int dY = -1; dY <= 1; dY++) {
+                            for (int dZ = -1; dZ <= 1; dZ++) {
+                                if (sIndx != 13) aSum -= aData(iX, iY, iZ, sIndx)*pData(iX + dX, iY + dY, iZ + dZ);
+                                sIndx += 1;
+                            }
+                        }
+                    }
+
+                    pData(iX, iY, iZ) = (1.0 - inputParams.sorParam) * pData(iX, iY, iZ) + inputParams.sorParam * aSum/aData(iX, iY, iZ, 13);
+                }
+            }
+        }
+
+        return;
+    }
+
+    (this->*pointKernel)(colour, 0);
+}
+
+template <typename mgReal>
+real multigrid_d3<mgReal>::lineSweep(const int colour, const bool findError) {
+    bool galerkinLevel;
+    real sweepMax;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    galerkinLevel = (inputParams.coarseOperator == 1 and vLevel > 0);
+
+    sweepMax = 0.0;
+
+    // EACH THREAD NEEDS ITS OWN ARRAYS TO HOLD THE TRIDIAGONAL SYSTEM OF THE LINE IT IS SOLVING
+    // THE STARTING INDEX ALONG Y IS CHOSEN SUCH THAT (iX + iY) HAS THE SAME PARITY AS colour
+    // WITH THE GALERKIN OPERATOR, THE 4 COLOURS ARE INSTEAD GIVEN BY THE PARITIES OF iX AND iY
+#pragma omp parallel num_threads(inputParams.nThreads) default(none) shared(pData, rData, galerkinLevel) firstprivate(colour, findError) reduction(max:sweepMax)
+    {
+        blitz::Array<real, 1> lowDiag(zEnd(vLevel) + 1), diagVal(zEnd(vLevel) + 1), uppDiag(zEnd(vLevel) + 1);
+        blitz::Array<real, 1> lineVal(zEnd(vLevel) + 1), workVal(zEnd(vLevel) + 1), corrVal(zEnd(vLevel) + 1);
+
+#pragma omp for
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            if (galerkinLevel and iX % 2 != colour/2) continue;
+
+            for (int iY = yStr + (galerkinLevel? colour % 2: (iX + colour) % 2); iY <= yEnd(vLevel); iY += 2) {
+                if (galerkinLevel) {
+                    blitz::Array<mgReal, 4> &aData = stencilData(vLevel);
+
+                    // THE ENTRIES AT INDICES 12, 13 AND 14 OF THE STENCIL COUPLE THE POINTS ALONG THE LINE
+                    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                        lowDiag(iZ) = aData(iX, iY, iZ, 12);
+                        diagVal(iZ) = aData(iX, iY, iZ, 13);
+                        uppDiag(iZ) = aData(iX, iY, iZ, 14);
+
+                        lineVal(iZ) = rData(iX, iY, iZ);
+                        for (int dX = -1; dX <= 1; dX++) {
+                            for (int dY = -1; dY <= 1; dY++) {
+                                if (dX == 0 and dY == 0) continue;
+
+                                for (int dZ = -1; dZ <= 1; dZ++) {
+                                    lineVal(iZ) -= aData(iX, iY, iZ, 9*(dX + 1) + 3*(dY + 1) + dZ + 1)*pData(iX + dX, iY + dY, iZ + dZ);
+                                }
+                            }
+                        }
+                    }
+                } else {
+                    (this->*lineKernel)(iX, iY, lowDiag, diagVal, uppDiag, lineVal);
+                }
+
+                // AS IN pointSweep, THE RESIDUAL AT THE POINTS OF THE LINE IS FOUND FROM THE SYSTEM OF THE LINE BEFORE THEY ARE RELAXED
+                if (findError) {
+                    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                        sweepMax = std::max(sweepMax, real(fabs(lineVal(iZ) - lowDiag(iZ)*pData(iX, iY, iZ - 1) - diagVal(iZ)*pData(iX, iY, iZ) -
+                                                                uppDiag(iZ)*pData(iX, iY, iZ + 1))));
+                    }
+                }
+
+                solveZLine(lowDiag, diagVal, uppDiag, lineVal, workVal, corrVal);
+
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    pData(iX, iY, iZ) = (1.0 - inputParams.sorParam) * pData(iX, iY, iZ) + inputParams.sorParam * lineVal(iZ);
+                }
+
+                // THE PADS ALONG Z ARE SET AS PER THE BOUNDARY CONDITIONS USED IN solveZLine, SINCE THE COARSEST LEVEL SOLVER DOES NOT IMPOSE THEM
+                pData(iX, iY, -1) = inputParams.zPer? pData(iX, iY, zEnd(vLevel) - 1): pData(iX, iY, 1);
+                pData(iX, iY, zEnd(vLevel) + 1) = inputParams.zPer? pData(iX, iY, 1): pData(iX, iY, zEnd(vLevel) - 1);
+            }
+        }
+    }
+
+    return sweepMax;
 }
 
-void multigrid_d3::solve() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::solve() {
 #ifdef TIME_RUN
     struct timeval begin, end;
 #endif
 
     int iterCount = 0;
-    real tempValue;
+    int colourCount;
+    bool splitSweep, padsPending, checkPending;
+    real sweepMax, redMax, blackMax, blackLast;
     real localMax, globalMax;
 
-    iteratorTemp = 0.0;
+    MPI_Request checkRequest;
+
+    blitz::Array<mgReal, 3> &pData = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &rData = residualData(vLevel);
+
+    // THE LU FACTORS OF THE DIRECT SOLVER ARE AVAILABLE ONLY FOR THE COARSEST LEVEL OF THE V-CYCLE
+    if (directCoarse and vLevel == inputParams.vcDepth) {
+        directSolve();
+        return;
+    }
+
+    // THE NUMBER OF COLOURS IS THE SAME AS IN smooth
+    colourCount = 2;
+    if (inputParams.coarseOperator == 1 and vLevel > 0) colourCount = (inputParams.smoothType == 0)? 8: 4;
+
+    // AS IN smooth, THE PADS OF THE RED POINTS ARE TRANSFERRED WHILE THE INTERIOR BLACK POINTS ARE RELAXED, AND THE PADS OF THE BLACK
+    // POINTS ARE TRANSFERRED WHILE THE INTERIOR RED POINTS OF THE NEXT ITERATION ARE RELAXED
+    splitSweep = (inputParams.smoothType == 0 and colourCount == 2);
+    padsPending = false;
+    checkPending = false;
+    redMax = blackMax = blackLast = 0.0;
 
     while (true) {
+        // RED-BLACK (OR MULTI-COLOUR) GAUSS-SEIDEL ITERATIVE SOLVER, RELAXING EITHER POINTS OR LINES ALONG Z
+        for (int colour=0; colour<colourCount; colour++) {
 #ifdef TIME_RUN
-        gettimeofday(&begin, NULL);
+            gettimeofday(&begin, NULL);
 #endif
 
-        // JACOBI ITERATIVE SOLVER
-#pragma omp parallel for num_threads(inputParams.nThreads) default(none)
-        for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-            for (int iY = yStr; iY <= yEnd; iY += strideValues(vLevel)) {
-                for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                    iteratorTemp(iX, iY, iZ) = (hyhz(vLevel) * xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) + iteratorTemp(iX - strideValues(vLevel), iY, iZ))*2.0 +
-                                                hyhz(vLevel) * xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - iteratorTemp(iX - strideValues(vLevel), iY, iZ))*hx(vLevel) +
-                                                hzhx(vLevel) * ety2(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) + iteratorTemp(iX, iY - strideValues(vLevel), iZ))*2.0 +
-                                                hzhx(vLevel) * etyy(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) - iteratorTemp(iX, iY - strideValues(vLevel), iZ))*hy(vLevel) +
-                                                hxhy(vLevel) * ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) + iteratorTemp(iX, iY, iZ - strideValues(vLevel)))*2.0 +
-                                                hxhy(vLevel) * ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - iteratorTemp(iX, iY, iZ - strideValues(vLevel)))*hz(vLevel) -
-                                        2.0 * hxhyhz(vLevel) * residualData(iX, iY, iZ))/
-                                      (4.0 * (hyhz(vLevel)*xix2(iX) + hzhx(vLevel)*ety2(iY) + hxhy(vLevel)*ztz2(iZ)));
+            if (splitSweep) {
+                sweepMax = (this->*checkKernel)(colour, 1);
+                if (padsPending) {
+                    finishPadUpdate(pData, 1 - colour);
+                    imposeWallBC(pData);
                 }
-            }
-        }
+                sweepMax = std::max(sweepMax, (this->*checkKernel)(colour, 2));
+
+                if (colour == 0) redMax = sweepMax; else blackMax = sweepMax;
 
-        swap(iteratorTemp, pressureData);
+            } else if (inputParams.smoothType == 0) {
+                gsSweep(colour);
+            } else {
+                // WITH 2 COLOURS, THE LINES GIVE THE RESIDUAL AT THEIR POINTS BEFORE THEY ARE RELAXED, JUST AS THE SPLIT POINT SWEEPS DO
+                sweepMax = lineSweep(colour, colourCount == 2);
+
+                if (colour == 0) redMax = sweepMax; else blackMax = sweepMax;
+            }
 
 #ifdef TIME_RUN
-        gettimeofday(&end, NULL);
-        solveTimeComp += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+            gettimeofday(&end, NULL);
+            solveTimeComp += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
 
-        gettimeofday(&begin, NULL);
+            gettimeofday(&begin, NULL);
 #endif
 
-        // Only the pads within the domain at the sub-domain boundaries are updated here.
-        // Boundary conditions are *NOT* applied while solving at the coarsest level.
-        // Boundary conditions are applied only while smoothing the solution.
-        updatePads();
+            // THE BOUNDARY CONDITIONS ARE IMPOSED AS IN smooth, SINCE THE PADS ALONG Z AND AT THE WALLS ARE READ BY THE NEXT COLOUR
+            // WHEN THE SWEEP IS SPLIT, ONLY THE PADS ALONG Z, WHICH ARE NEEDED BY THE INTERIOR POINTS, ARE SET BEFORE THE NEXT COLOUR
+            if (splitSweep) {
+                beginPadUpdate(pData, colour);
+                padsPending = true;
+
+                pData(xMeshRange(vLevel), yMeshRange(vLevel), -1) = pData(xMeshRange(vLevel), yMeshRange(vLevel), inputParams.zPer? zEnd(vLevel) - 1: 1);
+                pData(xMeshRange(vLevel), yMeshRange(vLevel), zEnd(vLevel) + 1) = pData(xMeshRange(vLevel), yMeshRange(vLevel), inputParams.zPer? 1: zEnd(vLevel) - 1);
+            } else {
+                imposeBC(pData, (colourCount == 2)? colour: 2);
+            }
 
 #ifdef TIME_RUN
-        gettimeofday(&end, NULL);
-        solveTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+            gettimeofday(&end, NULL);
+            solveTimeTran += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
+#endif
+        }
 
+#ifdef TIME_RUN
         gettimeofday(&begin, NULL);
 #endif
 
-        // Compute the Laplacian of pressure field and subtract the residual. Find the maximum of the absolute value of this difference
-        tempValue = 0.0;
-        localMax = -1.0e-10;
+        // THE REDUCTION STARTED AT THE PREVIOUS CHECK HAS PROCEEDED WHILE THE ABOVE ITERATION WAS PERFORMED
+        // IT IS COMPLETED AT THE SAME ITERATION ON ALL THE RANKS, SO THAT THEY ALL STOP TOGETHER
+        if (checkPending) {
+            MPI_Wait(&checkRequest, MPI_STATUS_IGNORE);
+            checkPending = false;
+
+            if (globalMax < inputParams.tolerance) {
+                break;
+            }
+        }
+
+        iterCount += 1;
+        if (iterCount > maxCount) {
+            if (mesh.rankData.rank == 0) std::cout << "ERROR: Gauss-Seidel iterations for solution at coarsest level not converging. Aborting" << std::endl;
+
+            MPI_Finalize();
+            exit(0);
+        }
 
+        // Find the maximum of the absolute value of the residual once every inputParams.checkInterval iterations
+        // When it is found within the sweeps, it is available only from the second iteration, since it lags by one iteration
         // Problem with Koenig lookup is that when using the function abs with blitz arrays, it automatically computes
         // the absolute of the float values without hitch.
         // When replacing with computing absolute of individual array elements in a loop, ADL chooses a version of
         // abs in the STL which **rounds off** the number.
         // In this case, abs has to be replaced with fabs.
-        for (int iX = xStr; iX <= xEnd; iX += strideValues(vLevel)) {
-            for (int iY = yStr; iY <= yEnd; iY += strideValues(vLevel)) {
-                for (int iZ = zStr; iZ <= zEnd; iZ += strideValues(vLevel)) {
-                    tempValue = fabs((xix2(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))/(hx(vLevel)*hx(vLevel)) +
-                                      xixx(iX) * (pressureData(iX + strideValues(vLevel), iY, iZ) - pressureData(iX - strideValues(vLevel), iY, iZ))/(2.0*hx(vLevel)) +
-                                      ety2(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX, iY - strideValues(vLevel), iZ))/(hy(vLevel)*hy(vLevel)) +
-                                      etyy(iY) * (pressureData(iX, iY + strideValues(vLevel), iZ) - pressureData(iX, iY - strideValues(vLevel), iZ))/(2.0*hy(vLevel)) +
-                                      ztz2(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - 2.0*pressureData(iX, iY, iZ) + pressureData(iX, iY, iZ - strideValues(vLevel)))/(hz(vLevel)*hz(vLevel)) +
-                                      ztzz(iZ) * (pressureData(iX, iY, iZ + strideValues(vLevel)) - pressureData(iX, iY, iZ - strideValues(vLevel)))/(2.0*hz(vLevel))) - residualData(iX, iY, iZ));
-
-                    if (tempValue > localMax) {
-                        localMax = tempValue;
+        if (iterCount % inputParams.checkInterval == 0 and not (colourCount == 2 and iterCount == 1)) {
+            if (colourCount == 2) {
+                // THE RED SWEEP GIVES THE RESIDUAL AT THE RED POINTS OF THE SOLUTION LEFT BY THE PREVIOUS ITERATION. THE BLACK SWEEP OF THAT
+                // ITERATION GAVE THE RESIDUAL AT THE BLACK POINTS BEFORE THEY WERE RELAXED, WHICH THE RELAXATION SCALED BY (1 - SOR PARAMETER)
+                localMax = std::max(redMax, real(fabs(1.0 - inputParams.sorParam))*blackLast);
+            } else {
+                localMax = 0.0;
+
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(pData, rData) reduction(max:localMax)
+                for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                    blitz::TinyVector<real, 27> aVal;
+
+                    for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                            getStencil(iX, iY, iZ, aVal);
+
+                            real tempValue = -rData(iX, iY, iZ);
+                            for (int dX = -1; dX <= 1; dX++) {
+                                for (int dY = -1; dY <= 1; dY++) {
+                                    for (int dZ = -1; dZ <= 1; dZ++) {
+                                        tempValue += aVal(9*(dX + 1) + 3*(dY + 1) + dZ + 1)*pData(iX + dX, iY + dY, iZ + dZ);
+                                    }
+                                }
+                            }
+
+                            localMax = std::max(localMax, real(fabs(tempValue)));
+                        }
                     }
                 }
             }
-        }
 
-        MPI_Allreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD);
-        if (globalMax < inputParams.tolerance) {
-            break;
+            MPI_Iallreduce(&localMax, &globalMax, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD, &checkRequest);
+            checkPending = true;
         }
 
-        MPI_Barrier(MPI_COMM_WORLD);
-        iterCount += 1;
-        if (iterCount > maxCount) {
-            if (mesh.rankData.rank == 0) std::cout << "ERROR: Jacobi iterations for solution at coarsest level not converging. Aborting" << std::endl;
-
-            MPI_Finalize();
-            exit(0);
-        }
+        blackLast = blackMax;
 
 #ifdef TIME_RUN
         gettimeofday(&end, NULL);
         solveTimeComp += ((end.tv_sec - begin.tv_sec)*1000000u + end.tv_usec - begin.tv_usec)/1.e6;
 #endif
     }
+
+    // THE PADS OF THE BLACK POINTS OF THE LAST ITERATION ARE RECEIVED BEFORE THE SOLUTION IS USED FURTHER
+    if (padsPending) {
+        finishPadUpdate(pData, 1);
+        imposeWallBC(pData);
+    }
+
+    // THE ITERATIONS LEAVE THE MEAN OF THE SOLUTION UNDETERMINED, AND IT IS PINNED TO ZERO
+    removeNullSpace(rData, pData);
 }
 
-void multigrid_d3::prolong() {
-    // Integer values of starting indices, ending indices, and index increments along each direction
-    int xSt, xEn, xIn;
-    int ySt, yEn, yIn;
-    int zSt, zEn, zIn;
+template <typename mgReal>
+void multigrid_d3<mgReal>::coarsen() {
+    int xRatio, yRatio, zRatio;
 
-    vLevel -= 1;
+    blitz::Array<mgReal, 3> &rFine = residualData(vLevel);
+    blitz::Array<mgReal, 3> &rCors = residualData(vLevel + 1);
 
-    // NOTE: Currently interpolating along X first, then Y and finally Z.
-    // Test and see if this order is better or the other order, with Z first, then Y and X is better
-    // Depending on the order of variables in memory, one of these will give better performance
+    // RATIO OF THE STRIDES OF THE COARSER AND FINER LEVELS ALONG EACH DIRECTION. IT IS 1 ALONG A DIRECTION WHICH IS NOT COARSENED
+    xRatio = strideValues(vLevel + 1, 0)/strideValues(vLevel, 0);
+    yRatio = strideValues(vLevel + 1, 1)/strideValues(vLevel, 1);
+    zRatio = strideValues(vLevel + 1, 2)/strideValues(vLevel, 2);
+
+    if (inputParams.restrictOp == 1) {
+        // FULL-WEIGHTING NEEDS THE RESIDUAL AT THE PADS (INCLUDING EDGES AND CORNERS) OF THE FINER LEVEL
+        imposeBC(rFine, 2);
 
-    // Maybe the below values can be stored in some array instead of recomputing in each prolongation step
+        vLevel += 1;
 
-    // INTERPOLATE VARIABLE DATA ALONG X-DIRECTION
-    xSt = stagCore.lbound(0) + strideValues(vLevel);
-    xEn = stagCore.ubound(0) - strideValues(vLevel);
-    xIn = strideValues(vLevel+1);
+        if (xRatio == 2 and yRatio == 2 and zRatio == 2) {
+            // FULL-WEIGHTING - TENSOR PRODUCT OF THE 1D WEIGHTS (1/4, 1/2, 1/4) OVER THE 27 POINTS AROUND EACH COINCIDENT POINT
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(rFine, rCors)
+            for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                        int i2 = 2*iX;
+                        int j2 = 2*iY;
+                        int k2 = 2*iZ;
+
+                        rCors(iX, iY, iZ) = (8.0*rFine(i2, j2, k2) +
+                                             4.0*(rFine(i2 + 1, j2, k2) + rFine(i2 - 1, j2, k2) +
+                                                  rFine(i2, j2 + 1, k2) + rFine(i2, j2 - 1, k2) +
+                                                  rFine(i2, j2, k2 + 1) + rFine(i2, j2, k2 - 1)) +
+                                             2.0*(rFine(i2 + 1, j2 + 1, k2) + rFine(i2 + 1, j2 - 1, k2) + rFine(i2 - 1, j2 + 1, k2) + rFine(i2 - 1, j2 - 1, k2) +
+                                                  rFine(i2 + 1, j2, k2 + 1) + rFine(i2 + 1, j2, k2 - 1) + rFine(i2 - 1, j2, k2 + 1) + rFine(i2 - 1, j2, k2 - 1) +
+                                                  rFine(i2, j2 + 1, k2 + 1) + rFine(i2, j2 + 1, k2 - 1) + rFine(i2, j2 - 1, k2 + 1) + rFine(i2, j2 - 1, k2 - 1)) +
+                                                  rFine(i2 + 1, j2 + 1, k2 + 1) + rFine(i2 + 1, j2 + 1, k2 - 1) + rFine(i2 + 1, j2 - 1, k2 + 1) + rFine(i2 + 1, j2 - 1, k2 - 1) +
+                                                  rFine(i2 - 1, j2 + 1, k2 + 1) + rFine(i2 - 1, j2 + 1, k2 - 1) + rFine(i2 - 1, j2 - 1, k2 + 1) + rFine(i2 - 1, j2 - 1, k2 - 1))/64.0;
+                    }
+                }
+            }
 
-    ySt = stagCore.lbound(1);
-    yEn = stagCore.ubound(1);
-    yIn = strideValues(vLevel+1);
+        } else {
+            // SEMI-COARSENED FULL-WEIGHTING - THE 1D WEIGHTS ARE (1/4, 1/2, 1/4) ALONG A COARSENED DIRECTION, AND 1 ALONG THE OTHERS
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(xRatio, yRatio, zRatio, rFine, rCors)
+            for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                        real rSum = 0.0;
+
+                        for (int dX = 1 - xRatio; dX <= xRatio - 1; dX++) {
+                            for (int dY = 1 - yRatio; dY <= yRatio - 1; dY++) {
+                                for (int dZ = 1 - zRatio; dZ <= zRatio - 1; dZ++) {
+                                    rSum += (xRatio - abs(dX))*(yRatio - abs(dY))*(zRatio - abs(dZ))*rFine(xRatio*iX + dX, yRatio*iY + dY, zRatio*iZ + dZ);
+                                }
+                            }
+                        }
+
+                        rCors(iX, iY, iZ) = rSum/(xRatio*xRatio*yRatio*yRatio*zRatio*zRatio);
+                    }
+                }
+            }
+        }
 
-    zSt = stagCore.lbound(2);
-    zEn = stagCore.ubound(2);
-    zIn = strideValues(vLevel+1);
+    } else {
+        vLevel += 1;
 
-    for (int iX = xSt; iX <= xEn; iX += xIn) {
-        for (int iY = ySt; iY <= yEn; iY += yIn) {
-            for (int iZ = zSt; iZ <= zEn; iZ += zIn) {
-                pressureData(iX, iY, iZ) = (pressureData(iX + strideValues(vLevel), iY, iZ) + pressureData(iX - strideValues(vLevel), iY, iZ))/2.0;
-                residualData(iX, iY, iZ) = (residualData(iX + strideValues(vLevel), iY, iZ) + residualData(iX - strideValues(vLevel), iY, iZ))/2.0;
+        // DIRECT INJECTION - THE COINCIDENT POINTS OF THE FINER LEVEL ARE COPIED INTO THE CONTIGUOUS ARRAY OF THE COARSER LEVEL
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(xRatio, yRatio, zRatio, rFine, rCors)
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    rCors(iX, iY, iZ) = rFine(xRatio*iX, yRatio*iY, zRatio*iZ);
+                }
             }
         }
     }
 
-    // INTERPOLATE VARIABLE DATA ALONG Y-DIRECTION
-    xSt = stagCore.lbound(0);
-    xEn = stagCore.ubound(0);
-    xIn = strideValues(vLevel);
+    // THE CORRECTION COMPUTED AT THE COARSER LEVEL STARTS FROM A ZERO INITIAL GUESS
+    pressureData(vLevel) = 0.0;
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::prolong() {
+    int xRatio, yRatio, zRatio;
+
+    vLevel -= 1;
 
-    ySt = stagCore.lbound(1) + strideValues(vLevel);
-    yEn = stagCore.ubound(1) - strideValues(vLevel);
-    yIn = strideValues(vLevel+1);
+    // RATIO OF THE STRIDES OF THE COARSER AND FINER LEVELS ALONG EACH DIRECTION. IT IS 1 ALONG A DIRECTION WHICH IS NOT COARSENED
+    xRatio = strideValues(vLevel + 1, 0)/strideValues(vLevel, 0);
+    yRatio = strideValues(vLevel + 1, 1)/strideValues(vLevel, 1);
+    zRatio = strideValues(vLevel + 1, 2)/strideValues(vLevel, 2);
 
-    zSt = stagCore.lbound(2);
-    zEn = stagCore.ubound(2);
-    zIn = strideValues(vLevel+1);
+    blitz::Array<mgReal, 3> &pFine = pressureData(vLevel);
+    blitz::Array<mgReal, 3> &pCors = pressureData(vLevel + 1);
 
-    for (int iX = xSt; iX <= xEn; iX += xIn) {
-        for (int iY = ySt; iY <= yEn; iY += yIn) {
-            for (int iZ = zSt; iZ <= zEn; iZ += zIn) {
-                pressureData(iX, iY, iZ) = (pressureData(iX, iY + strideValues(vLevel), iZ) + pressureData(iX, iY - strideValues(vLevel), iZ))/2.0;
-                residualData(iX, iY, iZ) = (residualData(iX, iY + strideValues(vLevel), iZ) + residualData(iX, iY - strideValues(vLevel), iZ))/2.0;
+    // NOTE: Currently interpolating along X first, then Y and finally Z.
+    // Test and see if this order is better or the other order, with Z first, then Y and X is better
+    // Depending on the order of variables in memory, one of these will give better performance
+
+    // COPY THE POINTS OF THE COARSER LEVEL ONTO THE COINCIDENT POINTS OF THE FINER LEVEL
+    for (int iX = xStr; iX <= xEnd(vLevel + 1); iX++) {
+        for (int iY = yStr; iY <= yEnd(vLevel + 1); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel + 1); iZ++) {
+                pFine(xRatio*iX, yRatio*iY, zRatio*iZ) = pCors(iX, iY, iZ);
             }
         }
     }
 
-    // INTERPOLATE VARIABLE DATA ALONG Z-DIRECTION
-    xSt = stagCore.lbound(0);
-    xEn = stagCore.ubound(0);
-    xIn = strideValues(vLevel);
+    if (inputParams.coarseOperator == 1) {
+        // OPERATOR-DEPENDENT INTERPOLATION - EACH NON-COINCIDENT POINT SATISFIES THE HOMOGENEOUS EQUATION OF THE FINER LEVEL, WITH ITS
+        // STENCIL COLLAPSED ALONG THE DIRECTIONS IN WHICH ITS INDEX IS EVEN. THE POINTS WITH ONE ODD INDEX ARE INTERPOLATED FIRST,
+        // FOLLOWED BY THOSE WITH TWO AND THREE ODD INDICES, SO THAT ALL THE NEIGHBOURS USED BY A POINT ARE ALREADY AVAILABLE
+        for (int oddCount = 1; oddCount <= 3; oddCount++) {
+#pragma omp parallel for num_threads(inputParams.nThreads) default(none) shared(xRatio, yRatio, zRatio, pFine) firstprivate(oddCount)
+            for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+                for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                    for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                        int oX = (xRatio == 2)? iX % 2: 0;
+                        int oY = (yRatio == 2)? iY % 2: 0;
+                        int oZ = (zRatio == 2)? iZ % 2: 0;
+
+                        if (oX + oY + oZ != oddCount) continue;
+
+                        real cSum = 0.0;
+                        real nSum = 0.0;
+                        blitz::TinyVector<real, 27> aVal;
+
+                        getStencil(iX, iY, iZ, aVal);
+
+                        for (int dX = -1; dX <= 1; dX++) {
+                            for (int dY = -1; dY <= 1; dY++) {
+                                for (int dZ = -1; dZ <= 1; dZ++) {
+                                    if (oX*dX == 0 and oY*dY == 0 and oZ*dZ == 0) {
+                                        cSum += aVal(9*(dX + 1) + 3*(dY + 1) + dZ + 1);
+                                    } else {
+                                        nSum += aVal(9*(dX + 1) + 3*(dY + 1) + dZ + 1)*pFine(iX + oX*dX, iY + oY*dY, iZ + oZ*dZ);
+                                    }
+                                }
+                            }
+                        }
+
+                        pFine(iX, iY, iZ) = -nSum/cSum;
+                    }
+                }
+            }
+        }
 
-    ySt = stagCore.lbound(1);
-    yEn = stagCore.ubound(1);
-    yIn = strideValues(vLevel);
+        return;
+    }
 
-    zSt = stagCore.lbound(2) + strideValues(vLevel);
-    zEn = stagCore.ubound(2) - strideValues(vLevel);
-    zIn = strideValues(vLevel+1);
+    // INTERPOLATE VARIABLE DATA ALONG X-DIRECTION, IF IT WAS COARSENED
+    if (xRatio == 2) {
+        for (int iX = xStr + 1; iX <= xEnd(vLevel) - 1; iX += 2) {
+            for (int iY = yStr; iY <= yEnd(vLevel); iY += yRatio) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ += zRatio) {
+                    pFine(iX, iY, iZ) = (pFine(iX + 1, iY, iZ) + pFine(iX - 1, iY, iZ))/2.0;
+                }
+            }
+        }
+    }
+
+    // INTERPOLATE VARIABLE DATA ALONG Y-DIRECTION, IF IT WAS COARSENED
+    if (yRatio == 2) {
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iY = yStr + 1; iY <= yEnd(vLevel) - 1; iY += 2) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ += zRatio) {
+                    pFine(iX, iY, iZ) = (pFine(iX, iY + 1, iZ) + pFine(iX, iY - 1, iZ))/2.0;
+                }
+            }
+        }
+    }
 
-    for (int iX = xSt; iX <= xEn; iX += xIn) {
-        for (int iY = ySt; iY <= yEn; iY += yIn) {
-            for (int iZ = zSt; iZ <= zEn; iZ += zIn) {
-                pressureData(iX, iY, iZ) = (pressureData(iX, iY, iZ + strideValues(vLevel)) + pressureData(iX, iY, iZ - strideValues(vLevel)))/2.0;
-                residualData(iX, iY, iZ) = (residualData(iX, iY, iZ + strideValues(vLevel)) + residualData(iX, iY, iZ - strideValues(vLevel)))/2.0;
+    // INTERPOLATE VARIABLE DATA ALONG Z-DIRECTION, IF IT WAS COARSENED
+    if (zRatio == 2) {
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                for (int iZ = zStr + 1; iZ <= zEnd(vLevel) - 1; iZ += 2) {
+                    pFine(iX, iY, iZ) = (pFine(iX, iY, iZ + 1) + pFine(iX, iY, iZ - 1))/2.0;
+                }
             }
         }
     }
 }
 
-void multigrid_d3::setLocalSizeIndex() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::setLocalSizeIndex() {
     localSizeIndex = blitz::TinyVector<int, 3>(mesh.sizeIndex(0) - int(log2(inputParams.npX)),
                                                mesh.sizeIndex(1) - int(log2(inputParams.npY)),
                                                mesh.sizeIndex(2));
 }
 
-void multigrid_d3::setStagBounds() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::setStagBounds() {
     blitz::TinyVector<int, 3> loBound, upBound;
 
-    // LOWER BOUND AND UPPER BOUND OF STAGGERED CORE - USED TO CONSTRUCT THE CORE SLICE
-    loBound = 0, 0, 0;
-    upBound = mgSizeArray(localSizeIndex(0)) - 1, mgSizeArray(localSizeIndex(1)) - 1, mgSizeArray(localSizeIndex(2)) - 1;
-    stagCore = blitz::RectDomain<3>(loBound, upBound);
+    stagCore.resize(inputParams.vcDepth + 1);
+    stagFull.resize(inputParams.vcDepth + 1);
 
-    // LOWER BOUND AND UPPER BOUND OF STAGGERED FULL SUB-DOMAIN - USED TO CONSTRUCT THE FULL SUB-DOMAIN SLICE
-    loBound = -strideValues(inputParams.vcDepth), -strideValues(inputParams.vcDepth), -strideValues(inputParams.vcDepth);
-    upBound = stagCore.ubound() - loBound;
-    stagFull = blitz::RectDomain<3>(loBound, upBound);
+    for (int i=0; i<=inputParams.vcDepth; i++) {
+        // LOWER BOUND AND UPPER BOUND OF STAGGERED CORE - USED TO CONSTRUCT THE CORE SLICE
+        loBound = 0, 0, 0;
+        upBound = (mgSizeArray(localSizeIndex(0)) - 1)/strideValues(i, 0),
+                  (mgSizeArray(localSizeIndex(1)) - 1)/strideValues(i, 1),
+                  (mgSizeArray(localSizeIndex(2)) - 1)/strideValues(i, 2);
+        stagCore(i) = blitz::RectDomain<3>(loBound, upBound);
+
+        // LOWER BOUND AND UPPER BOUND OF STAGGERED FULL SUB-DOMAIN - USED TO CONSTRUCT THE FULL SUB-DOMAIN SLICE
+        // THE PADS ALONG X AND Y ARE haloDepth POINTS DEEP, WHILE ALONG Z, WHICH IS NEVER DECOMPOSED, THEY ARE ALWAYS 1 POINT DEEP
+        loBound = -inputParams.haloDepth, -inputParams.haloDepth, -1;
+        upBound = stagCore(i).ubound() - loBound;
+        stagFull(i) = blitz::RectDomain<3>(loBound, upBound);
+    }
 }
 
-void multigrid_d3::setCoefficients() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::setCoefficients() {
     hx.resize(inputParams.vcDepth + 1);
     hy.resize(inputParams.vcDepth + 1);
     hz.resize(inputParams.vcDepth + 1);
@@ -389,87 +1128,195 @@ void multigrid_d3::setCoefficients() {
     hxhyhz.resize(inputParams.vcDepth + 1);
 
     for(int i=0; i<=inputParams.vcDepth; i++) {
-        hx(i) = strideValues(i)*mesh.dXi;
-        hy(i) = strideValues(i)*mesh.dEt;
-        hz(i) = strideValues(i)*mesh.dZt;
+        hx(i) = strideValues(i, 0)*mesh.dXi;
+        hy(i) = strideValues(i, 1)*mesh.dEt;
+        hz(i) = strideValues(i, 2)*mesh.dZt;
 
-        hxhy(i) = pow(strideValues(i), 4.0)*pow(mesh.dXi, 2.0)*pow(mesh.dEt, 2.0);
-        hyhz(i) = pow(strideValues(i), 4.0)*pow(mesh.dEt, 2.0)*pow(mesh.dZt, 2.0);
-        hzhx(i) = pow(strideValues(i), 4.0)*pow(mesh.dZt, 2.0)*pow(mesh.dXi, 2.0);
+        hxhy(i) = pow(hx(i), 2.0)*pow(hy(i), 2.0);
+        hyhz(i) = pow(hy(i), 2.0)*pow(hz(i), 2.0);
+        hzhx(i) = pow(hz(i), 2.0)*pow(hx(i), 2.0);
 
-        hxhyhz(i) = pow(strideValues(i), 6.0)*pow(mesh.dXi, 2.0)*pow(mesh.dEt, 2.0)*pow(mesh.dZt, 2.0);
+        hxhyhz(i) = pow(hx(i), 2.0)*pow(hy(i), 2.0)*pow(hz(i), 2.0);
     }
 }
 
-void multigrid_d3::copyStaggrDerivs() {
-    xixx.resize(stagFull.ubound(0) - stagFull.lbound(0) + 1);
-    xixx.reindexSelf(stagFull.lbound(0));
+template <typename mgReal>
+void multigrid_d3<mgReal>::copyStaggrDerivs() {
+    xixx.resize(inputParams.vcDepth + 1, stagFull(0).ubound(0) - stagFull(0).lbound(0) + 1);
+    xixx.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(0)));
     xixx = 0.0;
-    xixx(blitz::Range(0, stagCore.ubound(0), 1)) = mesh.xixxStaggr(blitz::Range(0, stagCore.ubound(0), 1));
 
-    xix2.resize(stagFull.ubound(0) - stagFull.lbound(0) + 1);
-    xix2.reindexSelf(stagFull.lbound(0));
+    xix2.resize(inputParams.vcDepth + 1, stagFull(0).ubound(0) - stagFull(0).lbound(0) + 1);
+    xix2.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(0)));
     xix2 = 0.0;
-    xix2(blitz::Range(0, stagCore.ubound(0), 1)) = mesh.xix2Staggr(blitz::Range(0, stagCore.ubound(0), 1));
 
-    etyy.resize(stagFull.ubound(1) - stagFull.lbound(1) + 1);
-    etyy.reindexSelf(stagFull.lbound(1));
+    etyy.resize(inputParams.vcDepth + 1, stagFull(0).ubound(1) - stagFull(0).lbound(1) + 1);
+    etyy.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(1)));
     etyy = 0.0;
-    etyy(blitz::Range(0, stagCore.ubound(1), 1)) = mesh.etyyStaggr(blitz::Range(0, stagCore.ubound(1), 1));
 
-    ety2.resize(stagFull.ubound(1) - stagFull.lbound(1) + 1);
-    ety2.reindexSelf(stagFull.lbound(1));
+    ety2.resize(inputParams.vcDepth + 1, stagFull(0).ubound(1) - stagFull(0).lbound(1) + 1);
+    ety2.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(1)));
     ety2 = 0.0;
-    ety2(blitz::Range(0, stagCore.ubound(1), 1)) = mesh.ety2Staggr(blitz::Range(0, stagCore.ubound(1), 1));
 
-    ztzz.resize(stagFull.ubound(2) - stagFull.lbound(2) + 1);
-    ztzz.reindexSelf(stagFull.lbound(2));
+    ztzz.resize(inputParams.vcDepth + 1, stagFull(0).ubound(2) - stagFull(0).lbound(2) + 1);
+    ztzz.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(2)));
     ztzz = 0.0;
-    ztzz(blitz::Range(0, stagCore.ubound(2), 1)) = mesh.ztzzStaggr(blitz::Range(0, stagCore.ubound(2), 1));
 
-    ztz2.resize(stagFull.ubound(2) - stagFull.lbound(2) + 1);
-    ztz2.reindexSelf(stagFull.lbound(2));
+    ztz2.resize(inputParams.vcDepth + 1, stagFull(0).ubound(2) - stagFull(0).lbound(2) + 1);
+    ztz2.reindexSelf(blitz::TinyVector<int, 2>(0, stagFull(0).lbound(2)));
     ztz2 = 0.0;
-    ztz2(blitz::Range(0, stagCore.ubound(2), 1)) = mesh.ztz2Staggr(blitz::Range(0, stagCore.ubound(2), 1));
+
+    // THE iTH POINT OF A LEVEL COINCIDES WITH THE (i x stride)TH POINT OF THE FINEST LEVEL
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        xixx(i, xMeshRange(i)) = mesh.xixxStaggr(blitz::Range(0, stagCore(0).ubound(0), strideValues(i, 0)));
+        xix2(i, xMeshRange(i)) = mesh.xix2Staggr(blitz::Range(0, stagCore(0).ubound(0), strideValues(i, 0)));
+
+        etyy(i, yMeshRange(i)) = mesh.etyyStaggr(blitz::Range(0, stagCore(0).ubound(1), strideValues(i, 1)));
+        ety2(i, yMeshRange(i)) = mesh.ety2Staggr(blitz::Range(0, stagCore(0).ubound(1), strideValues(i, 1)));
+
+        ztzz(i, zMeshRange(i)) = mesh.ztzzStaggr(blitz::Range(0, stagCore(0).ubound(2), strideValues(i, 2)));
+        ztz2(i, zMeshRange(i)) = mesh.ztz2Staggr(blitz::Range(0, stagCore(0).ubound(2), strideValues(i, 2)));
+    }
+
+    // THE METRICS DIVIDED BY THE GRID SPACINGS OF EACH LEVEL ARE THE COEFFICIENTS OF THE LAPLACIAN USED BY ITS KERNELS
+    // THEY ARE COMPUTED ONCE HERE SO THAT THE KERNELS DO NOT DIVIDE BY THE GRID SPACINGS AT EVERY POINT
+    xixxCoeff.resize(xixx.shape());         xixxCoeff.reindexSelf(xixx.lbound());
+    xix2Coeff.resize(xix2.shape());         xix2Coeff.reindexSelf(xix2.lbound());
+    etyyCoeff.resize(etyy.shape());         etyyCoeff.reindexSelf(etyy.lbound());
+    ety2Coeff.resize(ety2.shape());         ety2Coeff.reindexSelf(ety2.lbound());
+    ztzzCoeff.resize(ztzz.shape());         ztzzCoeff.reindexSelf(ztzz.lbound());
+    ztz2Coeff.resize(ztz2.shape());         ztz2Coeff.reindexSelf(ztz2.lbound());
+
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        for (int iX = xixx.lbound(1); iX <= xixx.ubound(1); iX++) {
+            xixxCoeff(i, iX) = xixx(i, iX)/(2.0*hx(i));
+            xix2Coeff(i, iX) = xix2(i, iX)/(hx(i)*hx(i));
+        }
+
+        for (int iY = etyy.lbound(1); iY <= etyy.ubound(1); iY++) {
+            etyyCoeff(i, iY) = etyy(i, iY)/(2.0*hy(i));
+            ety2Coeff(i, iY) = ety2(i, iY)/(hy(i)*hy(i));
+        }
+
+        for (int iZ = ztzz.lbound(1); iZ <= ztzz.ubound(1); iZ++) {
+            ztzzCoeff(i, iZ) = ztzz(i, iZ)/(2.0*hz(i));
+            ztz2Coeff(i, iZ) = ztz2(i, iZ)/(hz(i)*hz(i));
+        }
+    }
+
+    // AT THE LEVELS USING DEEP PADS, THE COEFFICIENTS ALONG X AND Y ARE ALSO NEEDED AT THE POINTS OF THE PADS
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        if (haloLevel(i)) {
+            shareCoefficients(xixxCoeff, i, xEnd(i), mesh.rankData.nearRanks(0), mesh.rankData.nearRanks(1));
+            shareCoefficients(xix2Coeff, i, xEnd(i), mesh.rankData.nearRanks(0), mesh.rankData.nearRanks(1));
+            shareCoefficients(etyyCoeff, i, yEnd(i), mesh.rankData.nearRanks(2), mesh.rankData.nearRanks(3));
+            shareCoefficients(ety2Coeff, i, yEnd(i), mesh.rankData.nearRanks(2), mesh.rankData.nearRanks(3));
+        }
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::setKernels() {
+    int kernelIndex;
+
+    // THE METRICS ARE CONSTANT AND THE FIRST DERIVATIVE TERMS VANISH ALONG THE DIRECTIONS OF UNIFORM GRID
+    // EACH COMBINATION OF UNIFORM DIRECTIONS HAS ITS OWN SET OF KERNELS, WHICH ARE INSTANTIATED AT COMPILE TIME
+    kernelIndex = 4*(inputParams.xGrid == 0) + 2*(inputParams.yGrid == 0) + (inputParams.zGrid == 0);
+
+    switch (kernelIndex) {
+        case 0: selectKernels<false, false, false>();
+                break;
+        case 1: selectKernels<false, false, true>();
+                break;
+        case 2: selectKernels<false, true, false>();
+                break;
+        case 3: selectKernels<false, true, true>();
+                break;
+        case 4: selectKernels<true, false, false>();
+                break;
+        case 5: selectKernels<true, false, true>();
+                break;
+        case 6: selectKernels<true, true, false>();
+                break;
+        case 7: selectKernels<true, true, true>();
+                break;
+    }
+}
+
+template <typename mgReal>
+template <bool xUniform, bool yUniform, bool zUniform>
+void multigrid_d3<mgReal>::selectKernels() {
+    residualKernel = &multigrid_d3<mgReal>::template residualSweep<xUniform, yUniform, zUniform>;
+    pointKernel = &multigrid_d3<mgReal>::template pointSweep<xUniform, yUniform, zUniform, false>;
+    checkKernel = &multigrid_d3<mgReal>::template pointSweep<xUniform, yUniform, zUniform, true>;
+    planeKernel = &multigrid_d3<mgReal>::template planeSweep<xUniform, yUniform, zUniform>;
+    lineKernel = &multigrid_d3<mgReal>::template lineSystem<xUniform, yUniform, zUniform>;
 }
 
-void multigrid_d3::initMeshRanges() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::initMeshRanges() {
     xMeshRange.resize(inputParams.vcDepth + 1);
     yMeshRange.resize(inputParams.vcDepth + 1);
     zMeshRange.resize(inputParams.vcDepth + 1);
 
-    // Range OBJECTS WITH STRIDE TO ACCESS DIFFERENT POINTS OF THE SAME ARRAY AT DIFFERENT MULTI-GRID LEVELS
+    // Range OBJECTS TO ACCESS THE CORE OF THE ARRAYS AT DIFFERENT MULTI-GRID LEVELS
     for(int i=0; i<=inputParams.vcDepth; i++) {
-        xMeshRange(i) = blitz::Range(stagCore.lbound(0), stagCore.ubound(0), strideValues(i));
-        yMeshRange(i) = blitz::Range(stagCore.lbound(1), stagCore.ubound(1), strideValues(i));
-        zMeshRange(i) = blitz::Range(stagCore.lbound(2), stagCore.ubound(2), strideValues(i));
+        xMeshRange(i) = blitz::Range(stagCore(i).lbound(0), stagCore(i).ubound(0), 1);
+        yMeshRange(i) = blitz::Range(stagCore(i).lbound(1), stagCore(i).ubound(1), 1);
+        zMeshRange(i) = blitz::Range(stagCore(i).lbound(2), stagCore(i).ubound(2), 1);
     }
 
     // SET THE LIMTS FOR ARRAY LOOPS IN solve AND smooth FUNCTIONS, AND A FEW OTHER PLACES
-    // WARNING: THESE VARIABLES HAVE SO FAR BEEN IMPLEMENTED ONLY IN solve, smooth AND vCycle.
-    // THE TEST FUNCTIONS HAVE NOT YET BEEN UPDATED WITH THESE
-    xStr = stagCore.lbound(0);
-    yStr = stagCore.lbound(1);
-    zStr = stagCore.lbound(2);
+    // THE LOWER LIMITS ARE SAME AT ALL LEVELS, WHILE THE UPPER LIMITS ARE DIFFERENT FOR EACH LEVEL
+    xStr = stagCore(0).lbound(0);
+    yStr = stagCore(0).lbound(1);
+    zStr = stagCore(0).lbound(2);
 
-    xEnd = stagCore.ubound(0);
-    yEnd = stagCore.ubound(1);
-    zEnd = stagCore.ubound(2);
+    xEnd.resize(inputParams.vcDepth + 1);
+    yEnd.resize(inputParams.vcDepth + 1);
+    zEnd.resize(inputParams.vcDepth + 1);
+
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        xEnd(i) = stagCore(i).ubound(0);
+        yEnd(i) = stagCore(i).ubound(1);
+        zEnd(i) = stagCore(i).ubound(2);
+    }
+
+    // THE DEEP PADS ARE USED BY THE FUSED SWEEPS OF THE RED-BLACK POINT SMOOTHER, AND ONLY AT THE LEVELS WHERE THEY LIE WITHIN THE
+    // CORE OF THE NEIGHBOURING SUB-DOMAINS. THE LEVELS USING THE GALERKIN OPERATOR ARE RELAXED IN 8 COLOURS AND DO NOT FUSE THEIR SWEEPS
+    haloLevel.resize(inputParams.vcDepth + 1);
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        haloLevel(i) = (inputParams.haloDepth > 1 and inputParams.smoothType == 0 and not (inputParams.coarseOperator == 1 and i > 0) and
+                        xEnd(i) > inputParams.haloDepth and yEnd(i) > inputParams.haloDepth);
+    }
 }
 
-void multigrid_d3::createMGSubArrays() {
-    int ptsCount;
-    int numPoints;
-    int areaVal, lengthVal;
+template <typename mgReal>
+void multigrid_d3<mgReal>::createMGSubArrays() {
+    int yLen, zLen;
+    int ptsCount, zParity;
 
     blitz::Array<int, 1> blockIndx, blockSize;
 
     recvStatus.resize(4);
     recvRequest.resize(4);
 
+    sendStatus.resize(4);
+
     xMGArray.resize(inputParams.vcDepth + 1);
     yMGArray.resize(inputParams.vcDepth + 1);
 
+    xMGRBArray.resize(inputParams.vcDepth + 1, 2);
+    yMGRBArray.resize(inputParams.vcDepth + 1, 2);
+
+    padSendBuffer.resize(inputParams.vcDepth + 1, 4);
+    padRecvBuffer.resize(inputParams.vcDepth + 1, 4);
+    padSendRequest.resize(inputParams.vcDepth + 1, 2, 4);
+    padRecvRequest.resize(inputParams.vcDepth + 1, 2, 4);
+
+    xMGHalo.resize(inputParams.vcDepth + 1);
+    yMGHalo.resize(inputParams.vcDepth + 1);
+
     mgSendLft.resize(inputParams.vcDepth + 1);        mgSendRgt.resize(inputParams.vcDepth + 1);
     mgRecvLft.resize(inputParams.vcDepth + 1);        mgRecvRgt.resize(inputParams.vcDepth + 1);
     mgSendFrn.resize(inputParams.vcDepth + 1);        mgSendBak.resize(inputParams.vcDepth + 1);
@@ -477,12 +1324,11 @@ void multigrid_d3::createMGSubArrays() {
 
     for(int i=0; i<=inputParams.vcDepth; i++) {
         /**
-         * For transfer of non-contiguous, yet uniformly spaced blocks of data, the MPI_Type_indexed datatype is being used here.
-         * The number of such data blocks is represented by numPoints.
-         * Since single points are being transferred rather than small blocks, the blockSize array, which holds the block length
-         * of each block of data to be sent, is set to 1.
-         * The blockIndx variable holds the starting index of each block (here, each single data point) within the full global
-         * array of data.
+         * Since each level of the V-cycle has its own contiguous array, the points on a face of the sub-domain are uniformly
+         * spaced within the array, and the MPI_Type_vector datatype is used to transfer them.
+         * Each block is a contiguous line of points along the Z-direction, whose length is the number of core points along Z.
+         * The spacing between the starting points of successive blocks is given by the full extent of the array along the
+         * directions that vary faster in memory than the direction of the block count.
          */
 
         /***************************************************************************************************
@@ -492,132 +1338,549 @@ void multigrid_d3::createMGSubArrays() {
          * But for a sequential case with npX = 1 and npY = 1, this transfer will not happen
          * Now xMGArray and yMGArray are defined irrespective of npX and npY
         \**************************************************************************************************/
+        yLen = stagFull(i).ubound(1) - stagFull(i).lbound(1) + 1;
+        zLen = stagFull(i).ubound(2) - stagFull(i).lbound(2) + 1;
+
         // CREATE X_MG_ARRAY DATATYPE
-        numPoints = mgSizeArray(localSizeIndex(1) - i)*mgSizeArray(localSizeIndex(2) - i);
-        blockIndx.resize(numPoints);
-        blockSize.resize(numPoints);
+        MPI_Type_vector(yEnd(i) + 1, zEnd(i) + 1, zLen, mgDataType, &xMGArray(i));
+        MPI_Type_commit(&xMGArray(i));
 
-        blockSize = 1;
-        ptsCount = 0;
+        // CREATE Y_MG_ARRAY DATATYPE - THE X-DIRECTION PADS ARE INCLUDED SO THAT THE EDGES OF THE SUB-DOMAIN ARE TRANSFERRED TOO
+        MPI_Type_vector(xEnd(i) + 3, zEnd(i) + 1, yLen*zLen, mgDataType, &yMGArray(i));
+        MPI_Type_commit(&yMGArray(i));
 
-        lengthVal = (stagFull.ubound(2) - stagFull.lbound(2) + 1);
-        for (int j = 0; j < mgSizeArray(localSizeIndex(1) - i); j++) {
-            for (int k = 0; k < mgSizeArray(localSizeIndex(2) - i); k++) {
-                blockIndx(ptsCount) = j*lengthVal*strideValues(i) + k*strideValues(i);
-                ptsCount += 1;
+        /**
+         * For the red-black smoother, only the points of one colour are transferred at a time.
+         * The send and receive positions along both directions lie at odd indices (1, N - 1, -1 and N + 1), so that a point
+         * (iX, iY, iZ) on these planes has the colour given by the parity of the sum of 1 with the two indices along the plane.
+         * Since these points are not uniformly spaced within the array, the MPI_Type_indexed datatype is used with single
+         * point blocks, whose offsets are measured from the starting position of the plane.
+         * With the zebra line smoother, the colour of a point is that of its line along Z, and does not depend on iZ.
+         */
+        zParity = (inputParams.smoothType == 0)? 1: 0;
+        for (int c=0; c<2; c++) {
+            // CREATE X_MG_RB_ARRAY DATATYPE
+            blockIndx.resize((yEnd(i) + 1)*(zEnd(i) + 1));
+            blockSize.resize((yEnd(i) + 1)*(zEnd(i) + 1));
+
+            blockSize = 1;
+            ptsCount = 0;
+            for (int iY = 0; iY <= yEnd(i); iY++) {
+                for (int iZ = 0; iZ <= zEnd(i); iZ++) {
+                    if ((1 + iY + zParity*iZ) % 2 == c) {
+                        blockIndx(ptsCount) = iY*zLen + iZ;
+                        ptsCount += 1;
+                    }
+                }
             }
+            MPI_Type_indexed(ptsCount, blockSize.data(), blockIndx.data(), mgDataType, &xMGRBArray(i, c));
+            MPI_Type_commit(&xMGRBArray(i, c));
+
+            // CREATE Y_MG_RB_ARRAY DATATYPE - THE X-DIRECTION PADS ARE INCLUDED AS IN THE CASE OF Y_MG_ARRAY
+            blockIndx.resize((xEnd(i) + 3)*(zEnd(i) + 1));
+            blockSize.resize((xEnd(i) + 3)*(zEnd(i) + 1));
+
+            blockSize = 1;
+            ptsCount = 0;
+            for (int iX = -1; iX <= xEnd(i) + 1; iX++) {
+                for (int iZ = 0; iZ <= zEnd(i); iZ++) {
+                    if ((1 + iX + zParity*iZ) % 2 == c) {
+                        blockIndx(ptsCount) = (iX + 1)*yLen*zLen + iZ;
+                        ptsCount += 1;
+                    }
+                }
+            }
+            MPI_Type_indexed(ptsCount, blockSize.data(), blockIndx.data(), mgDataType, &yMGRBArray(i, c));
+            MPI_Type_commit(&yMGRBArray(i, c));
         }
-        MPI_Type_indexed(numPoints, blockSize.data(), blockIndx.data(), MPI_FP_REAL, &xMGArray(i));
-        MPI_Type_commit(&xMGArray(i));
 
-        // CREATE Y_MG_ARRAY DATATYPE
-        numPoints = mgSizeArray(localSizeIndex(2) - i)*mgSizeArray(localSizeIndex(0) - i);
-        blockIndx.resize(numPoints);
-        blockSize.resize(numPoints);
+        /**
+         * The pads of one colour transferred by beginPadUpdate are packed into contiguous buffers, one for each of the 4 faces.
+         * The faces normal to X hold (yEnd + 1) lines along Z and those normal to Y hold (xEnd + 1) lines, excluding the X pads.
+         * The buffers are shared by the two colours, while the persistent requests are created once for each colour, since the
+         * number of points of the two colours on a face differs by one when the face has an odd number of lines.
+         */
+        // THE BLACK POINTS START AT THE FIRST POINT OF THE FIRST LINE, AND ARE NEVER FEWER THAN THE RED POINTS
+        padSendBuffer(i, 0).resize(faceOffset(i, yEnd(i) + 1, 1));        padRecvBuffer(i, 0).resize(faceOffset(i, yEnd(i) + 1, 1));
+        padSendBuffer(i, 1).resize(faceOffset(i, yEnd(i) + 1, 1));        padRecvBuffer(i, 1).resize(faceOffset(i, yEnd(i) + 1, 1));
+        padSendBuffer(i, 2).resize(faceOffset(i, xEnd(i) + 1, 1));        padRecvBuffer(i, 2).resize(faceOffset(i, xEnd(i) + 1, 1));
+        padSendBuffer(i, 3).resize(faceOffset(i, xEnd(i) + 1, 1));        padRecvBuffer(i, 3).resize(faceOffset(i, xEnd(i) + 1, 1));
+
+        for (int c=0; c<2; c++) {
+            int xCount = faceOffset(i, yEnd(i) + 1, c);
+            int yCount = faceOffset(i, xEnd(i) + 1, c);
+
+            MPI_Recv_init(padRecvBuffer(i, 0).data(), xCount, mgDataType, mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &padRecvRequest(i, c, 0));
+            MPI_Recv_init(padRecvBuffer(i, 1).data(), xCount, mgDataType, mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &padRecvRequest(i, c, 1));
+            MPI_Recv_init(padRecvBuffer(i, 2).data(), yCount, mgDataType, mesh.rankData.nearRanks(2), 3, MPI_COMM_WORLD, &padRecvRequest(i, c, 2));
+            MPI_Recv_init(padRecvBuffer(i, 3).data(), yCount, mgDataType, mesh.rankData.nearRanks(3), 4, MPI_COMM_WORLD, &padRecvRequest(i, c, 3));
+
+            MPI_Send_init(padSendBuffer(i, 0).data(), xCount, mgDataType, mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD, &padSendRequest(i, c, 0));
+            MPI_Send_init(padSendBuffer(i, 1).data(), xCount, mgDataType, mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD, &padSendRequest(i, c, 1));
+            MPI_Send_init(padSendBuffer(i, 2).data(), yCount, mgDataType, mesh.rankData.nearRanks(2), 4, MPI_COMM_WORLD, &padSendRequest(i, c, 2));
+            MPI_Send_init(padSendBuffer(i, 3).data(), yCount, mgDataType, mesh.rankData.nearRanks(3), 3, MPI_COMM_WORLD, &padSendRequest(i, c, 3));
+        }
+
+        /**
+         * At the levels using deep pads, all the points within haloDepth planes of each face are transferred at once.
+         * Each of these planes is transferred as in X_MG_ARRAY and Y_MG_ARRAY, so that the MPI_Type_indexed datatype is used with
+         * one block for each line along Z, whose offsets are measured from the lowest plane.
+         * Along Y, the full depth of the X-direction pads is included, so that the edges of the sub-domain are transferred too.
+         */
+        xMGHalo(i) = MPI_DATATYPE_NULL;
+        yMGHalo(i) = MPI_DATATYPE_NULL;
+        if (haloLevel(i)) {
+            // CREATE X_MG_HALO DATATYPE
+            blockIndx.resize(inputParams.haloDepth*(yEnd(i) + 1));
+            blockSize.resize(inputParams.haloDepth*(yEnd(i) + 1));
+
+            blockSize = zEnd(i) + 1;
+            ptsCount = 0;
+            for (int pX = 0; pX < inputParams.haloDepth; pX++) {
+                for (int iY = 0; iY <= yEnd(i); iY++) {
+                    blockIndx(ptsCount) = pX*yLen*zLen + iY*zLen;
+                    ptsCount += 1;
+                }
+            }
+            MPI_Type_indexed(ptsCount, blockSize.data(), blockIndx.data(), mgDataType, &xMGHalo(i));
+            MPI_Type_commit(&xMGHalo(i));
+
+            // CREATE Y_MG_HALO DATATYPE
+            blockIndx.resize((xEnd(i) + 2*inputParams.haloDepth + 1)*inputParams.haloDepth);
+            blockSize.resize((xEnd(i) + 2*inputParams.haloDepth + 1)*inputParams.haloDepth);
+
+            blockSize = zEnd(i) + 1;
+            ptsCount = 0;
+            for (int iX = -inputParams.haloDepth; iX <= xEnd(i) + inputParams.haloDepth; iX++) {
+                for (int pY = 0; pY < inputParams.haloDepth; pY++) {
+                    blockIndx(ptsCount) = (iX + inputParams.haloDepth)*yLen*zLen + pY*zLen;
+                    ptsCount += 1;
+                }
+            }
+            MPI_Type_indexed(ptsCount, blockSize.data(), blockIndx.data(), mgDataType, &yMGHalo(i));
+            MPI_Type_commit(&yMGHalo(i));
+        }
+
+        mgSendLft(i) =  1, 0, 0;
+        mgRecvLft(i) = -1, 0, 0;
+        mgSendRgt(i) = xEnd(i) - 1, 0, 0;
+        mgRecvRgt(i) = xEnd(i) + 1, 0, 0;
+
+        mgSendFrn(i) = -1,  1, 0;
+        mgRecvFrn(i) = -1, -1, 0;
+        mgSendBak(i) = -1, yEnd(i) - 1, 0;
+        mgRecvBak(i) = -1, yEnd(i) + 1, 0;
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::getStencil(const int iX, const int iY, const int iZ, blitz::TinyVector<real, 27> &aVal) {
+    if (inputParams.coarseOperator == 1 and vLevel > 0) {
+        for (int sIndx = 0; sIndx < 27; sIndx++) {
+            aVal(sIndx) = stencilData(vLevel)(iX, iY, iZ, sIndx);
+        }
+
+    } else {
+        // THE 7-POINT STENCIL OF THE LAPLACIAN DISCRETIZED WITH THE GRID METRICS, PLACED IN THE 27-POINT LAYOUT
+        aVal = 0.0;
+
+        aVal(4) = xix2(vLevel, iX)/(hx(vLevel)*hx(vLevel)) - xixx(vLevel, iX)/(2.0*hx(vLevel));
+        aVal(22) = xix2(vLevel, iX)/(hx(vLevel)*hx(vLevel)) + xixx(vLevel, iX)/(2.0*hx(vLevel));
+
+        aVal(10) = ety2(vLevel, iY)/(hy(vLevel)*hy(vLevel)) - etyy(vLevel, iY)/(2.0*hy(vLevel));
+        aVal(16) = ety2(vLevel, iY)/(hy(vLevel)*hy(vLevel)) + etyy(vLevel, iY)/(2.0*hy(vLevel));
+
+        aVal(12) = ztz2(vLevel, iZ)/(hz(vLevel)*hz(vLevel)) - ztzz(vLevel, iZ)/(2.0*hz(vLevel));
+        aVal(14) = ztz2(vLevel, iZ)/(hz(vLevel)*hz(vLevel)) + ztzz(vLevel, iZ)/(2.0*hz(vLevel));
+
+        aVal(13) = -2.0*xix2(vLevel, iX)/(hx(vLevel)*hx(vLevel)) -
+                    2.0*ety2(vLevel, iY)/(hy(vLevel)*hy(vLevel)) -
+                    2.0*ztz2(vLevel, iZ)/(hz(vLevel)*hz(vLevel));
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::createGalerkinOperators() {
+    int cLevel;
+    int gNx, gNy, gNz;
+    int xColours, yColours, zColours;
+
+    blitz::Array<int, 1> xMatch, yMatch, zMatch;
+
+    stencilData.resize(inputParams.vcDepth + 1);
+
+    for (int i=0; i<inputParams.vcDepth; i++) {
+        cLevel = i + 1;
+
+        stencilData(cLevel).resize(xEnd(cLevel) + 1, yEnd(cLevel) + 1, zEnd(cLevel) + 1, 27);
+        stencilData(cLevel) = 0.0;
+
+        xMatch.resize(xEnd(cLevel) + 1);
+        yMatch.resize(yEnd(cLevel) + 1);
+        zMatch.resize(zEnd(cLevel) + 1);
+
+        // NUMBER OF INTERVALS ALONG EACH DIRECTION OF THE GLOBAL GRID AT THE COARSER LEVEL
+        gNx = mesh.rankData.npX*xEnd(cLevel);
+        gNy = mesh.rankData.npY*yEnd(cLevel);
+        gNz = zEnd(cLevel);
+
+        xColours = inputParams.xPer? 4: 3;
+        yColours = inputParams.yPer? 4: 3;
+        zColours = inputParams.zPer? 4: 3;
+
+        // THE COARSE POINTS ARE PROBED IN GROUPS THAT ARE FAR ENOUGH APART FOR THEIR STENCILS TO NOT OVERLAP.
+        // FOR EACH GROUP, THE PROBE IS PROLONGED, THE OPERATOR OF THE FINER LEVEL IS APPLIED TO IT, AND THE RESULT IS RESTRICTED.
+        // THE RESTRICTED VALUE AT EACH COARSE POINT IS THEN THE ENTRY OF ITS STENCIL CORRESPONDING TO THE NEIGHBOURING PROBE
+        for (int xC = 0; xC < xColours; xC++) {
+            setProbeOffsets(xMatch, mesh.rankData.xRank*xEnd(cLevel), gNx, inputParams.xPer, xC);
+
+            for (int yC = 0; yC < yColours; yC++) {
+                setProbeOffsets(yMatch, mesh.rankData.yRank*yEnd(cLevel), gNy, inputParams.yPer, yC);
+
+                for (int zC = 0; zC < zColours; zC++) {
+                    setProbeOffsets(zMatch, 0, gNz, inputParams.zPer, zC);
+
+                    vLevel = cLevel;
+
+                    pressureData(cLevel) = 0.0;
+                    for (int iX = xStr; iX <= xEnd(cLevel); iX++) {
+                        for (int iY = yStr; iY <= yEnd(cLevel); iY++) {
+                            for (int iZ = zStr; iZ <= zEnd(cLevel); iZ++) {
+                                if (xMatch(iX) == 0 and yMatch(iY) == 0 and zMatch(iZ) == 0) pressureData(cLevel)(iX, iY, iZ) = 1.0;
+                            }
+                        }
+                    }
+
+                    prolong();
+
+                    // THE RHS USED HERE IS ZERO, SO THAT THE RESIDUAL IS THE NEGATIVE OF THE OPERATOR APPLIED TO THE PROLONGED PROBE
+                    imposeBC(pressureData(vLevel), 2);
+                    computeResidual(smoothedPres(vLevel));
+
+                    coarsen();
+
+                    for (int iX = xStr; iX <= xEnd(cLevel); iX++) {
+                        for (int iY = yStr; iY <= yEnd(cLevel); iY++) {
+                            for (int iZ = zStr; iZ <= zEnd(cLevel); iZ++) {
+                                if (xMatch(iX) < 2 and yMatch(iY) < 2 and zMatch(iZ) < 2) {
+                                    stencilData(cLevel)(iX, iY, iZ, 9*(xMatch(iX) + 1) + 3*(yMatch(iY) + 1) + zMatch(iZ) + 1) = -residualData(cLevel)(iX, iY, iZ);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
 
-        blockSize = 1;
-        ptsCount = 0;
+    // RESET THE ARRAYS USED FOR PROBING
+    vLevel = 0;
+    for (int i=0; i<=inputParams.vcDepth; i++) {
+        pressureData(i) = 0.0;
+        residualData(i) = 0.0;
+    }
+}
 
-        areaVal = (stagFull.ubound(1) - stagFull.lbound(1) + 1)*(stagFull.ubound(2) - stagFull.lbound(2) + 1);
-        for (int j = 0; j < mgSizeArray(localSizeIndex(0) - i); j++) {
-            for (int k = 0; k < mgSizeArray(localSizeIndex(2) - i); k++) {
-                blockIndx(ptsCount) = j*strideValues(i)*areaVal + k*strideValues(i);
-                ptsCount += 1;
+template <typename mgReal>
+void multigrid_d3<mgReal>::createCoarseSystem() {
+    int cLevel, entryCount, pointCount;
+    int gNx, gNy, gNz;
+    int rowIndex;
+
+    blitz::TinyVector<real, 27> aVal;
+
+    blitz::Array<int, 1> xGlobal, yGlobal, zGlobal;
+    blitz::Array<int, 1> rowIndx, colIndx;
+    blitz::Array<int, 1> ownedIndx, coreIndx;
+    blitz::Array<real, 1> matVals;
+
+    cLevel = inputParams.vcDepth;
+
+    blitz::RectDomain<3> uniqCore = ownedCore(cLevel);
+
+    // NUMBER OF UNKNOWNS ALONG EACH DIRECTION OF THE GLOBAL GRID AT THE COARSEST LEVEL
+    gNx = mesh.rankData.npX*xEnd(cLevel) + (inputParams.xPer? 0: 1);
+    gNy = mesh.rankData.npY*yEnd(cLevel) + (inputParams.yPer? 0: 1);
+    gNz = zEnd(cLevel) + (inputParams.zPer? 0: 1);
+
+    xGlobal.resize(blitz::Range(-1, xEnd(cLevel) + 1));
+    yGlobal.resize(blitz::Range(-1, yEnd(cLevel) + 1));
+    zGlobal.resize(blitz::Range(-1, zEnd(cLevel) + 1));
+
+    setGlobalIndex(xGlobal, mesh.rankData.xRank*xEnd(cLevel), gNx, inputParams.xPer);
+    setGlobalIndex(yGlobal, mesh.rankData.yRank*yEnd(cLevel), gNy, inputParams.yPer);
+    setGlobalIndex(zGlobal, 0, gNz, inputParams.zPer);
+
+    pointCount = blitz::product(uniqCore.ubound() - uniqCore.lbound() + 1);
+    ownedIndx.resize(pointCount);
+    rowIndx.resize(27*pointCount);
+    colIndx.resize(27*pointCount);
+    matVals.resize(27*pointCount);
+
+    // THE ENTRIES OF EACH ROW ARE THE COEFFICIENTS OF THE STENCIL USED IN computeResidual, WHICH IS EITHER THE 7-POINT LAPLACIAN
+    // OR THE 27-POINT GALERKIN OPERATOR. ONLY THE NON-ZERO ENTRIES OF THE STENCIL ARE STORED
+    // WHEN A NEIGHBOURING POINT IS MAPPED ONTO ANOTHER POINT (OR ONTO THE POINT ITSELF) ACROSS A BOUNDARY, THE ENTRIES ARE ADDED UP DURING ASSEMBLY
+    vLevel = cLevel;
+
+    entryCount = 0;
+    pointCount = 0;
+    for (int iX = uniqCore.lbound(0); iX <= uniqCore.ubound(0); iX++) {
+        for (int iY = uniqCore.lbound(1); iY <= uniqCore.ubound(1); iY++) {
+            for (int iZ = uniqCore.lbound(2); iZ <= uniqCore.ubound(2); iZ++) {
+                rowIndex = (xGlobal(iX)*gNy + yGlobal(iY))*gNz + zGlobal(iZ);
+                ownedIndx(pointCount) = rowIndex;
+                pointCount += 1;
+
+                getStencil(iX, iY, iZ, aVal);
+
+                for (int dX = -1; dX <= 1; dX++) {
+                    for (int dY = -1; dY <= 1; dY++) {
+                        for (int dZ = -1; dZ <= 1; dZ++) {
+                            if (aVal(9*(dX + 1) + 3*(dY + 1) + dZ + 1) == 0.0) continue;
+
+                            rowIndx(entryCount) = rowIndex;
+                            colIndx(entryCount) = (xGlobal(iX + dX)*gNy + yGlobal(iY + dY))*gNz + zGlobal(iZ + dZ);
+                            matVals(entryCount) = aVal(9*(dX + 1) + 3*(dY + 1) + dZ + 1);
+                            entryCount += 1;
+                        }
+                    }
+                }
             }
         }
-        MPI_Type_indexed(numPoints, blockSize.data(), blockIndx.data(), MPI_FP_REAL, &yMGArray(i));
-        MPI_Type_commit(&yMGArray(i));
+    }
+
+    vLevel = 0;
 
-        mgSendLft(i) =  strideValues(i), 0, 0;
-        mgRecvLft(i) = -strideValues(i), 0, 0;
-        mgSendRgt(i) = stagCore.ubound(0) - strideValues(i), 0, 0;
-        mgRecvRgt(i) = stagCore.ubound(0) + strideValues(i), 0, 0;
+    rowIndx.resizeAndPreserve(entryCount);
+    colIndx.resizeAndPreserve(entryCount);
+    matVals.resizeAndPreserve(entryCount);
 
-        mgSendFrn(i) = 0,  strideValues(i), 0;
-        mgRecvFrn(i) = 0, -strideValues(i), 0;
-        mgSendBak(i) = 0, stagCore.ubound(1) - strideValues(i), 0;
-        mgRecvBak(i) = 0, stagCore.ubound(1) + strideValues(i), 0;
+    // GLOBAL INDICES OF ALL THE CORE POINTS, IN THE ORDER IN WHICH directSolve COPIES THE SOLUTION INTO THEM
+    coreIndx.resize((xEnd(cLevel) + 1)*(yEnd(cLevel) + 1)*(zEnd(cLevel) + 1));
+
+    pointCount = 0;
+    for (int iX = xStr; iX <= xEnd(cLevel); iX++) {
+        for (int iY = yStr; iY <= yEnd(cLevel); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(cLevel); iZ++) {
+                coreIndx(pointCount) = (xGlobal(iX)*gNy + yGlobal(iY))*gNz + zGlobal(iZ);
+                pointCount += 1;
+            }
+        }
     }
+
+    factorCoarseSystem(rowIndx, colIndx, matVals, ownedIndx, coreIndx);
 }
 
-void multigrid_d3::imposeBC() {
-    updatePads();
+template <typename mgReal>
+void multigrid_d3<mgReal>::imposeBC(blitz::Array<mgReal, 3> &data, const int colour) {
+    updatePads(data, colour);
 
+    imposeWallBC(data);
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::imposeWallBC(blitz::Array<mgReal, 3> &data) {
     if (not inputParams.xPer) {
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT LEFT WALL
+        // NEUMANN BOUNDARY CONDITION AT LEFT WALL
         if (mesh.rankData.xRank == 0) {
-            pressureData(-strideValues(vLevel), yMeshRange(vLevel), zMeshRange(vLevel)) = pressureData(strideValues(vLevel), yMeshRange(vLevel), zMeshRange(vLevel));
+            data(-1, blitz::Range::all(), zMeshRange(vLevel)) = data(1, blitz::Range::all(), zMeshRange(vLevel));
         }
 
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT RIGHT WALL
+        // NEUMANN BOUNDARY CONDITION AT RIGHT WALL
         if (mesh.rankData.xRank == mesh.rankData.npX - 1) {
-            pressureData(stagCore.ubound(0) + strideValues(vLevel), yMeshRange(vLevel), zMeshRange(vLevel)) = pressureData(stagCore.ubound(0) - strideValues(vLevel), yMeshRange(vLevel), zMeshRange(vLevel));
+            data(xEnd(vLevel) + 1, blitz::Range::all(), zMeshRange(vLevel)) = data(xEnd(vLevel) - 1, blitz::Range::all(), zMeshRange(vLevel));
         }
     } // PERIODIC BOUNDARY CONDITIONS ARE AUTOMATICALLY IMPOSED BY PERIODIC DATA TRANSFER ACROSS PROCESSORS THROUGH updatePads()
 
     if (not inputParams.yPer) {
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT FRONT WALL
+        // NEUMANN BOUNDARY CONDITION AT FRONT WALL
         if (mesh.rankData.yRank == 0) {
-            pressureData(xMeshRange(vLevel), -strideValues(vLevel), zMeshRange(vLevel)) = pressureData(xMeshRange(vLevel), strideValues(vLevel), zMeshRange(vLevel));
+            data(blitz::Range::all(), -1, zMeshRange(vLevel)) = data(blitz::Range::all(), 1, zMeshRange(vLevel));
         }
 
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT BACK WALL
+        // NEUMANN BOUNDARY CONDITION AT BACK WALL
         if (mesh.rankData.yRank == mesh.rankData.npY - 1) {
-            pressureData(xMeshRange(vLevel), stagCore.ubound(1) + strideValues(vLevel), zMeshRange(vLevel)) = pressureData(xMeshRange(vLevel), stagCore.ubound(1) - strideValues(vLevel), zMeshRange(vLevel));
+            data(blitz::Range::all(), yEnd(vLevel) + 1, zMeshRange(vLevel)) = data(blitz::Range::all(), yEnd(vLevel) - 1, zMeshRange(vLevel));
         }
     } // PERIODIC BOUNDARY CONDITIONS ARE AUTOMATICALLY IMPOSED BY PERIODIC DATA TRANSFER ACROSS PROCESSORS THROUGH updatePads()
 
+    // THE BOUNDARY CONDITIONS ALONG Z-DIRECTION ARE IMPOSED OVER THE X AND Y PADS TOO, SO THAT THE EDGES AND CORNERS ARE ALSO SET
     if (inputParams.zPer) {
-        // PERIODIC BOUNDARY CONDITION ON PRESSURE AT BOTTOM WALL
-        pressureData(xMeshRange(vLevel), yMeshRange(vLevel), -strideValues(vLevel)) = pressureData(xMeshRange(vLevel), yMeshRange(vLevel), stagCore.ubound(2) - strideValues(vLevel));
+        // PERIODIC BOUNDARY CONDITION AT BOTTOM WALL
+        data(blitz::Range::all(), blitz::Range::all(), -1) = data(blitz::Range::all(), blitz::Range::all(), zEnd(vLevel) - 1);
 
-        // PERIODIC BOUNDARY CONDITION ON PRESSURE AT TOP WALL
-        pressureData(xMeshRange(vLevel), yMeshRange(vLevel), stagCore.ubound(2) + strideValues(vLevel)) = pressureData(xMeshRange(vLevel), yMeshRange(vLevel), strideValues(vLevel));
+        // PERIODIC BOUNDARY CONDITION AT TOP WALL
+        data(blitz::Range::all(), blitz::Range::all(), zEnd(vLevel) + 1) = data(blitz::Range::all(), blitz::Range::all(), 1);
 
     } else {
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT BOTTOM WALL
-        pressureData(xMeshRange(vLevel), yMeshRange(vLevel), -strideValues(vLevel)) = pressureData(xMeshRange(vLevel), yMeshRange(vLevel), strideValues(vLevel));
+        // NEUMANN BOUNDARY CONDITION AT BOTTOM WALL
+        data(blitz::Range::all(), blitz::Range::all(), -1) = data(blitz::Range::all(), blitz::Range::all(), 1);
+
+        // NEUMANN BOUNDARY CONDITION AT TOP WALL
+        data(blitz::Range::all(), blitz::Range::all(), zEnd(vLevel) + 1) = data(blitz::Range::all(), blitz::Range::all(), zEnd(vLevel) - 1);
+    }
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::imposePlaneBC(blitz::Array<mgReal, 3> &data, const int iX) {
+    if (not inputParams.yPer) {
+        // NEUMANN BOUNDARY CONDITION AT FRONT WALL
+        if (mesh.rankData.yRank == 0) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) data(iX, -1, iZ) = data(iX, 1, iZ);
+        }
+
+        // NEUMANN BOUNDARY CONDITION AT BACK WALL
+        if (mesh.rankData.yRank == mesh.rankData.npY - 1) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) data(iX, yEnd(vLevel) + 1, iZ) = data(iX, yEnd(vLevel) - 1, iZ);
+        }
+    }
 
-        // NEUMANN BOUNDARY CONDITION ON PRESSURE AT TOP WALL
-        pressureData(xMeshRange(vLevel), yMeshRange(vLevel), stagCore.ubound(2) + strideValues(vLevel)) = pressureData(xMeshRange(vLevel), yMeshRange(vLevel), stagCore.ubound(2) - strideValues(vLevel));
+    // THE BOUNDARY CONDITIONS ALONG Z-DIRECTION ARE IMPOSED OVER THE Y PADS OF THE PLANE TOO
+    for (int iY = data.lbound(1); iY <= data.ubound(1); iY++) {
+        data(iX, iY, -1) = inputParams.zPer? data(iX, iY, zEnd(vLevel) - 1): data(iX, iY, 1);
+        data(iX, iY, zEnd(vLevel) + 1) = inputParams.zPer? data(iX, iY, 1): data(iX, iY, zEnd(vLevel) - 1);
+    }
+
+    // THE PLANES NEXT TO THE WALLS ALONG X ARE COPIED, ALONG WITH THEIR PADS, INTO THE PAD PLANES ACROSS THE WALLS
+    if (not inputParams.xPer) {
+        // NEUMANN BOUNDARY CONDITION AT LEFT WALL
+        if (mesh.rankData.xRank == 0 and iX == 1) {
+            for (int iY = data.lbound(1); iY <= data.ubound(1); iY++) {
+                for (int iZ = -1; iZ <= zEnd(vLevel) + 1; iZ++) data(-1, iY, iZ) = data(1, iY, iZ);
+            }
+        }
+
+        // NEUMANN BOUNDARY CONDITION AT RIGHT WALL
+        if (mesh.rankData.xRank == mesh.rankData.npX - 1 and iX == xEnd(vLevel) - 1) {
+            for (int iY = data.lbound(1); iY <= data.ubound(1); iY++) {
+                for (int iZ = -1; iZ <= zEnd(vLevel) + 1; iZ++) data(xEnd(vLevel) + 1, iY, iZ) = data(xEnd(vLevel) - 1, iY, iZ);
+            }
+        }
     }
 }
 
-void multigrid_d3::updatePads() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::updatePads(blitz::Array<mgReal, 3> &data, const int colour) {
+    MPI_Datatype xFace, yFace;
+
+    // THE DEEP PADS ARE TRANSFERRED FROM DIFFERENT POSITIONS, AND WITH THEIR OWN DATATYPES
+    if (colour == 3) {
+        updateHalos(data);
+        return;
+    }
+
+    // CHOOSE BETWEEN THE DATATYPES HOLDING ALL THE POINTS OF THE FACE AND THOSE HOLDING THE POINTS OF A SINGLE COLOUR
+    if (colour == 2) {
+        xFace = xMGArray(vLevel);
+        yFace = yMGArray(vLevel);
+    } else {
+        xFace = xMGRBArray(vLevel, colour);
+        yFace = yMGRBArray(vLevel, colour);
+    }
+
+    recvRequest = MPI_REQUEST_NULL;
+
+    // TRANSFER DATA ALONG X-DIRECTION FIRST
+    MPI_Irecv(&data(mgRecvLft(vLevel)), 1, xFace, mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
+    MPI_Irecv(&data(mgRecvRgt(vLevel)), 1, xFace, mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &recvRequest(1));
+
+    MPI_Send(&data(mgSendLft(vLevel)), 1, xFace, mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD);
+    MPI_Send(&data(mgSendRgt(vLevel)), 1, xFace, mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD);
+
+    MPI_Waitall(2, recvRequest.dataFirst(), recvStatus.dataFirst());
+
+    // THE DATA TRANSFERRED ALONG Y-DIRECTION INCLUDES THE X-DIRECTION PADS RECEIVED ABOVE
+    MPI_Irecv(&data(mgRecvFrn(vLevel)), 1, yFace, mesh.rankData.nearRanks(2), 3, MPI_COMM_WORLD, &recvRequest(2));
+    MPI_Irecv(&data(mgRecvBak(vLevel)), 1, yFace, mesh.rankData.nearRanks(3), 4, MPI_COMM_WORLD, &recvRequest(3));
+
+    MPI_Send(&data(mgSendFrn(vLevel)), 1, yFace, mesh.rankData.nearRanks(2), 4, MPI_COMM_WORLD);
+    MPI_Send(&data(mgSendBak(vLevel)), 1, yFace, mesh.rankData.nearRanks(3), 3, MPI_COMM_WORLD);
+
+    MPI_Waitall(2, &recvRequest(2), &recvStatus(2));
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::updateHalos(blitz::Array<mgReal, 3> &data) {
+    int hDepth = inputParams.haloDepth;
+
     recvRequest = MPI_REQUEST_NULL;
-    MPI_Irecv(&pressureData(mgRecvLft(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
-    MPI_Irecv(&pressureData(mgRecvRgt(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &recvRequest(1));
-    MPI_Irecv(&pressureData(mgRecvFrn(vLevel)), 1, yMGArray(vLevel), mesh.rankData.nearRanks(2), 3, MPI_COMM_WORLD, &recvRequest(2));
-    MPI_Irecv(&pressureData(mgRecvBak(vLevel)), 1, yMGArray(vLevel), mesh.rankData.nearRanks(3), 4, MPI_COMM_WORLD, &recvRequest(3));
 
-    MPI_Send(&pressureData(mgSendLft(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD);
-    MPI_Send(&pressureData(mgSendRgt(vLevel)), 1, xMGArray(vLevel), mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD);
-    MPI_Send(&pressureData(mgSendFrn(vLevel)), 1, yMGArray(vLevel), mesh.rankData.nearRanks(2), 4, MPI_COMM_WORLD);
-    MPI_Send(&pressureData(mgSendBak(vLevel)), 1, yMGArray(vLevel), mesh.rankData.nearRanks(3), 3, MPI_COMM_WORLD);
+    // TRANSFER DATA ALONG X-DIRECTION FIRST. THE PLANES 1 TO hDepth AND N - hDepth TO N - 1 ARE SENT TO THE NEIGHBOURS
+    MPI_Irecv(&data(-hDepth, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(0), 1, MPI_COMM_WORLD, &recvRequest(0));
+    MPI_Irecv(&data(xEnd(vLevel) + 1, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(1), 2, MPI_COMM_WORLD, &recvRequest(1));
+
+    MPI_Send(&data(1, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(0), 2, MPI_COMM_WORLD);
+    MPI_Send(&data(xEnd(vLevel) - hDepth, 0, 0), 1, xMGHalo(vLevel), mesh.rankData.nearRanks(1), 1, MPI_COMM_WORLD);
+
+    MPI_Waitall(2, recvRequest.dataFirst(), recvStatus.dataFirst());
 
-    MPI_Waitall(4, recvRequest.dataFirst(), recvStatus.dataFirst());
+    // THE DATA TRANSFERRED ALONG Y-DIRECTION INCLUDES THE X-DIRECTION PADS RECEIVED ABOVE
+    MPI_Irecv(&data(-hDepth, -hDepth, 0), 1, yMGHalo(vLevel), mesh.rankData.nearRanks(2), 3, MPI_COMM_WORLD, &recvRequest(2));
+    MPI_Irecv(&data(-hDepth, yEnd(vLevel) + 1, 0), 1, yMGHalo(vLevel), mesh.rankData.nearRanks(3), 4, MPI_COMM_WORLD, &recvRequest(3));
+
+    MPI_Send(&data(-hDepth, 1, 0), 1, yMGHalo(vLevel), mesh.rankData.nearRanks(2), 4, MPI_COMM_WORLD);
+    MPI_Send(&data(-hDepth, yEnd(vLevel) - hDepth, 0), 1, yMGHalo(vLevel), mesh.rankData.nearRanks(3), 3, MPI_COMM_WORLD);
+
+    MPI_Waitall(2, &recvRequest(2), &recvStatus(2));
+}
+
+template <typename mgReal>
+void multigrid_d3<mgReal>::beginPadUpdate(blitz::Array<mgReal, 3> &data, const int colour) {
+    // THE LINES ALONG Z ON THE FACES NORMAL TO X ARE SEPARATED BY THE STRIDE ALONG Y, AND THOSE ON THE FACES NORMAL TO Y BY THE STRIDE ALONG X
+    long xStride = data.stride(0);
+    long yStride = data.stride(1);
+
+    MPI_Startall(4, &padRecvRequest(vLevel, colour, 0));
+
+    // THE DATA ALONG X AND Y DIRECTIONS IS TRANSFERRED AT THE SAME TIME, AND THE DATA ALONG Y DOES NOT INCLUDE THE X-DIRECTION PADS
+    // ONLY THE FACES SHARED WITH THE NEIGHBOURING SUB-DOMAINS ARE PACKED
+    if (mesh.rankData.nearRanks(0) != MPI_PROC_NULL) packFace(&data(1, 0, 0), yStride, yEnd(vLevel) + 1, colour, padSendBuffer(vLevel, 0).data());
+    if (mesh.rankData.nearRanks(1) != MPI_PROC_NULL) packFace(&data(xEnd(vLevel) - 1, 0, 0), yStride, yEnd(vLevel) + 1, colour, padSendBuffer(vLevel, 1).data());
+    if (mesh.rankData.nearRanks(2) != MPI_PROC_NULL) packFace(&data(0, 1, 0), xStride, xEnd(vLevel) + 1, colour, padSendBuffer(vLevel, 2).data());
+    if (mesh.rankData.nearRanks(3) != MPI_PROC_NULL) packFace(&data(0, yEnd(vLevel) - 1, 0), xStride, xEnd(vLevel) + 1, colour, padSendBuffer(vLevel, 3).data());
+
+    MPI_Startall(4, &padSendRequest(vLevel, colour, 0));
 }
 
-real multigrid_d3::testProlong() {
+template <typename mgReal>
+void multigrid_d3<mgReal>::finishPadUpdate(blitz::Array<mgReal, 3> &data, const int colour) {
+    long xStride = data.stride(0);
+    long yStride = data.stride(1);
+
+    MPI_Waitall(4, &padRecvRequest(vLevel, colour, 0), recvStatus.dataFirst());
+
+    // THE PADS FACING THE WALLS ARE NOT RECEIVED, AND ARE LEFT UNCHANGED
+    if (mesh.rankData.nearRanks(0) != MPI_PROC_NULL) unpackFace(padRecvBuffer(vLevel, 0).data(), yStride, yEnd(vLevel) + 1, colour, &data(-1, 0, 0));
+    if (mesh.rankData.nearRanks(1) != MPI_PROC_NULL) unpackFace(padRecvBuffer(vLevel, 1).data(), yStride, yEnd(vLevel) + 1, colour, &data(xEnd(vLevel) + 1, 0, 0));
+    if (mesh.rankData.nearRanks(2) != MPI_PROC_NULL) unpackFace(padRecvBuffer(vLevel, 2).data(), xStride, xEnd(vLevel) + 1, colour, &data(0, -1, 0));
+    if (mesh.rankData.nearRanks(3) != MPI_PROC_NULL) unpackFace(padRecvBuffer(vLevel, 3).data(), xStride, xEnd(vLevel) + 1, colour, &data(0, yEnd(vLevel) + 1, 0));
+
+    // THE SEND BUFFERS ARE REUSED BY THE NEXT TRANSFER, AND THE SENDS MUST BE COMPLETE BEFORE THEY ARE PACKED AGAIN
+    MPI_Waitall(4, &padSendRequest(vLevel, colour, 0), sendStatus.dataFirst());
+}
+
+template <typename mgReal>
+real multigrid_d3<mgReal>::testProlong() {
     vLevel = 0;
 
     // Fill the residualData array with correct values expected after prolongation
-    residualData = 0.0;
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(vLevel)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-                residualData(iX, iY, iZ) = (mesh.rankData.rank + 1)*1000 + iX*100 + iY*10 + iZ;
+    residualData(vLevel) = 0.0;
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                residualData(vLevel)(iX, iY, iZ) = (mesh.rankData.rank + 1)*1000 + iX*100 + iY*10 + iZ;
             }
         }
     }
 
-    // After going one level down the V-Cycle, populate the pressureData array with values at the corresponding stride
+    // After going one level down the V-Cycle, populate the pressureData array with values at the corresponding points
+    pressureData(vLevel) = 0.0;
     vLevel += 1;
-    pressureData = 0.0;
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(vLevel)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-                pressureData(iX, iY, iZ) = (mesh.rankData.rank + 1)*1000 + iX*100 + iY*10 + iZ;
+    pressureData(vLevel) = 0.0;
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                pressureData(vLevel)(iX, iY, iZ) = (mesh.rankData.rank + 1)*1000 + strideValues(vLevel, 0)*iX*100 + strideValues(vLevel, 1)*iY*10 + strideValues(vLevel, 2)*iZ;
             }
         }
     }
@@ -625,60 +1888,57 @@ real multigrid_d3::testProlong() {
     // Perform prolongation
     prolong();
 
-    pressureData -= residualData;
+    pressureData(vLevel) -= residualData(vLevel);
 
-    return blitz::max(fabs(pressureData));
+    return blitz::max(fabs(pressureData(vLevel)));
 }
 
-real multigrid_d3::testTransfer() {
+template <typename mgReal>
+real multigrid_d3<mgReal>::testTransfer() {
     real maxVal = 0.0;
 
-    vLevel = 0;
-
-    pressureData = 0.0;
-    residualData = 0.0;
-
     MPI_Barrier(MPI_COMM_WORLD);
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += 1) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += 1) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += 1) {
-                pressureData(iX, iY, iZ) = (mesh.rankData.rank + 1)*1000 + iX*100 + iY*10 + iZ;
-                residualData(iX, iY, iZ) = pressureData(iX, iY, iZ);
+    for (vLevel = 0; vLevel <= inputParams.vcDepth; vLevel++) {
+        pressureData(vLevel) = 0.0;
+        residualData(vLevel) = 0.0;
+
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    pressureData(vLevel)(iX, iY, iZ) = (mesh.rankData.rank + 1)*1000 + iX*100 + iY*10 + iZ;
+                    residualData(vLevel)(iX, iY, iZ) = pressureData(vLevel)(iX, iY, iZ);
+                }
             }
         }
-    }
 
-    // EXPECTED VALUES IN THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
-    for (int iX = 0; iX <= inputParams.vcDepth; iX++) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(iX)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(iX)) {
-                residualData(-strideValues(iX), iY, iZ) = (mesh.rankData.nearRanks(0) + 1)*1000 + (stagCore.ubound(0) - strideValues(iX))*100 + iY*10 + iZ;
-                residualData(stagCore.ubound(0) + strideValues(iX), iY, iZ) = (mesh.rankData.nearRanks(1) + 1)*1000 + strideValues(iX)*100 + iY*10 + iZ;
+        // EXPECTED VALUES IN THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
+        for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                residualData(vLevel)(-1, iY, iZ) = (mesh.rankData.nearRanks(0) + 1)*1000 + (xEnd(vLevel) - 1)*100 + iY*10 + iZ;
+                residualData(vLevel)(xEnd(vLevel) + 1, iY, iZ) = (mesh.rankData.nearRanks(1) + 1)*1000 + 100 + iY*10 + iZ;
             }
         }
-    }
 
-    for (int iY = 0; iY <= inputParams.vcDepth; iY++) {
-        for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(iY)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(iY)) {
-                residualData(iX, -strideValues(iY), iZ) = (mesh.rankData.nearRanks(2) + 1)*1000 + iX*100 + (stagCore.ubound(1) - strideValues(iY))*10 + iZ;
-                residualData(iX, stagCore.ubound(1) + strideValues(iY), iZ) = (mesh.rankData.nearRanks(3) + 1)*1000 + iX*100 + strideValues(iY)*10 + iZ;
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                residualData(vLevel)(iX, -1, iZ) = (mesh.rankData.nearRanks(2) + 1)*1000 + iX*100 + (yEnd(vLevel) - 1)*10 + iZ;
+                residualData(vLevel)(iX, yEnd(vLevel) + 1, iZ) = (mesh.rankData.nearRanks(3) + 1)*1000 + iX*100 + 10 + iZ;
             }
         }
-    }
 
-    for (int i=0; i<=inputParams.vcDepth; i++) {
-        updatePads();
-        vLevel += 1;
-    }
+        updatePads(pressureData(vLevel), 2);
 
-    pressureData -= residualData;
+        pressureData(vLevel) -= residualData(vLevel);
 
-    for (int iX = pressureData.lbound(0); iX <= pressureData.ubound(0); iX += 1) {
-        for (int iY = pressureData.lbound(1); iY <= pressureData.ubound(1); iY += 1) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += 1) {
-                if (abs(pressureData(iX, iY, iZ)) > maxVal) {
-                    maxVal = abs(pressureData(iX, iY, iZ));
+        for (int iX = stagFull(vLevel).lbound(0); iX <= stagFull(vLevel).ubound(0); iX++) {
+            for (int iY = stagFull(vLevel).lbound(1); iY <= stagFull(vLevel).ubound(1); iY++) {
+                // THE PADS ALONG THE EDGES OF THE SUB-DOMAIN HOLD DATA FROM DIAGONAL NEIGHBOURS AND ARE NOT CHECKED HERE
+                if ((iX < xStr or iX > xEnd(vLevel)) and (iY < yStr or iY > yEnd(vLevel))) continue;
+
+                for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                    if (abs(pressureData(vLevel)(iX, iY, iZ)) > maxVal) {
+                        maxVal = abs(pressureData(vLevel)(iX, iY, iZ));
+                    }
                 }
             }
         }
@@ -687,111 +1947,112 @@ real multigrid_d3::testTransfer() {
     return maxVal;
 }
 
-real multigrid_d3::testPeriodic() {
-    real xCoord = 0.0;
-    real yCoord = 0.0;
-    real zCoord = 0.0;
-
-    vLevel = 0;
-
-    pressureData = 0.0;
-    residualData = 0.0;
-
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(vLevel)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-                pressureData(iX, iY, iZ) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                           cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
-                                           cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
-                residualData(iX, iY, iZ) = pressureData(iX, iY, iZ);
-            }
-        }
-    }
-
-    // EXPECTED VALUES IN THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
-    for (int iX = 0; iX <= inputParams.vcDepth; iX++) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(iX)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(iX)) {
-                xCoord = mesh.xStaggr(stagCore.lbound(0)) - (mesh.xStaggr(stagCore.lbound(0) + strideValues(iX)) - mesh.xStaggr(stagCore.lbound(0)));
-                residualData(stagCore.lbound(0) - strideValues(iX), iY, iZ) = sin(2.0*M_PI*xCoord/mesh.xLen)*
-                                                                              cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
-                                                                              cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
+template <typename mgReal>
+real multigrid_d3<mgReal>::testPeriodic() {
+    int xSt, ySt, zSt;
+    real maxVal = 0.0;
 
-                xCoord = mesh.xStaggr(stagCore.ubound(0)) + (mesh.xStaggr(stagCore.ubound(0)) - mesh.xStaggr(stagCore.ubound(0) - strideValues(iX)));
-                residualData(stagCore.ubound(0) + strideValues(iX), iY, iZ) = sin(2.0*M_PI*xCoord/mesh.xLen)*
-                                                                              cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
-                                                                              cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
+    blitz::Array<real, 1> xCoord, yCoord, zCoord;
+
+    for (vLevel = 0; vLevel <= inputParams.vcDepth; vLevel++) {
+        // INDICES OF THE FINEST GRID AT WHICH THE POINTS OF THE CURRENT LEVEL LIE ARE OBTAINED BY MULTIPLYING WITH THE STRIDE
+        xSt = strideValues(vLevel, 0);
+        ySt = strideValues(vLevel, 1);
+        zSt = strideValues(vLevel, 2);
+
+        // COORDINATES OF THE POINTS OF THE CURRENT LEVEL, WITH THE PAD POINTS EXTRAPOLATED FROM THE CORE
+        xCoord.resize(blitz::Range(-1, xEnd(vLevel) + 1));
+        yCoord.resize(blitz::Range(-1, yEnd(vLevel) + 1));
+        zCoord.resize(blitz::Range(-1, zEnd(vLevel) + 1));
+
+        for (int iX = xStr; iX <= xEnd(vLevel); iX++) xCoord(iX) = mesh.xStaggr(iX*xSt);
+        for (int iY = yStr; iY <= yEnd(vLevel); iY++) yCoord(iY) = mesh.yStaggr(iY*ySt);
+        for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) zCoord(iZ) = mesh.zStaggr(iZ*zSt);
+
+        xCoord(-1) = 2.0*xCoord(0) - xCoord(1);
+        yCoord(-1) = 2.0*yCoord(0) - yCoord(1);
+        zCoord(-1) = 2.0*zCoord(0) - zCoord(1);
+
+        xCoord(xEnd(vLevel) + 1) = 2.0*xCoord(xEnd(vLevel)) - xCoord(xEnd(vLevel) - 1);
+        yCoord(yEnd(vLevel) + 1) = 2.0*yCoord(yEnd(vLevel)) - yCoord(yEnd(vLevel) - 1);
+        zCoord(zEnd(vLevel) + 1) = 2.0*zCoord(zEnd(vLevel)) - zCoord(zEnd(vLevel) - 1);
+
+        pressureData(vLevel) = 0.0;
+        residualData(vLevel) = 0.0;
+
+        // EXPECTED VALUES IN THE CORE AS WELL AS THE PAD REGIONS IF DATA TRANSFER HAPPENS WITH NO HITCH
+        for (int iX = -1; iX <= xEnd(vLevel) + 1; iX++) {
+            for (int iY = -1; iY <= yEnd(vLevel) + 1; iY++) {
+                for (int iZ = -1; iZ <= zEnd(vLevel) + 1; iZ++) {
+                    residualData(vLevel)(iX, iY, iZ) = sin(2.0*M_PI*xCoord(iX)/mesh.xLen)*
+                                                       cos(2.0*M_PI*yCoord(iY)/mesh.yLen)*
+                                                       cos(2.0*M_PI*zCoord(iZ)/mesh.zLen);
+                }
             }
         }
-    }
 
-    for (int iY = 0; iY <= inputParams.vcDepth; iY++) {
-        for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(iY)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(iY)) {
-                yCoord = mesh.yStaggr(stagCore.lbound(1)) - (mesh.yStaggr(stagCore.lbound(1) + strideValues(iY)) - mesh.yStaggr(stagCore.lbound(1)));
-                residualData(iX, stagCore.lbound(1) - strideValues(iY), iZ) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                                              cos(2.0*M_PI*yCoord/mesh.yLen)*
-                                                                              cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
+        pressureData(vLevel)(stagCore(vLevel)) = residualData(vLevel)(stagCore(vLevel));
 
-                yCoord = mesh.yStaggr(stagCore.ubound(1)) + (mesh.yStaggr(stagCore.ubound(1)) - mesh.yStaggr(stagCore.ubound(1) - strideValues(iY)));
-                residualData(iX, stagCore.ubound(1) + strideValues(iY), iZ) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                                              cos(2.0*M_PI*yCoord/mesh.yLen)*
-                                                                              cos(2.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
-            }
-        }
-    }
+        imposeBC(pressureData(vLevel), 2);
 
-    for (int iZ = 0; iZ <= inputParams.vcDepth; iZ++) {
-        for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(iZ)) {
-            for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(iZ)) {
-                zCoord = mesh.zStaggr(stagCore.lbound(2)) - (mesh.zStaggr(stagCore.lbound(2) + strideValues(iZ)) - mesh.zStaggr(stagCore.lbound(2)));
-                residualData(iX, iY, stagCore.lbound(2) - strideValues(iZ)) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                                              cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
-                                                                              cos(2.0*M_PI*zCoord/mesh.zLen);
+        pressureData(vLevel) -= residualData(vLevel);
 
-                zCoord = mesh.zStaggr(stagCore.ubound(2)) + (mesh.zStaggr(stagCore.ubound(2)) - mesh.zStaggr(stagCore.ubound(2) - strideValues(iZ)));
-                residualData(iX, iY, stagCore.ubound(2) + strideValues(iZ)) = sin(2.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                                              cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
-                                                                              cos(2.0*M_PI*zCoord/mesh.zLen);
-            }
-        }
+        maxVal = std::max(maxVal, real(blitz::max(fabs(pressureData(vLevel)))));
     }
 
-    for (int i=0; i<=inputParams.vcDepth; i++) {
-        imposeBC();
-        vLevel += 1;
-    }
-
-    pressureData -= residualData;
-
-    return blitz::max(fabs(pressureData));
+    return maxVal;
 }
 
-real multigrid_d3::testSolve() {
+template <typename mgReal>
+real multigrid_d3<mgReal>::testSolve() {
     vLevel = 0;
 
-    pressureData = 0.0;
-    residualData = 0.0;
-    smoothedPres = 0.0;
+    pressureData(vLevel) = 0.0;
+    residualData(vLevel) = 0.0;
+    smoothedPres(vLevel) = 0.0;
 
     // WARNING: THE EXACT SOLUTION USED HERE ASSUMES xLen = yLen = zLen = 1.0
-    for (int iX = stagCore.lbound(0); iX <= stagCore.ubound(0); iX += strideValues(vLevel)) {
-        for (int iY = stagCore.lbound(1); iY <= stagCore.ubound(1); iY += strideValues(vLevel)) {
-            for (int iZ = stagCore.lbound(2); iZ <= stagCore.ubound(2); iZ += strideValues(vLevel)) {
-                smoothedPres(iX, iY, iZ) = sin(1.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
+    for (int iX = xStr; iX <= xEnd(vLevel); iX++) {
+        for (int iY = yStr; iY <= yEnd(vLevel); iY++) {
+            for (int iZ = zStr; iZ <= zEnd(vLevel); iZ++) {
+                smoothedPres(vLevel)(iX, iY, iZ) = sin(1.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
                                            cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
                                            cos(4.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
 
-                residualData(iX, iY, iZ) = -21.0*M_PI*M_PI*sin(1.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
-                                                           cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
-                                                           cos(4.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
+                residualData(vLevel)(iX, iY, iZ) = -21.0*M_PI*M_PI*sin(1.0*M_PI*mesh.xStaggr(iX)/mesh.xLen)*
+                                                                   cos(2.0*M_PI*mesh.yStaggr(iY)/mesh.yLen)*
+                                                                   cos(4.0*M_PI*mesh.zStaggr(iZ)/mesh.zLen);
             }
         }
     }
 
     solve();
 
-    pressureData -= smoothedPres;
+    pressureData(vLevel) -= smoothedPres(vLevel);
+
+    return blitz::max(fabs(pressureData(vLevel)));
+}
+
+template <typename mgReal>
+multigrid_d3<mgReal>::~multigrid_d3() {
+    // THE PERSISTENT REQUESTS AND THE DATATYPES CREATED BY createMGSubArrays ARE RELEASED FOR EVERY LEVEL AND COLOUR
+    for(int i=0; i<=inputParams.vcDepth; i++) {
+        for (int c=0; c<2; c++) {
+            for (int f=0; f<4; f++) {
+                MPI_Request_free(&padSendRequest(i, c, f));
+                MPI_Request_free(&padRecvRequest(i, c, f));
+            }
+
+            MPI_Type_free(&xMGRBArray(i, c));           MPI_Type_free(&yMGRBArray(i, c));
+        }
+
+        MPI_Type_free(&xMGArray(i));                    MPI_Type_free(&yMGArray(i));
 
-    return blitz::max(fabs(pressureData));
+        if (haloLevel(i)) {
+            MPI_Type_free(&xMGHalo(i));                 MPI_Type_free(&yMGHalo(i));
+        }
+    }
 }
+
+template class multigrid_d3<float>;
+template class multigrid_d3<double>;
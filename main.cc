@@ -2,6 +2,8 @@
 
 #include "parser.h"
 #include "poisson.h"
+#include "krylov.h"
+#include "fftsolver.h"
 #include "parallel.h"
 
 /**
@@ -10,7 +12,16 @@
  *
  ********************************************************************************************************************************************
  */
-void initializeField(plainsf &uField, grid &mesh);
+void initializeField(plainsf<real> &uField, grid &mesh);
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Declaration of function to solve the Poisson equation with a given solver in the precision of its levels.
+ *
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void solvePoisson(poisson<mgReal> &mgSolver, grid &mesh, const parser &solParam, plainsf<real> &mgLHS, plainsf<real> &mgRHS);
 
 int main() {
     // INITIALIZE MPI
@@ -25,31 +36,44 @@ int main() {
     // INITIALIZE GRID DATA
     grid gridData(inputParams, mpi);
 
-    // POISSON SOLVER
-    poisson *mgSolver;
-
     // TEMPLATE SCALAR FIELD (sfield) FOR PRESCRIBING PLAIN SCALAR FIELD (plainsf)
-    sfield P(gridData, "P");
+    sfield<real> P(gridData, "P");
 
     // PLAIN SCALAR FIELDS THAT SERVE AS LHS AND RHS FOR THE POISSON SOLVER
-    plainsf mgLHS(gridData, P);
-    plainsf mgRHS(gridData, P);
+    plainsf<real> mgLHS(gridData, P);
+    plainsf<real> mgRHS(gridData, P);
 
     // INITIALIZE THE RHS WITH A SINUSOIDAL VARIATION
     initializeField(mgRHS, gridData);
 
-#ifdef PLANAR
-    mgSolver = new multigrid_d2(gridData, inputParams);
-#else
-    mgSolver = new multigrid_d3(gridData, inputParams);
-#endif
+    // THE TRANSFORM BASED SOLVER HANDLES BOTH 2D AND 3D GRIDS IN THE PRECISION OF THE FIELDS
+    // THE MULTI-GRID SOLVER IS INSTANTIATED WITH THE PRECISION OF ITS LEVELS AS SET IN THE YAML FILE
+    // AND WITH THE 2D OR 3D OPERATORS DEPENDING ON WHETHER THE GRID IS PLANAR
+    if (inputParams.solverType == 1) {
+        fftsolver tfSolver(gridData, inputParams);
+
+        solvePoisson(tfSolver, gridData, inputParams, mgLHS, mgRHS);
+    } else if (inputParams.mgPrecision == 1) {
+        if (inputParams.planar) {
+            multigrid_d2<float> mgSolver(gridData, inputParams);
 
-    if (mpi.rank == 0 ) std::cout << "Value of LHS at (5, 5, 5) before solving: " << mgLHS.F(5, 5, 5) << std::endl;
+            solvePoisson(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        } else {
+            multigrid_d3<float> mgSolver(gridData, inputParams);
 
-    // SOLVE THE POISSON EQUATION
-    mgSolver->mgSolve(mgLHS, mgRHS);
+            solvePoisson(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        }
+    } else {
+        if (inputParams.planar) {
+            multigrid_d2<double> mgSolver(gridData, inputParams);
+
+            solvePoisson(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        } else {
+            multigrid_d3<double> mgSolver(gridData, inputParams);
 
-    if (mpi.rank == 0 ) std::cout << "Value of LHS at (5, 5, 5) after solving: " << mgLHS.F(5, 5, 5) << std::endl;
+            solvePoisson(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        }
+    }
 
     // FINALIZE AND CLEAN-UP
     MPI_Finalize();
@@ -62,30 +86,64 @@ int main() {
  ********************************************************************************************************************************************
  * \brief   Definition of function to impose a sinusoidal variation for the input plain scalar field.
  *
- *          Depending on the preprocessor flag PLANAR, the function applies the sinusoidal variation
+ *          Depending on whether the grid is planar, the function applies the sinusoidal variation
  *          to set initial conditions in both 2D and 3D cases.
  *
  ********************************************************************************************************************************************
  */
-void initializeField(plainsf &uField, grid &mesh) {
+void initializeField(plainsf<real> &uField, grid &mesh) {
     if (mesh.rankData.rank == 0) std::cout << "Imposing sinusoidal initial condition" << std::endl << std::endl;
 
-#ifdef PLANAR
-    for (int i=uField.F.lbound(0); i <= uField.F.ubound(0); i++) {
-        for (int k=uField.F.lbound(2); k <= uField.F.ubound(2); k++) {
-            uField.F(i, 0, k) = sin(2.0*M_PI*mesh.xColloc(i)/mesh.xLen)*
-                                cos(2.0*M_PI*mesh.zStaggr(k)/mesh.zLen);
-        }
-    }
-#else
-    for (int i=uField.F.lbound(0); i <= uField.F.ubound(0); i++) {
-        for (int j=uField.F.lbound(1); j <= uField.F.ubound(1); j++) {
+    if (mesh.inputParams.planar) {
+        for (int i=uField.F.lbound(0); i <= uField.F.ubound(0); i++) {
             for (int k=uField.F.lbound(2); k <= uField.F.ubound(2); k++) {
-                uField.F(i, j, k) = sin(2.0*M_PI*mesh.xColloc(i)/mesh.xLen)*
-                                    cos(2.0*M_PI*mesh.yStaggr(j)/mesh.yLen)*
+                uField.F(i, 0, k) = sin(2.0*M_PI*mesh.xColloc(i)/mesh.xLen)*
                                     cos(2.0*M_PI*mesh.zStaggr(k)/mesh.zLen);
             }
         }
+    } else {
+        for (int i=uField.F.lbound(0); i <= uField.F.ubound(0); i++) {
+            for (int j=uField.F.lbound(1); j <= uField.F.ubound(1); j++) {
+                for (int k=uField.F.lbound(2); k <= uField.F.ubound(2); k++) {
+                    uField.F(i, j, k) = sin(2.0*M_PI*mesh.xColloc(i)/mesh.xLen)*
+                                        cos(2.0*M_PI*mesh.yStaggr(j)/mesh.yLen)*
+                                        cos(2.0*M_PI*mesh.zStaggr(k)/mesh.zLen);
+                }
+            }
+        }
     }
-#endif
+}
+
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Definition of function to solve the Poisson equation with a given solver in the precision of its levels.
+ *
+ *          The equation is solved either by the given solver alone, or by a Krylov solver which uses one cycle of the given
+ *          solver as its preconditioner.
+ *          The values of the LHS at a point before and after solving, along with the convergence history, are written to I/O.
+ *
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+void solvePoisson(poisson<mgReal> &mgSolver, grid &mesh, const parser &solParam, plainsf<real> &mgLHS, plainsf<real> &mgRHS) {
+    // THE PROBE POINT LIES ON THE ONLY Y-PLANE OF 2D GRIDS
+    int yProbe = solParam.planar? 0: 5;
+
+    if (mesh.rankData.rank == 0) std::cout << "Value of LHS at (5, " << yProbe << ", 5) before solving: " << mgLHS.F(5, yProbe, 5) << std::endl;
+
+    // SOLVE THE POISSON EQUATION, EITHER WITH STAND-ALONE MULTI-GRID OR WITH A KRYLOV SOLVER PRECONDITIONED BY MULTI-GRID
+    if (solParam.krylovType == 0) {
+        mgSolver.mgSolve(mgLHS, mgRHS);
+
+        if (mesh.rankData.rank == 0) std::cout << "Number of V-Cycles performed: " << mgSolver.cyclesUsed << ", with final residual norm: " << mgSolver.residualNorm << std::endl;
+    } else {
+        krylov<mgReal> kSolver(mesh, solParam, mgSolver);
+
+        kSolver.krylovSolve(mgLHS, mgRHS);
+
+        if (mesh.rankData.rank == 0) std::cout << "Number of preconditioning V-Cycles performed: " << kSolver.cyclesUsed << ", with final residual norm: " << kSolver.residualNorm << std::endl;
+    }
+
+    if (mesh.rankData.rank == 0) std::cout << "Value of LHS at (5, " << yProbe << ", 5) after solving: " << mgLHS.F(5, yProbe, 5) << std::endl;
 }
@@ -0,0 +1,334 @@
+#include <iostream>
+#include <string>
+
+#include "parser.h"
+#include "poisson.h"
+#include "krylov.h"
+#include "fftsolver.h"
+#include "parallel.h"
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Declaration of function to override the input parameters with the options of a regression case.
+ *
+ ********************************************************************************************************************************************
+ */
+bool setTestCase(parser &solParam, const std::string caseName);
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Declaration of function to set the number of sub-domains along X and Y from the number of processes.
+ *
+ ********************************************************************************************************************************************
+ */
+void setDomains(parser &solParam);
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Declaration of function to impose a sinusoidal variation for the input plain scalar field.
+ *
+ ********************************************************************************************************************************************
+ */
+void initializeField(plainsf<real> &uField, grid &mesh);
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Declaration of function to compute the norm of the input plain scalar field used by the solver.
+ *
+ ********************************************************************************************************************************************
+ */
+real computeNorm(plainsf<real> &uField, grid &mesh);
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Declaration of function to solve the Poisson equation with a given solver and return the final residual norm.
+ *
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+real solveCase(poisson<mgReal> &mgSolver, grid &mesh, const parser &solParam, plainsf<real> &mgLHS, plainsf<real> &mgRHS);
+
+int main(int argc, char *argv[]) {
+    // INITIALIZE MPI
+    MPI_Init(&argc, &argv);
+
+    // THE NAME OF THE REGRESSION CASE IS THE ONLY COMMAND LINE ARGUMENT
+    std::string caseName = (argc > 1)? argv[1]: "DEFAULT";
+
+    // ALL PROCESSES READ THE BASE PARAMETERS IN input/parameters.yaml FILE, WHICH ARE THEN OVERRIDDEN BY THE OPTIONS OF THE CASE
+    parser inputParams;
+
+    if (not setTestCase(inputParams, caseName)) {
+        std::cout << "ERROR: Unknown regression case " << caseName << ". Aborting" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    // THE SUB-DOMAINS ARE SET FROM THE NUMBER OF PROCESSES THE CASE IS RUN WITH, SO THAT THE CASES CAN BE RUN SERIALLY AS WELL
+    setDomains(inputParams);
+
+    // INITIALIZE PARALLELIZATION DATA
+    parallel mpi(inputParams);
+
+    // INITIALIZE GRID DATA
+    grid gridData(inputParams, mpi);
+
+    // TEMPLATE SCALAR FIELD (sfield) FOR PRESCRIBING PLAIN SCALAR FIELD (plainsf)
+    sfield<real> P(gridData, "P");
+
+    // PLAIN SCALAR FIELDS THAT SERVE AS LHS AND RHS FOR THE POISSON SOLVER
+    plainsf<real> mgLHS(gridData, P);
+    plainsf<real> mgRHS(gridData, P);
+
+    // INITIALIZE THE RHS WITH A SINUSOIDAL VARIATION
+    initializeField(mgRHS, gridData);
+
+    // THE RHS IS SHIFTED SO THAT IT IS NOT COMPATIBLE WITH THE SINGULAR PERIODIC OPERATOR UNTIL ITS MEAN IS REMOVED
+    if (caseName == "NULLSPACE") mgRHS.F += 1.0;
+
+    // WITH A ZERO INITIAL GUESS, THE INITIAL RESIDUAL IS THE RHS ITSELF
+    real initialNorm = computeNorm(mgRHS, gridData);
+    real finalNorm;
+
+    if (inputParams.solverType == 1) {
+        fftsolver tfSolver(gridData, inputParams);
+
+        finalNorm = solveCase(tfSolver, gridData, inputParams, mgLHS, mgRHS);
+    } else if (inputParams.mgPrecision == 1) {
+        if (inputParams.planar) {
+            multigrid_d2<float> mgSolver(gridData, inputParams);
+
+            finalNorm = solveCase(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        } else {
+            multigrid_d3<float> mgSolver(gridData, inputParams);
+
+            finalNorm = solveCase(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        }
+    } else {
+        if (inputParams.planar) {
+            multigrid_d2<double> mgSolver(gridData, inputParams);
+
+            finalNorm = solveCase(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        } else {
+            multigrid_d3<double> mgSolver(gridData, inputParams);
+
+            finalNorm = solveCase(mgSolver, gridData, inputParams, mgLHS, mgRHS);
+        }
+    }
+
+    // EVERY CASE MUST REDUCE THE RESIDUAL BY AT LEAST THREE ORDERS OF MAGNITUDE WITHIN THE ALLOWED NUMBER OF CYCLES
+    bool casePassed = (finalNorm < 1.0e-3*initialNorm);
+
+    if (gridData.rankData.rank == 0) {
+        std::cout << "Case " << caseName << ": residual norm reduced from " << initialNorm << " to " << finalNorm;
+        std::cout << (casePassed? " - PASSED": " - FAILED") << std::endl;
+    }
+
+    // FINALIZE AND CLEAN-UP
+    MPI_Finalize();
+
+    return casePassed? 0: 1;
+}
+
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Definition of function to override the input parameters with the options of a regression case.
+ *
+ *          Each case changes only the options it checks from the base parameters in input/parameters.yaml, which are
+ *          FW restriction, FULL coarsening with the RDISC operator, DIRECT coarsest level solver and POINT smoother on a 3D grid.
+ *          The overridden values are set as the parser would have set them, since the checks in the parser are not repeated.
+ *
+ * \param   solParam is a reference to the parser object whose parameters are overridden
+ * \param   caseName is the name of the regression case
+ *
+ * \return  The boolean value which is false if the case is not known
+ ********************************************************************************************************************************************
+ */
+bool setTestCase(parser &solParam, const std::string caseName) {
+    if (caseName == "DEFAULT") {
+        // THE BASE PARAMETERS ARE USED AS THEY ARE
+    } else if (caseName == "MAXNORM") {
+        solParam.normType = 1;
+    } else if (caseName == "WCYCLE") {
+        solParam.cycleType = 1;
+    } else if (caseName == "FCYCLE") {
+        solParam.cycleType = 2;
+    } else if (caseName == "FMG") {
+        solParam.initGuess = 1;
+    } else if (caseName == "INPUT") {
+        solParam.initGuess = 2;
+        solParam.vcCount = 1;
+    } else if (caseName == "ITERATIVE") {
+        solParam.coarseSolver = 0;
+    } else if (caseName == "FALLBACK") {
+        // THE COARSEST LEVEL OF A TWO-GRID CYCLE HAS TOO MANY POINTS FOR THE DIRECT SOLVER, WHICH FALLS BACK TO THE ITERATIVE ONE
+        solParam.vcDepth = 1;
+    } else if (caseName == "CG") {
+        solParam.krylovType = 1;
+    } else if (caseName == "BICGSTAB") {
+        solParam.krylovType = 2;
+    } else if (caseName == "ZLINE") {
+        solParam.smoothType = 1;
+    } else if (caseName == "SEMI") {
+        // THE GRID IS FINER ALONG Z, SO THAT ONLY Z IS COARSENED AT THE FIRST LEVELS
+        solParam.coarsenType = 1;
+        solParam.Lz = 0.25;
+        solParam.vcDepth = 4;
+    } else if (caseName == "GALERKIN") {
+        solParam.coarseOperator = 1;
+    } else if (caseName == "TRANSFORM") {
+        solParam.solverType = 1;
+    } else if (caseName == "HYBRID") {
+        // THE GRID IS STRETCHED ALONG THE NON-PERIODIC Z DIRECTION, SO THAT THE TRANSFORM IS DONE ONLY IN X AND Y
+        solParam.solverType = 1;
+        solParam.meshType = "UUD";
+        solParam.zGrid = 2;
+        solParam.zPer = false;
+        solParam.betaZ = 1.5;
+    } else if (caseName == "NULLSPACE") {
+        // THE MEAN OF THE RHS IS MADE NON-ZERO IN main, SO THAT IT HAS TO BE REMOVED FOR THE PERIODIC PROBLEM TO HAVE A SOLUTION
+    } else if (caseName == "SINGLE") {
+        // THE TOLERANCE OF THE COARSEST LEVEL SOLVE IS KEPT WITHIN THE REACH OF SINGLE PRECISION
+        solParam.mgPrecision = 1;
+        solParam.tolerance = std::max(solParam.tolerance, real(5.0e-6));
+    } else if (caseName == "PLANAR") {
+        // THE 2D GRID IS SOLVED BY THE PLANAR OPERATORS, WITH THE DOMAIN SPLIT ONLY ALONG X
+        solParam.yInd = 0;
+        solParam.planar = true;
+    } else if (caseName == "STRETCHED") {
+        // THE GRID IS STRETCHED ALONG THE NON-PERIODIC Z DIRECTION, SO THAT THE GENERAL KERNELS ARE USED INSTEAD OF THE UNIFORM ONES
+        solParam.meshType = "UUD";
+        solParam.zGrid = 2;
+        solParam.zPer = false;
+        solParam.betaZ = 1.5;
+    } else if (caseName == "FUSED") {
+        solParam.sweepBlock = 2;
+    } else if (caseName == "DEEP") {
+        // THE PADS ARE DEEP ENOUGH FOR THE FUSED SWEEPS OF A BLOCK TO BE PERFORMED WITHOUT ANY EXCHANGE IN BETWEEN
+        solParam.sweepBlock = 2;
+        solParam.haloDepth = 2*solParam.sweepBlock;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Definition of function to set the number of sub-domains along X and Y from the number of processes.
+ *
+ *          On 3D grids, the domain is split into 2 sub-domains along Y whenever the number of processes is even, and the rest
+ *          of the processes divide the domain along X.
+ *          On 2D grids, the domain is split only along X.
+ *
+ ********************************************************************************************************************************************
+ */
+void setDomains(parser &solParam) {
+    int nProc;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &nProc);
+
+    solParam.npY = (nProc % 2 == 0 and not solParam.planar)? 2: 1;
+    solParam.npX = nProc/solParam.npY;
+}
+
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Definition of function to impose a sinusoidal variation for the input plain scalar field.
+ *
+ *          The variation is the same as that imposed by the main solver for both 2D and 3D grids.
+ *
+ ********************************************************************************************************************************************
+ */
+void initializeField(plainsf<real> &uField, grid &mesh) {
+    if (mesh.inputParams.planar) {
+        for (int i=uField.F.lbound(0); i <= uField.F.ubound(0); i++) {
+            for (int k=uField.F.lbound(2); k <= uField.F.ubound(2); k++) {
+                uField.F(i, 0, k) = sin(2.0*M_PI*mesh.xColloc(i)/mesh.xLen)*
+                                    cos(2.0*M_PI*mesh.zStaggr(k)/mesh.zLen);
+            }
+        }
+    } else {
+        for (int i=uField.F.lbound(0); i <= uField.F.ubound(0); i++) {
+            for (int j=uField.F.lbound(1); j <= uField.F.ubound(1); j++) {
+                for (int k=uField.F.lbound(2); k <= uField.F.ubound(2); k++) {
+                    uField.F(i, j, k) = sin(2.0*M_PI*mesh.xColloc(i)/mesh.xLen)*
+                                        cos(2.0*M_PI*mesh.yStaggr(j)/mesh.yLen)*
+                                        cos(2.0*M_PI*mesh.zStaggr(k)/mesh.zLen);
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Definition of function to compute the norm of the input plain scalar field used by the solver.
+ *
+ *          The norm is either the root-mean-square value or the maximum absolute value, as specified by the normType parameter.
+ *          As in the norm computed by the solver, the last point of each sub-domain along a direction is left out unless it lies
+ *          on a non-periodic wall, since it is the same as the first point of the next sub-domain.
+ *
+ ********************************************************************************************************************************************
+ */
+real computeNorm(plainsf<real> &uField, grid &mesh) {
+    real localSums[2], globalSums[2];
+    blitz::TinyVector<int, 3> uniqEnd;
+
+    uniqEnd = mesh.staggrCoreDomain.ubound();
+    if (mesh.inputParams.xPer or mesh.rankData.xRank < mesh.rankData.npX - 1) uniqEnd(0) -= 1;
+    if (uniqEnd(1) > 0 and (mesh.inputParams.yPer or mesh.rankData.yRank < mesh.rankData.npY - 1)) uniqEnd(1) -= 1;
+    if (mesh.inputParams.zPer) uniqEnd(2) -= 1;
+
+    blitz::RectDomain<3> uniqCore(mesh.staggrCoreDomain.lbound(), uniqEnd);
+
+    if (mesh.inputParams.normType == 1) {
+        localSums[0] = blitz::max(fabs(uField.F(uniqCore)));
+
+        MPI_Allreduce(localSums, globalSums, 1, MPI_FP_REAL, MPI_MAX, MPI_COMM_WORLD);
+
+        return globalSums[0];
+    }
+
+    localSums[0] = blitz::sum(blitz::pow2(uField.F(uniqCore)));
+    localSums[1] = blitz::product(uniqEnd - uniqCore.lbound() + 1);
+
+    MPI_Allreduce(localSums, globalSums, 2, MPI_FP_REAL, MPI_SUM, MPI_COMM_WORLD);
+
+    return sqrt(globalSums[0]/globalSums[1]);
+}
+
+
+/**
+ ********************************************************************************************************************************************
+ * \brief   Definition of function to solve the Poisson equation with a given solver and return the final residual norm.
+ *
+ *          As in the main solver, the equation is solved either by the given solver alone, or by a Krylov solver which uses one
+ *          cycle of the given solver as its preconditioner.
+ *          When the input field is used as the initial guess, the given solver is called repeatedly on the same field.
+ *
+ ********************************************************************************************************************************************
+ */
+template <typename mgReal>
+real solveCase(poisson<mgReal> &mgSolver, grid &mesh, const parser &solParam, plainsf<real> &mgLHS, plainsf<real> &mgRHS) {
+    if (solParam.krylovType == 0) {
+        // WITH A WARM START, EACH SOLVE STARTS FROM THE SOLUTION OF THE PREVIOUS ONE, AS IT WOULD FROM THE PREVIOUS TIME-STEP
+        // THE CASE PERFORMS ONLY ONE CYCLE PER SOLVE, SO THAT THE RESIDUAL IS REDUCED ENOUGH ONLY IF THE SOLVES CONTINUE FROM ONE ANOTHER
+        int solveCount = (solParam.initGuess == 2)? 5: 1;
+
+        for (int i=0; i<solveCount; i++) mgSolver.mgSolve(mgLHS, mgRHS);
+
+        return mgSolver.residualNorm;
+    }
+
+    krylov<mgReal> kSolver(mesh, solParam, mgSolver);
+
+    kSolver.krylovSolve(mgLHS, mgRHS);
+
+    return kSolver.residualNorm;
+}